@@ -4,6 +4,7 @@
 #include "Tensor.h"
 #include "Tensor_operator.h"
 #include "Tensor_factory.h"
+#include "Profiler.h"
 #include <cmath>
 
 /*
@@ -47,8 +48,11 @@ public:
     
     void update(Tensor& bobot, Tensor& grad_bobot,
                 Tensor& bias, Tensor& grad_bias) {
+        DL_PROFILE("adam::update", bobot.numel() + bias.numel());
         // Initialize M dan V jika belum //
+        DL_MEMORY_TAG("adam::update");
         if (!inisialisasi) {
+            DL_MEMORY_TAG("adam::state");
             m_bobot = dl::zeros(bobot.get_shape());
             v_bobot = dl::zeros(bobot.get_shape());
             m_bias = dl::zeros(bias.get_shape());
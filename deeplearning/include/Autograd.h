@@ -0,0 +1,484 @@
+#ifndef AUTOGRAD_H
+#define AUTOGRAD_H
+
+#include "Tensor.h"
+#include "Tensor_operator.h"
+#include "Tensor_factory.h"
+#include "ReLu.h"
+#include "Sigmoid.h"
+#include "Loss.h"
+#include "Dropout.h"
+#include "Memory.h"
+#include "Autotune.h"
+#include "Matmul.h"
+#include "Reduction.h"
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/*
+Autograd (reverse-mode automatic differentiation) berbasis tape.
+Selama ini backward kita tulis manual di NeuralNetwork::backward pakai switch.
+Dengan autograd, setiap operasi pada Tensor yang requires_grad akan di rekam
+sebagai node di tape. Pas backward() di panggil, tape di jalan kan dari belakang
+(urutan rekaman = urutan topologis, jadi kebalikan nya pasti valid).
+
+Kenapa pakai tape?
+1. Gak perlu nulis backward manual per layer lagi di NeuralNetwork.
+2. Tensor yang di simpan buat backward (saved tensor) bisa di lepas
+   begitu konsumen terakhir nya sudah jalan. Jadi pas backward berjalan,
+   aktivasi yang sudah gak di pakai langsung di bebaskan,
+   beda sama NeuralNetwork::activations yang nyimpen semua sampai forward berikut nya.
+
+Saved tensor di simpan sebagai shared_ptr di dalam closure node.
+Kalau nilai yang sama di simpan beberapa node (misal output sigmoid yang jadi input Dense),
+mereka share satu salinan lewat weak_ptr di slot. Begitu semua node nya selesai backward,
+salinan nya otomatis hilang. Parameter (leaf) gak di salin sama sekali.
+
+Catatan: yang di rekam cuma operasi di namespace dl::autograd,
+operator biasa (+, -, *, dst) tetap operasi Tensor biasa tanpa rekaman.
+*/
+
+namespace dl {
+namespace autograd {
+
+// Fungsi backward node: terima grad output, return grad untuk setiap input //
+// Grad kosong (numel 0) artinya input itu gak butuh gradient //
+using FungsiBackward = std::function<std::vector<Tensor>(const Tensor& grad_output)>;
+
+// Slot = satu nilai di tape (hasil operasi atau leaf) //
+struct Slot {
+    std::weak_ptr<const Tensor> tersimpan;  // Salinan yang di simpan buat backward (kalau ada) //
+    Tensor grad;
+    bool ada_grad = false;
+    bool leaf = false;
+};
+
+// Node = satu operasi yang di rekam //
+struct Node {
+    std::vector<int> input;   // Slot input (-1 kalau input gak butuh gradient) //
+    int output;
+    FungsiBackward fungsi;
+};
+
+class Tape {
+private:
+    std::vector<Slot> slot;
+    std::vector<Node> node;
+    std::unordered_map<const Tensor*, int> slot_leaf;
+    unsigned generasi = 1;
+    bool merekam = true;
+
+public:
+    // Hapus semua rekaman, Tensor lama otomatis gak valid lagi karna generasi nya beda //
+    void reset() {
+        slot.clear();
+        node.clear();
+        slot_leaf.clear();
+        ++generasi;
+    }
+
+    unsigned dapatkan_generasi() const { return generasi; }
+    bool sedang_merekam() const { return merekam; }
+    void atur_merekam(bool nilai) { merekam = nilai; }
+    size_t jumlah_node() const { return node.size(); }
+
+    // Cari slot dari Tensor, return -1 kalau Tensor ini gak butuh gradient //
+    int slot_dari(const Tensor& t) {
+        if (!merekam) {
+            return -1;
+        }
+        if (t.get_tape_slot() >= 0 && t.get_tape_generasi() == generasi) {
+            return t.get_tape_slot();
+        }
+        if (!t.get_requires_grad()) {
+            return -1;
+        }
+        // Leaf (parameter), di kenali dari alamat nya //
+        auto it = slot_leaf.find(&t);
+        if (it != slot_leaf.end()) {
+            return it->second;
+        }
+        int s = static_cast<int>(slot.size());
+        slot.emplace_back();
+        slot.back().leaf = true;
+        slot_leaf[&t] = s;
+        return s;
+    }
+
+    // Simpan Tensor buat backward //
+    // Leaf gak di salin, hasil operasi di salin sekali dan di share antar node //
+    std::shared_ptr<const Tensor> simpan(const Tensor& t, int s) {
+        if (s >= 0 && slot[s].leaf) {
+            return std::shared_ptr<const Tensor>(std::shared_ptr<const Tensor>(), &t);
+        }
+        if (s >= 0) {
+            if (auto ada = slot[s].tersimpan.lock()) {
+                return ada;
+            }
+        }
+        DL_MEMORY_TAG("autograd::saved");
+        auto salinan = std::make_shared<const Tensor>(t);
+        if (s >= 0) {
+            slot[s].tersimpan = salinan;
+        }
+        return salinan;
+    }
+
+    // Buat slot baru buat output operasi dan tandai Tensor nya //
+    int tandai_output(Tensor& output) {
+        int s = static_cast<int>(slot.size());
+        slot.emplace_back();
+        output.set_requires_grad(true);
+        output.set_tape_slot(s, generasi);
+        return s;
+    }
+
+    // Tambah node ke tape //
+    void tambah_node(std::vector<int> input, int output, FungsiBackward fungsi) {
+        Node n;
+        n.input = std::move(input);
+        n.output = output;
+        n.fungsi = std::move(fungsi);
+        node.push_back(std::move(n));
+    }
+
+    // Rekam node baru, output di tandai dengan slot nya //
+    void rekam(Tensor& output, std::vector<int> input, FungsiBackward fungsi) {
+        int s = tandai_output(output);
+        tambah_node(std::move(input), s, std::move(fungsi));
+    }
+
+    // Jalan kan backward dari Tensor akar (biasanya loss) //
+    // Gradient awal nya 1 untuk setiap elemen, jadi sama dengan backward dari sum(akar) //
+    void backward(const Tensor& akar) {
+        int s_akar = slot_dari(akar);
+        if (s_akar < 0) return;
+
+        DL_MEMORY_TAG("autograd::grad");
+        slot[s_akar].grad = dl::ones_like(akar);
+        slot[s_akar].ada_grad = true;
+
+        for (int n = static_cast<int>(node.size()) - 1; n >= 0; --n) {
+            Node& nd = node[n];
+            Slot& out = slot[nd.output];
+
+            if (out.ada_grad && nd.fungsi) {
+                std::vector<Tensor> grads = nd.fungsi(out.grad);
+                for (size_t i = 0; i < nd.input.size(); ++i) {
+                    int s = nd.input[i];
+                    if (s < 0 || grads[i].numel() == 0) continue;
+                    if (slot[s].ada_grad) {
+                        slot[s].grad += grads[i];
+                    } else {
+                        slot[s].grad = std::move(grads[i]);
+                        slot[s].ada_grad = true;
+                    }
+                }
+            }
+
+            // Node ini sudah selesai, lepas saved tensor dan grad output nya //
+            nd.fungsi = nullptr;
+            if (!out.leaf) {
+                out.grad = Tensor();
+                out.ada_grad = false;
+            }
+        }
+    }
+
+    // Ambil gradient leaf setelah backward //
+    const Tensor* grad_leaf(const Tensor& t) const {
+        auto it = slot_leaf.find(&t);
+        if (it == slot_leaf.end() || !slot[it->second].ada_grad) {
+            return nullptr;
+        }
+        return &slot[it->second].grad;
+    }
+};
+
+// Tape global per thread //
+inline Tape& tape() {
+    thread_local Tape t;
+    return t;
+}
+
+// Guard buat mematikan rekaman sementara (misal pas prediksi) //
+class TanpaGrad {
+private:
+    bool sebelumnya;
+
+public:
+    TanpaGrad() : sebelumnya(tape().sedang_merekam()) {
+        tape().atur_merekam(false);
+    }
+    ~TanpaGrad() { tape().atur_merekam(sebelumnya); }
+
+    TanpaGrad(const TanpaGrad&) = delete;
+    TanpaGrad& operator=(const TanpaGrad&) = delete;
+};
+
+// Jalan kan backward dari loss //
+inline void backward(const Tensor& loss) {
+    tape().backward(loss);
+}
+
+// Gradient leaf, kalau gak ada gradient nya return zeros //
+inline Tensor grad(const Tensor& leaf) {
+    const Tensor* g = tape().grad_leaf(leaf);
+    return g ? *g : dl::zeros_like(leaf);
+}
+
+// OPERASI YANG DI REKAM //
+
+// Cek apakah salah satu input butuh gradient //
+inline bool perlu_rekam(const std::vector<int>& slots) {
+    if (!tape().sedang_merekam()) return false;
+    for (int s : slots) {
+        if (s >= 0) return true;
+    }
+    return false;
+}
+
+/*
+Linear: y = x @ W^T + b
+x = [batch, in], W = [out, in], b = [out] (boleh kosong kalau tanpa bias)
+Backward nya:
+dx = dy @ W
+dW = dy^T @ x
+db = sum_batch(dy)
+*/
+inline Tensor linear(const Tensor& x, const Tensor& W, const Tensor& b) {
+    const dl::index_t batch = x.get_shape()[0];
+    const dl::index_t in = W.get_shape()[1];
+    const dl::index_t out = W.get_shape()[0];
+    const bool ada_bias = b.numel() > 0;
+
+    // Kernel nya sama dengan Dense::forward (hasil nya sama persis), di pilih autotuner per shape //
+    Tensor y({batch, out});
+    dl::tuning::linear(x.data_ptr(), W.data_ptr(), ada_bias ? b.data_ptr() : nullptr, y.data_ptr(), batch, in, out);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(x), tp.slot_dari(W), ada_bias ? tp.slot_dari(b) : -1};
+    if (!perlu_rekam(input)) return y;
+
+    auto sx = tp.simpan(x, input[0]);
+    auto sW = tp.simpan(W, input[1]);
+    bool butuh_dx = input[0] >= 0;
+
+    tp.rekam(y, input, [sx, sW, batch, in, out, ada_bias, butuh_dx](const Tensor& dy) {
+        const Tensor& xs = *sx;
+        const Tensor& Ws = *sW;
+        std::vector<Tensor> grads(3);
+
+        if (butuh_dx) {
+            Tensor dx = dl::zeros({batch, in});
+            for (dl::index_t i = 0; i < batch; ++i) {
+                for (dl::index_t o = 0; o < out; ++o) {
+                    double g = dy[i * out + o];
+                    for (dl::index_t k = 0; k < in; ++k) {
+                        dx[i * in + k] += g * Ws[o * in + k];
+                    }
+                }
+            }
+            grads[0] = std::move(dx);
+        }
+
+        Tensor dW = dl::zeros({out, in});
+        Tensor db = ada_bias ? dl::zeros({out}) : Tensor();
+        for (dl::index_t i = 0; i < batch; ++i) {
+            for (dl::index_t o = 0; o < out; ++o) {
+                double g = dy[i * out + o];
+                if (ada_bias) db[o] += g;
+                for (dl::index_t k = 0; k < in; ++k) {
+                    dW[o * in + k] += g * xs[i * in + k];
+                }
+            }
+        }
+        grads[1] = std::move(dW);
+        grads[2] = std::move(db);
+        return grads;
+    });
+    return y;
+}
+
+// ReLU: simpan output nya, karna relu'(x) = 1 jika y > 0 //
+inline Tensor relu(const Tensor& x) {
+    Tensor y = ReLu::forward(x);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(x)};
+    if (!perlu_rekam(input)) return y;
+
+    // Output di simpan lewat slot nya, jadi kalau layer berikut nya juga nyimpen //
+    // output ini sebagai input, salinan nya cuma satu //
+    int s = tp.tandai_output(y);
+    auto sy = tp.simpan(y, s);
+    tp.tambah_node(input, s, [sy](const Tensor& dy) {
+        std::vector<Tensor> grads(1);
+        grads[0] = dy * ReLu::backward(*sy);
+        return grads;
+    });
+    return y;
+}
+
+// Sigmoid: simpan output nya, karna sigmoid'(x) = y * (1 - y) //
+inline Tensor sigmoid(const Tensor& x) {
+    Tensor y = Sigmoid::forward(x);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(x)};
+    if (!perlu_rekam(input)) return y;
+
+    int s = tp.tandai_output(y);
+    auto sy = tp.simpan(y, s);
+    tp.tambah_node(input, s, [sy](const Tensor& dy) {
+        std::vector<Tensor> grads(1);
+        grads[0] = dy * Sigmoid::backward(*sy);
+        return grads;
+    });
+    return y;
+}
+
+// Dropout: mask nya sudah di simpan di layer (1 bit per elemen), jadi gak ada Tensor yang di simpan di tape //
+// Layer nya harus tetap hidup sampai backward selesai //
+inline Tensor dropout(const Tensor& x, Dropout& layer) {
+    Tensor y = layer.forward(x);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(x)};
+    if (!perlu_rekam(input)) return y;
+
+    const Dropout* pl = &layer;
+    tp.rekam(y, input, [pl](const Tensor& dy) {
+        std::vector<Tensor> grads(1);
+        grads[0] = pl->backward(dy);
+        return grads;
+    });
+    return y;
+}
+
+// Perkalian element-wise //
+inline Tensor mul(const Tensor& a, const Tensor& b) {
+    Tensor y = a * b;
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(a), tp.slot_dari(b)};
+    if (!perlu_rekam(input)) return y;
+
+    auto sa = tp.simpan(a, input[0]);
+    auto sb = tp.simpan(b, input[1]);
+    tp.rekam(y, input, [sa, sb](const Tensor& dy) {
+        std::vector<Tensor> grads(2);
+        grads[0] = dy * (*sb);
+        grads[1] = dy * (*sa);
+        return grads;
+    });
+    return y;
+}
+
+// Penjumlahan element-wise //
+inline Tensor add(const Tensor& a, const Tensor& b) {
+    Tensor y = a + b;
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(a), tp.slot_dari(b)};
+    if (!perlu_rekam(input)) return y;
+
+    tp.rekam(y, input, [](const Tensor& dy) {
+        return std::vector<Tensor>{dy, dy};
+    });
+    return y;
+}
+
+/*
+Matmul: y = op(a) @ op(b), op = transpos kalau flag nya true (lihat Matmul.h)
+Backward nya (transpos lewat stride, gak ada copy):
+da = dy @ op(b)^T      (kalau a di transpos: op(b) @ dy^T)
+db = op(a)^T @ dy      (kalau b di transpos: dy^T @ op(a))
+Operand yang di broadcast di batch, gradient nya di jumlah di sumbu batch.
+*/
+inline Tensor matmul(const Tensor& a, const Tensor& b, bool transpos_a = false, bool transpos_b = false) {
+    Tensor y = dl::matmul(OperandMatmul(a, transpos_a), OperandMatmul(b, transpos_b));
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(a), tp.slot_dari(b)};
+    if (!perlu_rekam(input)) return y;
+
+    // a cuma di pakai buat grad b, dan sebalik nya //
+    auto sa = input[1] >= 0 ? tp.simpan(a, input[0]) : nullptr;
+    auto sb = input[0] >= 0 ? tp.simpan(b, input[1]) : nullptr;
+    const Shape bentuk_a = a.get_shape();
+    const Shape bentuk_b = b.get_shape();
+
+    tp.rekam(y, input, [sa, sb, bentuk_a, bentuk_b, transpos_a, transpos_b](const Tensor& dy) {
+        // Gradient operand yang di broadcast: jumlah di sumbu batch //
+        auto sesuaikan = [](Tensor g, const Shape& bentuk) {
+            const Shape& bg = g.get_shape();
+            if (bg.size() == bentuk.size() && (bentuk.size() == 2 || bg[0] == bentuk[0])) return g;
+            return dl::sum(g, std::vector<int>{0}, bentuk.size() == 3);
+        };
+        std::vector<Tensor> grads(2);
+        if (sb) {
+            Tensor da = transpos_a ? dl::matmul(OperandMatmul(*sb, transpos_b), dl::transpos(dy))
+                                   : dl::matmul(dy, OperandMatmul(*sb, !transpos_b));
+            grads[0] = sesuaikan(std::move(da), bentuk_a);
+        }
+        if (sa) {
+            Tensor db = transpos_b ? dl::matmul(dl::transpos(dy), OperandMatmul(*sa, transpos_a))
+                                   : dl::matmul(OperandMatmul(*sa, !transpos_a), dy);
+            grads[1] = sesuaikan(std::move(db), bentuk_b);
+        }
+        return grads;
+    });
+    return y;
+}
+
+// Binary cross entropy per elemen (target gak butuh gradient) //
+inline Tensor binary_cross_entropy(const Tensor& y_pred, const Tensor& y_true) {
+    Tensor loss = BinaryCrossEnrtopy::forward(y_pred, y_true);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(y_pred)};
+    if (!perlu_rekam(input)) return loss;
+
+    auto sp = tp.simpan(y_pred, input[0]);
+    auto st = tp.simpan(y_true, -1);
+    tp.rekam(loss, input, [sp, st](const Tensor& dy) {
+        std::vector<Tensor> grads(1);
+        grads[0] = dy * BinaryCrossEnrtopy::backward(*sp, *st);
+        return grads;
+    });
+    return loss;
+}
+
+// Softmax + cross entropy fused, loss per sampel [batch], gradient ke logits softmax - onehot //
+inline Tensor softmax_cross_entropy(const Tensor& logits, const Tensor& label) {
+    Tensor loss = SoftmaxCrossEntropy::forward(logits, label);
+
+    Tape& tp = tape();
+    std::vector<int> input = {tp.slot_dari(logits)};
+    if (!perlu_rekam(input)) return loss;
+
+    auto sz = tp.simpan(logits, input[0]);
+    auto sl = tp.simpan(label, -1);
+    tp.rekam(loss, input, [sz, sl](const Tensor& dy) {
+        std::vector<Tensor> grads(1);
+        grads[0] = SoftmaxCrossEntropy::backward(*sz, *sl);
+        // Gradient per baris di skala dy[b] //
+        const dl::index_t kelas = grads[0].get_shape()[1];
+        for (dl::index_t b = 0; b < dy.numel(); ++b) {
+            double* g = grads[0].row_ptr(b);
+            for (dl::index_t j = 0; j < kelas; ++j) {
+                g[j] *= dy[b];
+            }
+        }
+        return grads;
+    });
+    return loss;
+}
+
+} // namespace autograd //
+} // namespace dl //
+
+#endif
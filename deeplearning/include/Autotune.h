@@ -0,0 +1,523 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "Tensor.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/*
+Autotuner kernel linear (y = x @ W^T + b) per shape.
+
+Shape yang beda mau kernel yang beda: Dense 2 -> 4 gak butuh apa-apa,
+Dense 1024 -> 1024 dengan batch besar untung banyak dari register blocking dan thread.
+Jadi setiap shape (batch, in_features, out_features) yang baru pertama kali di pakai
+di benchmark dulu pakai semua kandidat konfigurasi, lalu yang paling cepat di pakai terus.
+Batch nya di kelompokkan per pangkat 2 (bucket_batch), jadi ukuran batch yang beda-beda tipis
+gak di benchmark ulang. Shape yang sudah di tuning di cari di cache per thread, tanpa lock.
+
+Kandidat nya:
+    blok RB x RO : RB baris batch x RO output sekaligus, RB * RO akumulator di register.
+                   Satu load x[k] di pakai RO kali, satu load W[o, k] di pakai RB kali.
+    paralel      : serial, di bagi per baris batch, atau di bagi per output (buat batch kecil).
+
+Semua kandidat ngejumlahin setiap output dengan urutan k yang sama (0, 1, 2, ...),
+jadi hasil nya sama persis bit per bit, yang beda cuma kecepatan nya.
+Autotune gak pernah ngubah hasil training.
+
+Pilihan nya bisa di simpan ke file cache (satu baris per shape), dengan kunci model CPU
+dan jumlah thread, jadi run berikut nya di mesin yang sama langsung pakai hasil tuning.
+Baris dari CPU lain di biarkan di file, cuma gak di pakai.
+
+File cache nya opt-in: env DL_TUNING_CACHE atau autotuner().atur_file_cache(path).
+Tanpa itu hasil tuning cuma di memori, gak ada file yang di tulis.
+File nya selalu di tulis ulang utuh (file sementara lalu rename), bukan di append.
+DL_AUTOTUNE=0 matikan autotune (selalu pakai kernel bawaan 1 x 1 serial).
+*/
+
+namespace dl {
+namespace tuning {
+
+enum class Paralel {
+    SERIAL = 0,
+    BATCH,     // parallel_for di atas baris batch //
+    OUTPUT     // parallel_for di atas output, buat batch kecil dengan out_features besar //
+};
+
+inline const char* nama_paralel(Paralel p) {
+    switch (p) {
+        case Paralel::SERIAL: return "serial";
+        case Paralel::BATCH: return "batch";
+        case Paralel::OUTPUT: return "output";
+    }
+    return "?";
+}
+
+// Ukuran blok register yang di dukung //
+struct Blok {
+    int rb;
+    int ro;
+};
+
+inline const std::vector<Blok>& daftar_blok() {
+    static const std::vector<Blok> daftar = {{1, 1}, {1, 4}, {2, 4}, {4, 4}};
+    return daftar;
+}
+
+struct KonfigurasiLinear {
+    int blok = 0;                       // Index ke daftar_blok() //
+    Paralel paralel = Paralel::SERIAL;
+    double waktu_us = 0.0;              // Waktu konfigurasi ini pas di tuning //
+    double waktu_bawaan_us = 0.0;       // Waktu kernel bawaan (1 x 1 serial) pas di tuning //
+};
+
+namespace detail {
+
+/*
+acc + x * w. Kalau target nya punya FMA, fma nya di tulis eksplisit:
+kalau di serahkan ke compiler, kernel yang di vectorize dan yang enggak bisa beda
+(satu jadi fma, satu mul + add), dan hasil antar kandidat jadi gak sama persis lagi.
+*/
+inline double madd(double x, double w, double acc) {
+#ifdef __FMA__
+    return std::fma(x, w, acc);
+#else
+    return acc + x * w;
+#endif
+}
+
+// Satu output: dot baris x dan baris W, urutan k nya berurutan //
+inline double titik(const double* x, const double* w, dl::index_t in) {
+    double sum = 0.0;
+    for (dl::index_t k = 0; k < in; ++k) {
+        sum = madd(x[k], w[k], sum);
+    }
+    return sum;
+}
+
+/*
+Hitung y[b, o] untuk b di [b0, b1) dan o di [o0, o1) pakai blok RB x RO.
+Sisa baris / output yang gak muat satu blok di hitung satu-satu.
+*/
+template <int RB, int RO>
+inline void linear_blok(const double* x, const double* w, const double* bias, double* y,
+                        dl::index_t in, dl::index_t out,
+                        dl::index_t b0, dl::index_t b1, dl::index_t o0, dl::index_t o1) {
+    dl::index_t b = b0;
+    for (; b + RB <= b1; b += RB) {
+        const double* xr[RB];
+        for (int r = 0; r < RB; ++r) xr[r] = x + (b + r) * in;
+
+        dl::index_t o = o0;
+        for (; o + RO <= o1; o += RO) {
+            const double* wr[RO];
+            for (int c = 0; c < RO; ++c) wr[c] = w + (o + c) * in;
+
+            double acc[RB][RO] = {};
+            for (dl::index_t k = 0; k < in; ++k) {
+                for (int r = 0; r < RB; ++r) {
+                    const double xv = xr[r][k];
+                    for (int c = 0; c < RO; ++c) {
+                        acc[r][c] = madd(xv, wr[c][k], acc[r][c]);
+                    }
+                }
+            }
+            for (int r = 0; r < RB; ++r) {
+                double* yr = y + (b + r) * out;
+                for (int c = 0; c < RO; ++c) {
+                    yr[o + c] = bias ? acc[r][c] + bias[o + c] : acc[r][c];
+                }
+            }
+        }
+        for (; o < o1; ++o) {
+            const double* wo = w + o * in;
+            for (int r = 0; r < RB; ++r) {
+                const double s = titik(xr[r], wo, in);
+                y[(b + r) * out + o] = bias ? s + bias[o] : s;
+            }
+        }
+    }
+    for (; b < b1; ++b) {
+        const double* xb = x + b * in;
+        for (dl::index_t o = o0; o < o1; ++o) {
+            const double s = titik(xb, w + o * in, in);
+            y[b * out + o] = bias ? s + bias[o] : s;
+        }
+    }
+}
+
+inline void linear_range(int blok, const double* x, const double* w, const double* bias, double* y,
+                         dl::index_t in, dl::index_t out,
+                         dl::index_t b0, dl::index_t b1, dl::index_t o0, dl::index_t o1) {
+    switch (blok) {
+        case 1: linear_blok<1, 4>(x, w, bias, y, in, out, b0, b1, o0, o1); return;
+        case 2: linear_blok<2, 4>(x, w, bias, y, in, out, b0, b1, o0, o1); return;
+        case 3: linear_blok<4, 4>(x, w, bias, y, in, out, b0, b1, o0, o1); return;
+        default: linear_blok<1, 1>(x, w, bias, y, in, out, b0, b1, o0, o1); return;
+    }
+}
+
+// Grain kelipatan ukuran blok, kira-kira 4 chunk per thread //
+inline dl::index_t grain_blok(dl::index_t n, int kelipatan) {
+    const dl::index_t target = std::max<dl::index_t>(1, n / (4 * dl::jumlah_thread()));
+    return std::max<dl::index_t>(kelipatan, (target + kelipatan - 1) / kelipatan * kelipatan);
+}
+
+} // namespace detail //
+
+// Jalankan kernel linear dengan konfigurasi tertentu, bias boleh nullptr //
+inline void linear_dengan(const KonfigurasiLinear& k, const double* x, const double* w, const double* bias,
+                          double* y, dl::index_t batch, dl::index_t in, dl::index_t out) {
+    const Blok bl = daftar_blok()[k.blok];
+    switch (k.paralel) {
+        case Paralel::SERIAL:
+            detail::linear_range(k.blok, x, w, bias, y, in, out, 0, batch, 0, out);
+            break;
+        case Paralel::BATCH:
+            dl::parallel_for(0, batch, detail::grain_blok(batch, bl.rb), [&](dl::index_t b0, dl::index_t b1) {
+                detail::linear_range(k.blok, x, w, bias, y, in, out, b0, b1, 0, out);
+            });
+            break;
+        case Paralel::OUTPUT:
+            dl::parallel_for(0, out, detail::grain_blok(out, bl.ro), [&](dl::index_t o0, dl::index_t o1) {
+                detail::linear_range(k.blok, x, w, bias, y, in, out, 0, batch, o0, o1);
+            });
+            break;
+    }
+}
+
+// Model CPU dari /proc/cpuinfo, jadi kunci file cache //
+inline std::string model_cpu() {
+    std::ifstream f("/proc/cpuinfo");
+    std::string baris;
+    while (std::getline(f, baris)) {
+        if (baris.compare(0, 10, "model name") == 0) {
+            const size_t p = baris.find(':');
+            if (p != std::string::npos) {
+                size_t a = baris.find_first_not_of(" \t", p + 1);
+                return a == std::string::npos ? "cpu-unknown" : baris.substr(a);
+            }
+        }
+    }
+    return "cpu-unknown";
+}
+
+/*
+Batch di kelompokkan per pangkat 2 (1, 2, 4, ..., 128, 256, ...), jadi micro-batch, batch terakhir
+yang gak penuh, predict batch 1, atau streaming online gak bikin tuning baru untuk setiap ukuran batch.
+Kernel terbaik buat batch 100 dan 128 hampir selalu sama.
+*/
+inline dl::index_t bucket_batch(dl::index_t batch) {
+    dl::index_t b = 1;
+    while (b < batch) b <<= 1;
+    return b;
+}
+
+class Autotuner {
+private:
+    using Kunci = std::tuple<dl::index_t, dl::index_t, dl::index_t, int>;   // bucket batch, in, out, thread //
+    using Tabel = std::map<Kunci, KonfigurasiLinear>;
+
+    std::mutex mtx;
+    Tabel tabel;
+    std::vector<Kunci> sedang_dituning;     // Shape yang lagi di benchmark thread lain //
+    std::string cpu;
+    std::string path;
+    std::atomic<bool> aktif{true};
+    bool dimuat = false;
+
+    // Naik setiap tabel nya di kosongkan, cache per thread yang generasi nya lama di buang //
+    std::atomic<uint64_t> generasi{0};
+
+    /*
+    Cache per thread, jalur panas nya (shape yang sudah pernah di tuning) cuma baca map lokal
+    tanpa lock. Isi nya cuma hasil yang sudah final, jadi gak pernah basi kecuali tabel nya di reset.
+    */
+    struct CacheLokal {
+        const Autotuner* pemilik = nullptr;
+        uint64_t generasi = 0;
+        Tabel tabel;
+    };
+
+    static CacheLokal& cache_lokal() {
+        thread_local CacheLokal c;
+        return c;
+    }
+
+    // Persistensi nya opt-in: tanpa DL_TUNING_CACHE (atau atur_file_cache) hasil tuning cuma di memori //
+    static std::string path_bawaan() {
+        if (const char* env = std::getenv("DL_TUNING_CACHE")) {
+            return env;
+        }
+        return "";
+    }
+
+    /*
+    Format baris: <model cpu> TAB linear <bucket batch> <in> <out> <thread> <blok> <paralel> <us> <us bawaan>
+    Return false kalau baris nya rusak atau bukan format ini.
+    */
+    static bool parse_baris(const std::string& baris, std::string& model, Kunci& kunci, KonfigurasiLinear& k) {
+        const size_t tab = baris.find('\t');
+        if (tab == std::string::npos) return false;
+        model = baris.substr(0, tab);
+        std::istringstream is(baris.substr(tab + 1));
+        std::string jenis;
+        dl::index_t b, in, out;
+        int t, blok, par;
+        if (!(is >> jenis >> b >> in >> out >> t >> blok >> par >> k.waktu_us >> k.waktu_bawaan_us)) return false;
+        // Batch yang bukan bucket itu baris format lama (per batch persis), di lewati //
+        if (b != bucket_batch(b)) return false;
+        if (jenis != "linear" || blok < 0 || blok >= static_cast<int>(daftar_blok().size()) ||
+            par < 0 || par > static_cast<int>(Paralel::OUTPUT)) return false;
+        k.blok = blok;
+        k.paralel = static_cast<Paralel>(par);
+        kunci = Kunci(b, in, out, t);
+        return true;
+    }
+
+    // Baris dari CPU lain di lewati //
+    void muat() {
+        dimuat = true;
+        if (path.empty()) return;
+        std::ifstream f(path);
+        std::string baris, model;
+        while (std::getline(f, baris)) {
+            Kunci kunci;
+            KonfigurasiLinear k;
+            if (parse_baris(baris, model, kunci, k) && model == cpu) tabel[kunci] = k;
+        }
+    }
+
+    /*
+    Tulis ulang file cache: baris CPU lain di biarkan, baris CPU ini di gabung dengan tabel
+    (satu baris per kunci, yang di memori menang). File nya di baca lagi tepat sebelum nulis,
+    jadi hasil tuning proses lain yang masuk setelah muat() ikut ke simpan.
+    Di tulis ke file sementara lalu rename, jadi pembaca gak pernah lihat file setengah jadi.
+    Kalau gagal (misal folder gak ada) cukup di memori.
+    */
+    void simpan() const {
+        if (path.empty()) return;
+        std::vector<std::string> lain;
+        Tabel gabung;
+        {
+            std::ifstream f(path);
+            std::string baris, model;
+            while (std::getline(f, baris)) {
+                Kunci kunci;
+                KonfigurasiLinear k;
+                if (!parse_baris(baris, model, kunci, k)) continue;
+                if (model == cpu) {
+                    gabung[kunci] = k;
+                } else {
+                    lain.push_back(baris);
+                }
+            }
+        }
+        for (const auto& kv : tabel) gabung[kv.first] = kv.second;
+
+        std::ostringstream id;
+#if defined(__unix__) || defined(__APPLE__)
+        id << ::getpid();
+#endif
+        id << '.' << std::this_thread::get_id();
+        const std::string tmp = path + ".tmp." + id.str();
+        {
+            std::ofstream f(tmp, std::ios::trunc);
+            if (!f) return;
+            for (const std::string& baris : lain) f << baris << '\n';
+            for (const auto& kv : gabung) {
+                const KonfigurasiLinear& k = kv.second;
+                f << cpu << '\t' << "linear " << std::get<0>(kv.first) << ' ' << std::get<1>(kv.first) << ' '
+                  << std::get<2>(kv.first) << ' ' << std::get<3>(kv.first) << ' ' << k.blok << ' '
+                  << static_cast<int>(k.paralel) << ' ' << k.waktu_us << ' ' << k.waktu_bawaan_us << '\n';
+            }
+            f.flush();
+            if (!f) {
+                f.close();
+                std::remove(tmp.c_str());
+                return;
+            }
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+        }
+    }
+
+    // Waktu terbaik (us) satu konfigurasi, di ulang sampai kira-kira 10 ms atau 10 kali //
+    static double ukur(const KonfigurasiLinear& k, const double* x, const double* w, const double* bias,
+                       double* y, dl::index_t batch, dl::index_t in, dl::index_t out) {
+        using clock = std::chrono::steady_clock;
+        auto t0 = clock::now();
+        linear_dengan(k, x, w, bias, y, batch, in, out);   // Pemanasan //
+        double terbaik = std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+        const int ulang = static_cast<int>(std::min(10.0, std::max(1.0, 10000.0 / std::max(terbaik, 1.0))));
+        for (int r = 0; r < ulang; ++r) {
+            t0 = clock::now();
+            linear_dengan(k, x, w, bias, y, batch, in, out);
+            terbaik = std::min(terbaik, std::chrono::duration<double, std::micro>(clock::now() - t0).count());
+        }
+        return terbaik;
+    }
+
+    // Benchmark semua kandidat di data dummy (bukan generator random, biar stream random training gak geser) //
+    static KonfigurasiLinear tuning(dl::index_t batch, dl::index_t in, dl::index_t out) {
+        std::vector<double> x(static_cast<size_t>(batch * in)), w(static_cast<size_t>(out * in));
+        std::vector<double> bias(static_cast<size_t>(out)), y(static_cast<size_t>(batch * out));
+        for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<double>(i % 17) * 0.125 - 1.0;
+        for (size_t i = 0; i < w.size(); ++i) w[i] = static_cast<double>(i % 13) * 0.0625 - 0.375;
+        for (size_t i = 0; i < bias.size(); ++i) bias[i] = 0.5;
+
+        std::vector<Paralel> daftar_paralel = {Paralel::SERIAL};
+        if (dl::jumlah_thread() > 1) {
+            daftar_paralel.push_back(Paralel::BATCH);
+            daftar_paralel.push_back(Paralel::OUTPUT);
+        }
+
+        KonfigurasiLinear terbaik;
+        terbaik.waktu_us = -1.0;
+        double bawaan = 0.0;
+        for (int blok = 0; blok < static_cast<int>(daftar_blok().size()); ++blok) {
+            for (Paralel p : daftar_paralel) {
+                KonfigurasiLinear k;
+                k.blok = blok;
+                k.paralel = p;
+                const double t = ukur(k, x.data(), w.data(), bias.data(), y.data(), batch, in, out);
+                if (blok == 0 && p == Paralel::SERIAL) bawaan = t;
+                if (terbaik.waktu_us < 0.0 || t < terbaik.waktu_us) {
+                    terbaik = k;
+                    terbaik.waktu_us = t;
+                }
+            }
+        }
+        terbaik.waktu_bawaan_us = bawaan;
+        return terbaik;
+    }
+
+public:
+    Autotuner() : cpu(model_cpu()), path(path_bawaan()) {
+        if (const char* env = std::getenv("DL_AUTOTUNE")) {
+            aktif = std::atoi(env) != 0;
+        }
+    }
+
+    /*
+    Konfigurasi buat shape ini, di tuning dulu kalau belum ada.
+    Benchmark nya jalan di luar lock. Selama satu thread lagi nuning shape itu, thread lain
+    langsung pakai kernel bawaan (hasil nya sama persis), gak nunggu.
+    */
+    KonfigurasiLinear pilih_linear(dl::index_t batch, dl::index_t in, dl::index_t out) {
+        if (!aktif.load(std::memory_order_relaxed)) return KonfigurasiLinear();
+        const Kunci kunci(bucket_batch(batch), in, out, dl::jumlah_thread());
+
+        CacheLokal& lokal = cache_lokal();
+        const uint64_t gen = generasi.load(std::memory_order_acquire);
+        if (lokal.pemilik != this || lokal.generasi != gen) {
+            lokal.pemilik = this;
+            lokal.generasi = gen;
+            lokal.tabel.clear();
+        }
+        auto it_lokal = lokal.tabel.find(kunci);
+        if (it_lokal != lokal.tabel.end()) return it_lokal->second;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!dimuat) muat();
+            auto it = tabel.find(kunci);
+            if (it != tabel.end()) {
+                lokal.tabel[kunci] = it->second;
+                return it->second;
+            }
+            if (std::find(sedang_dituning.begin(), sedang_dituning.end(), kunci) != sedang_dituning.end()) {
+                return KonfigurasiLinear();
+            }
+            sedang_dituning.push_back(kunci);
+        }
+
+        KonfigurasiLinear k = tuning(std::get<0>(kunci), in, out);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        sedang_dituning.erase(std::find(sedang_dituning.begin(), sedang_dituning.end(), kunci));
+        // Tabel nya bisa sudah di reset selama benchmark, hasil nya tetap valid buat generasi baru //
+        tabel[kunci] = k;
+        simpan();
+        if (generasi.load(std::memory_order_relaxed) == lokal.generasi) {
+            lokal.tabel[kunci] = k;
+        }
+        return k;
+    }
+
+    void atur_aktif(bool nilai) {
+        aktif.store(nilai);
+    }
+
+    bool sedang_aktif() const { return aktif.load(); }
+
+    // Ganti file cache (string kosong = cuma di memori), tabel di memori di kosongkan dan di muat ulang dari file baru //
+    void atur_file_cache(const std::string& p) {
+        std::lock_guard<std::mutex> lock(mtx);
+        path = p;
+        tabel.clear();
+        dimuat = false;
+        generasi.fetch_add(1, std::memory_order_release);
+    }
+
+    const std::string& dapatkan_file_cache() const { return path; }
+    const std::string& dapatkan_cpu() const { return cpu; }
+
+    // Lupakan hasil tuning di memori (file nya gak di sentuh) //
+    void reset() {
+        std::lock_guard<std::mutex> lock(mtx);
+        tabel.clear();
+        dimuat = true;
+        generasi.fetch_add(1, std::memory_order_release);
+    }
+
+    void laporan(std::ostream& os) {
+        std::lock_guard<std::mutex> lock(mtx);
+        os << "Autotune linear (" << cpu << ", cache: " << path << ")" << std::endl;
+        for (const auto& kv : tabel) {
+            const KonfigurasiLinear& k = kv.second;
+            const Blok bl = daftar_blok()[k.blok];
+            os << "  [batch <= " << std::get<0>(kv.first) << ", " << std::get<1>(kv.first) << " -> "
+               << std::get<2>(kv.first) << "] t=" << std::get<3>(kv.first)
+               << "  blok " << bl.rb << "x" << bl.ro << " " << nama_paralel(k.paralel)
+               << std::fixed << std::setprecision(1) << "  " << k.waktu_us << " us"
+               << " (bawaan " << k.waktu_bawaan_us << " us)" << std::defaultfloat << std::endl;
+        }
+    }
+};
+
+inline Autotuner& autotuner() {
+    static Autotuner a;
+    return a;
+}
+
+// y[batch, out] = x[batch, in] @ w[out, in]^T + bias, pakai konfigurasi hasil tuning //
+inline void linear(const double* x, const double* w, const double* bias, double* y,
+                   dl::index_t batch, dl::index_t in, dl::index_t out) {
+    linear_dengan(autotuner().pilih_linear(batch, in, out), x, w, bias, y, batch, in, out);
+}
+
+} // namespace tuning //
+} // namespace dl //
+
+#endif
@@ -4,7 +4,16 @@
 #include "Tensor.h"
 #include "Tensor_operator.h"
 #include "Tensor_factory.h"
+#include "SparseTensor.h"
+#include "Half.h"
+#include "Profiler.h"
+#include "Autograd.h"
+#include "Optimizer.h"
+#include "Autotune.h"
+#include "Reduction.h"
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 /*
 Dense Layer (Fully Connected Layer)
@@ -13,12 +22,21 @@ Dense layer melakukan operasi: output = input @ bobot + bias
 
 Rumus Matematika:
 z = X * W^T + b  (dimana X = [batch, in], W = [out, in], b = [out])
+
+Input nya juga bisa SparseTensor (CSR), buat fitur one-hot / hashed yang hampir semua nya nol.
+Forward nya cuma ngitung elemen yang bukan nol, dan backward nya cuma nyentuh
+kolom bobot yang muncul di batch itu.
+
+Mixed precision (atur_presisi BF16 / FP16):
+bobot master nya tetap double (yang di update optimizer), tapi forward dan backward
+baca salinan 16-bit nya (bobot_half), dan cache input nya juga di simpan 16-bit.
+Perkalian nya di akumulasi di fp32. Salinan 16-bit di sinkron ulang setiap bobot berubah.
 */
 
 class Dense {
 private:
-    int in_features;   // Ukuran input //
-    int out_features;  // Ukuran output //
+    dl::index_t in_features;   // Ukuran input //
+    dl::index_t out_features;  // Ukuran output //
     
     Tensor bobot;    // Shape: [out_features, in_features] //
     Tensor bias;       // Shape: [out_features] //
@@ -30,6 +48,39 @@ private:
     // Cache untuk backward pass //
     Tensor cached_input;
     
+    // Cache kalau input nya sparse, cuma salah satu dari cached_input / cached_sparse yang di pakai //
+    SparseTensor cached_sparse;
+    bool input_sparse = false;
+    
+    // Mixed precision: salinan bobot dan cache input 16-bit //
+    dl::Presisi presisi = dl::Presisi::FP64;
+    TensorHalf bobot_half;
+    TensorHalf cached_half;
+    /*
+    Buffer fp32 kerja forward_half / backward_half, kapasitas nya di pakai ulang antar panggilan.
+    Satu set per thread di pakai bareng semua Dense (layer nya jalan berurutan), jadi memori nya
+    sebesar layer terbesar; kalau per layer, buffer x nya sendiri sudah 2x cache 16-bit nya.
+    */
+    using BufferFloat = std::vector<float, dl::memori::TrackingAllocator<float>>;
+    struct BufferHalf {
+        BufferFloat x;
+        BufferFloat w;
+        BufferFloat gx;
+    };
+    static BufferHalf& buffer_half() {
+        thread_local BufferHalf b;
+        return b;
+    }
+    
+    // Kolom bobot yang di sentuh backward sparse terakhir //
+    // Kalau grad_sparse true, cuma kolom ini yang gradient nya bisa bukan nol //
+    std::vector<dl::index_t> kolom_aktif;
+    bool grad_sparse = false;
+    // true kalau grad_bobot di jamin nol semua (habis zero_grad) //
+    bool grad_nol = true;
+    // Kalau true, backward nambah ke gradient lama (gradient accumulation), gak di reset //
+    bool akumulasi_grad = false;
+    
     // Opsi untuk menggunakan bias atau tidak //
     bool gunakan_bias;
 
@@ -38,19 +89,23 @@ public:
     Dense() : in_features(0), out_features(0), gunakan_bias(true) {}
     
     // Constructor dengan inisialisasi Kaiming //
-    Dense(int in_features_, int out_features_, bool gunakan_bias_ = true) 
+    Dense(dl::index_t in_features_, dl::index_t out_features_, bool gunakan_bias_ = true) 
         : in_features(in_features_), out_features(out_features_), gunakan_bias(gunakan_bias_) {
+        DL_MEMORY_TAG("Dense::parameter");
         
         // Inisialisasi bobot dengan Kaiming initialization //
         // Ini optimal untuk layers yang diikuti ReLU //
         bobot = dl::kaiming_normal({out_features, in_features});
+        bobot.set_requires_grad(true);
         
         // Inisialisasi bias dengan zeros //
         if (gunakan_bias) {
             bias = dl::zeros({out_features});
+            bias.set_requires_grad(true);
         }
         
-        // Pre-allocate gradients //
+        // Pre-allocate gradients, buffer nya di pakai terus (zero_grad nol-in di tempat) //
+        DL_MEMORY_TAG("Dense::gradien");
         grad_bobot = dl::zeros({out_features, in_features});
         if (gunakan_bias) {
             grad_bias = dl::zeros({out_features});
@@ -61,138 +116,480 @@ public:
     // Input shape: [batch_size, in_features] // 
     // Output shape: [batch_size, out_features] //
     Tensor forward(const Tensor& input) {
+        if (presisi != dl::Presisi::FP64) {
+            return forward_half(input);
+        }
+        DL_MEMORY_TAG("Dense::forward");
+
         // Cache input untuk backward pass //
-        cached_input = input;
+        {
+            DL_MEMORY_TAG("Dense::cache_input");
+            cached_input = input;
+        }
+        cached_sparse = SparseTensor();
+        cached_half = TensorHalf();
+        input_sparse = false;
         
         const auto& input_shape = input.get_shape();
-        int batch_size = input_shape[0];
+        dl::index_t batch_size = input_shape[0];
+        DL_PROFILE("Dense::forward", static_cast<uint64_t>(batch_size) * in_features * out_features);
         
         // Alokasi output //
+        Tensor output({batch_size, out_features});
+        
+        // Matrix multiplication: output[i,j] = sum_k(input[i,k] * bobot[j,k]) + bias[j] //
+        // Ini adalah X @ W^T, blok register dan thread nya di pilih autotuner per shape (Autotune.h) //
+        dl::tuning::linear(input.data_ptr(), bobot.data_ptr(), gunakan_bias ? bias.data_ptr() : nullptr,
+                           output.data_ptr(), batch_size, in_features, out_features);
+        
+        return output;
+    }
+    
+    /*
+    Forward dengan input sparse (SpMM): output[b,o] = sum_p(nilai[p] * bobot[o, kolom[p]]) + bias[o]
+    p jalan di elemen bukan nol baris b saja, jadi biaya nya nnz * out_features
+    bukan batch * in_features * out_features.
+    */
+    Tensor forward(const SparseTensor& input) {
+        DL_MEMORY_TAG("Dense::forward");
+        assert(input.get_shape()[1] == in_features && "Kolom input sparse harus sama dengan in_features");
+        
+        {
+            DL_MEMORY_TAG("Dense::cache_input");
+            cached_sparse = input;
+        }
+        cached_input = Tensor();
+        cached_half = TensorHalf();
+        input_sparse = true;
+        
+        dl::index_t batch_size = input.get_shape()[0];
+        DL_PROFILE("Dense::forward_sparse", static_cast<uint64_t>(input.nnz()) * out_features);
+        
         Tensor output = dl::zeros({batch_size, out_features});
+        const auto& offset = input.get_offset_baris();
+        const auto& kolom = input.get_indeks_kolom();
+        const auto& nilai = input.get_nilai();
         
-        // Matrix multiplication: output[i,j] = sum_k(input[i,k] * bobot[j,k]) //
-        // Ini adalah X @ W^T //
-        for (int b = 0; b < batch_size; ++b) {
-            for (int o = 0; o < out_features; ++o) {
+        for (dl::index_t b = 0; b < batch_size; ++b) {
+            double* y = output.row_ptr(b);
+            const dl::index_t p0 = offset[b];
+            const dl::index_t p1 = offset[b + 1];
+            
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                const double* w = bobot.row_ptr(o);
                 double sum = 0.0;
-                
-                // Loop unrolling untuk in_features kecil //
-                int k = 0;
-                // Proses 4 elemen sekaligus //
-                for (; k + 3 < in_features; k += 4) {
-                    sum += input.at({b, k})     * bobot.at({o, k});
-                    sum += input.at({b, k + 1}) * bobot.at({o, k + 1});
-                    sum += input.at({b, k + 2}) * bobot.at({o, k + 2});
-                    sum += input.at({b, k + 3}) * bobot.at({o, k + 3});
+                for (dl::index_t p = p0; p < p1; ++p) {
+                    sum += nilai[p] * w[kolom[p]];
                 }
-                // Handle sisa elemen //
-                for (; k < in_features; ++k) {
-                    sum += input.at({b, k}) * bobot.at({o, k});
-                }
-                
-                // Tambahkan bias jika ada //
                 if (gunakan_bias) {
                     sum += bias[o];
                 }
-                
-                output.at({b, o}) = sum;
+                y[o] = sum;
             }
         }
         
         return output;
     }
     
+private:
+    // Siapkan grad_bobot buat backward yang nyentuh semua kolom //
+    // Normal nya di reset, kalau akumulasi gradient lama nya di pakai terus (dan jadi dense) //
+    void mulai_grad_penuh() {
+        if (!akumulasi_grad) {
+            zero_grad();
+        }
+        grad_nol = false;
+        grad_sparse = false;
+        kolom_aktif.clear();
+    }
+    
+public:
     // Backward pass - menghitung gradients untuk bobot, bias, dan input //
     // grad_output: gradient dari loss terhadap output layer ini [batch_size, out_features] //
     // Returns: gradient terhadap input [batch_size, in_features] //
     Tensor backward(const Tensor& grad_output) {
         const auto& grad_shape = grad_output.get_shape();
-        const auto& input_shape = cached_input.get_shape();
-        
-        int batch_size = grad_shape[0];
         
-        // Reset gradients //
-        grad_bobot = dl::zeros({out_features, in_features});
-        if (gunakan_bias) {
-            grad_bias = dl::zeros({out_features});
+        dl::index_t batch_size = grad_shape[0];
+        if (input_sparse) {
+            return backward_sparse(grad_output);
         }
+        if (!cached_half.kosong()) {
+            return backward_half(grad_output);
+        }
+        DL_PROFILE("Dense::backward", static_cast<uint64_t>(batch_size) * in_features * out_features);
+        
+        DL_MEMORY_TAG("Dense::backward");
+        
+        // Reset gradients, kecuali lagi akumulasi //
+        mulai_grad_penuh();
         
         // Alokasi gradient untuk input //
         Tensor grad_input = dl::zeros({batch_size, in_features});
         
         /* 
         BACKWARD PASS:
-        Kita menghitung ketiga gradient dalam satu loop untuk menghindari
-        multiple passes over data dan meningkatkan cache locality.
-        
         1. grad_bobot[o,i] += sum_b(grad_output[b,o] * cached_input[b,i])
         2. grad_bias[o] += sum_b(grad_output[b,o])
         3. grad_input[b,i] = sum_o(grad_output[b,o] * bobot[o,i])
+        
+        Gradient bias itu reduksi sumbu batch, jadi pakai dl::reduksi::jumlah_baris
+        (berurutan di b, vectorize di o) di luar loop bobot.
         */
+        if (gunakan_bias) {
+            dl::reduksi::jumlah_baris(grad_output.data_ptr(), batch_size, out_features, grad_bias.data_ptr(), true);
+        }
         
-        // Single pass computation untuk bobot gradient dan bias gradient //
-        for (int b = 0; b < batch_size; ++b) {
-            for (int o = 0; o < out_features; ++o) {
-                double grad_o = grad_output.at({b, o});
-                
-                // Update bias gradient (sum over batch) //
-                if (gunakan_bias) {
-                    grad_bias[o] += grad_o;
-                }
+        // Bobot gradient //
+        for (dl::index_t b = 0; b < batch_size; ++b) {
+            const double* g = grad_output.row_ptr(b);
+            const double* x = cached_input.row_ptr(b);
+            
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                double grad_o = g[o];
+                double* gw = grad_bobot.row_ptr(o);
                 
                 // Update weight gradients: dL/dW = X^T @ dL/dz //
                 // Dengan loop unrolling untuk optimasi //
-                int i = 0;
+                dl::index_t i = 0;
                 for (; i + 3 < in_features; i += 4) {
-                    grad_bobot.at({o, i})     += grad_o * cached_input.at({b, i});
-                    grad_bobot.at({o, i + 1}) += grad_o * cached_input.at({b, i + 1});
-                    grad_bobot.at({o, i + 2}) += grad_o * cached_input.at({b, i + 2});
-                    grad_bobot.at({o, i + 3}) += grad_o * cached_input.at({b, i + 3});
+                    gw[i]     += grad_o * x[i];
+                    gw[i + 1] += grad_o * x[i + 1];
+                    gw[i + 2] += grad_o * x[i + 2];
+                    gw[i + 3] += grad_o * x[i + 3];
                 }
                 for (; i < in_features; ++i) {
-                    grad_bobot.at({o, i}) += grad_o * cached_input.at({b, i});
+                    gw[i] += grad_o * x[i];
                 }
             }
         }
         
         // Compute gradient untuk input: dL/dX = dL/dz @ W //
         // Ini adalah grad_output @ bobot //
-        for (int b = 0; b < batch_size; ++b) {
-            for (int i = 0; i < in_features; ++i) {
-                double sum = 0.0;
+        /*
+        Bobot nya di jalan per baris (gx += g[o] * W[o, :]), bukan per kolom.
+        Jalan per kolom itu loncat in_features elemen setiap langkah, dan kalau in_features
+        kelipatan 2 pangkat, semua elemen kolom jatuh ke set cache yang sama.
+        Urutan penjumlahan per gx[i] tetap o = 0, 1, 2, ... jadi hasil nya sama persis.
+        */
+        for (dl::index_t b = 0; b < batch_size; ++b) {
+            const double* g = grad_output.row_ptr(b);
+            double* gx = grad_input.row_ptr(b);
+            
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                const double grad_o = g[o];
+                const double* w = bobot.row_ptr(o);
                 
-                // Loop unrolling untuk out_features //
-                int o = 0;
-                for (; o + 3 < out_features; o += 4) {
-                    sum += grad_output.at({b, o})     * bobot.at({o, i});
-                    sum += grad_output.at({b, o + 1}) * bobot.at({o + 1, i});
-                    sum += grad_output.at({b, o + 2}) * bobot.at({o + 2, i});
-                    sum += grad_output.at({b, o + 3}) * bobot.at({o + 3, i});
+                dl::index_t i = 0;
+                for (; i + 3 < in_features; i += 4) {
+                    gx[i]     += grad_o * w[i];
+                    gx[i + 1] += grad_o * w[i + 1];
+                    gx[i + 2] += grad_o * w[i + 2];
+                    gx[i + 3] += grad_o * w[i + 3];
                 }
-                for (; o < out_features; ++o) {
-                    sum += grad_output.at({b, o}) * bobot.at({o, i});
+                for (; i < in_features; ++i) {
+                    gx[i] += grad_o * w[i];
                 }
-                
-                grad_input.at({b, i}) = sum;
             }
         }
         
         return grad_input;
     }
     
-    // Update bobot dengan gradient descent //
+    /*
+    Forward mixed precision.
+    Input nya di simpan 16-bit (itu juga yang jadi cache buat backward),
+    lalu setiap baris bobot di konversi ke float sekali dan di pakai buat semua baris batch.
+    Dot product nya di akumulasi di fp32.
+    */
+    Tensor forward_half(const Tensor& input) {
+        DL_MEMORY_TAG("Dense::forward");
+        {
+            DL_MEMORY_TAG("Dense::cache_input");
+            cached_half.salin_dari(input, presisi);
+        }
+        cached_input = Tensor();
+        cached_sparse = SparseTensor();
+        input_sparse = false;
+        
+        const dl::index_t batch_size = input.get_shape()[0];
+        DL_PROFILE("Dense::forward_half", static_cast<uint64_t>(batch_size) * in_features * out_features);
+        
+        BufferHalf& buf = buffer_half();
+        {
+            DL_MEMORY_TAG("Dense::buffer_half");
+            buf.x.resize(static_cast<size_t>(batch_size * in_features));
+            buf.w.resize(static_cast<size_t>(in_features));
+        }
+        float* x = buf.x.data();
+        float* w = buf.w.data();
+        dl::half::dari_half(cached_half.row_ptr(0), x, batch_size * in_features, presisi);
+        
+        Tensor output = dl::zeros({batch_size, out_features});
+        for (dl::index_t o = 0; o < out_features; ++o) {
+            bobot_half.baris_ke_float(o, w);
+            const double b_o = gunakan_bias ? bias[o] : 0.0;
+            for (dl::index_t b = 0; b < batch_size; ++b) {
+                output[b * out_features + o] =
+                    static_cast<double>(dot_fp32(x + b * in_features, w, in_features)) + b_o;
+            }
+        }
+        return output;
+    }
+    
+    // Dot product fp32 dengan 8 akumulator terpisah, biar compiler bisa vectorize (SIMD) //
+    static float dot_fp32(const float* a, const float* b, dl::index_t n) {
+        float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        dl::index_t k = 0;
+        for (; k + 8 <= n; k += 8) {
+            for (int j = 0; j < 8; ++j) {
+                acc[j] += a[k + j] * b[k + j];
+            }
+        }
+        float sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        for (; k < n; ++k) {
+            sum += a[k] * b[k];
+        }
+        return sum;
+    }
+    
+    // Backward mixed precision, gradient bobot nya tetap double (buat bobot master) //
+    Tensor backward_half(const Tensor& grad_output) {
+        DL_MEMORY_TAG("Dense::backward");
+        const dl::index_t batch_size = grad_output.get_shape()[0];
+        DL_PROFILE("Dense::backward_half", static_cast<uint64_t>(batch_size) * in_features * out_features);
+        
+        mulai_grad_penuh();
+        if (gunakan_bias) {
+            dl::reduksi::jumlah_baris(grad_output.data_ptr(), batch_size, out_features, grad_bias.data_ptr(), true);
+        }
+        
+        BufferHalf& buf = buffer_half();
+        {
+            DL_MEMORY_TAG("Dense::buffer_half");
+            buf.x.resize(static_cast<size_t>(batch_size * in_features));
+            buf.w.resize(static_cast<size_t>(in_features));
+            buf.gx.assign(static_cast<size_t>(batch_size * in_features), 0.0f);
+        }
+        float* x = buf.x.data();
+        float* w = buf.w.data();
+        float* gx = buf.gx.data();
+        dl::half::dari_half(cached_half.row_ptr(0), x, batch_size * in_features, presisi);
+        
+        for (dl::index_t o = 0; o < out_features; ++o) {
+            double* gw = grad_bobot.row_ptr(o);
+            bobot_half.baris_ke_float(o, w);
+            for (dl::index_t b = 0; b < batch_size; ++b) {
+                const float grad_o = static_cast<float>(grad_output[b * out_features + o]);
+                const float* xb = x + b * in_features;
+                float* gxb = gx + b * in_features;
+                // dL/dW[o, :] += g[b, o] * x[b, :] //
+                for (dl::index_t i = 0; i < in_features; ++i) {
+                    gw[i] += grad_o * xb[i];
+                }
+                // dL/dX[b, :] += g[b, o] * W[o, :] //
+                for (dl::index_t i = 0; i < in_features; ++i) {
+                    gxb[i] += grad_o * w[i];
+                }
+            }
+        }
+        
+        Tensor grad_input({batch_size, in_features});
+        for (dl::index_t i = 0; i < grad_input.numel(); ++i) {
+            grad_input[i] = gx[i];
+        }
+        return grad_input;
+    }
+    
+    // Ganti presisi penyimpanan bobot dan cache input //
+    void atur_presisi(dl::Presisi p) {
+        DL_MEMORY_TAG("Dense::parameter");
+        presisi = p;
+        cached_half = TensorHalf();
+        if (p == dl::Presisi::FP64) {
+            bobot_half = TensorHalf();
+        } else {
+            bobot_half.salin_dari(bobot, p);
+        }
+    }
+    
+    dl::Presisi dapatkan_presisi() const { return presisi; }
+    const TensorHalf& dapatkan_bobot_half() const { return bobot_half; }
+    // Jumlah elemen cache input 16-bit forward terakhir //
+    dl::index_t elemen_cache_half() const { return cached_half.numel(); }
+    // Kapasitas buffer fp32 kerja thread ini (bytes), di pakai bareng semua Dense //
+    static long long bytes_buffer_half() {
+        const BufferHalf& b = buffer_half();
+        return static_cast<long long>(b.x.capacity() + b.w.capacity() + b.gx.capacity()) * sizeof(float);
+    }
+    
+    // Salin ulang bobot master ke salinan 16-bit, panggil setiap bobot berubah //
+    void sinkron_half() {
+        if (presisi != dl::Presisi::FP64) {
+            bobot_half.salin_dari(bobot, presisi);
+        }
+    }
+    
+    /*
+    Backward kalau forward terakhir pakai input sparse.
+    grad_bobot[o, k] cuma bisa bukan nol di kolom k yang muncul di batch,
+    jadi yang di nol-in dan di isi cuma kolom-kolom itu (kolom_aktif).
+    Gradient ke input gak di hitung (return Tensor kosong), karna input sparse
+    itu data mentah, gak ada layer sebelum nya yang butuh gradient.
+    */
+    Tensor backward_sparse(const Tensor& grad_output) {
+        DL_MEMORY_TAG("Dense::backward");
+        const dl::index_t batch_size = grad_output.get_shape()[0];
+        DL_PROFILE("Dense::backward_sparse", static_cast<uint64_t>(cached_sparse.nnz()) * out_features);
+        
+        const auto& offset = cached_sparse.get_offset_baris();
+        const auto& kolom = cached_sparse.get_indeks_kolom();
+        const auto& nilai = cached_sparse.get_nilai();
+        
+        // Nol-in gradient lama: kalau sebelum nya juga sparse cukup kolom lama nya saja //
+        // Kalau lagi akumulasi, gradient lama nya di biarkan, kolom aktif nya jadi gabungan //
+        const bool tambah = akumulasi_grad && !grad_nol;
+        if (!grad_nol && !tambah) {
+            if (grad_sparse) {
+                for (dl::index_t o = 0; o < out_features; ++o) {
+                    double* gw = grad_bobot.row_ptr(o);
+                    for (dl::index_t k : kolom_aktif) {
+                        gw[k] = 0.0;
+                    }
+                }
+            } else {
+                std::fill(grad_bobot.begin(), grad_bobot.end(), 0.0);
+            }
+        }
+        if (gunakan_bias) {
+            dl::reduksi::jumlah_baris(grad_output.data_ptr(), batch_size, out_features, grad_bias.data_ptr(), tambah);
+        }
+        
+        // Kolom yang muncul di batch ini (plus kolom lama kalau akumulasi gradient sparse) //
+        // Kalau gradient lama nya dense, hasil nya tetap dense //
+        const bool tetap_sparse = !tambah || grad_sparse;
+        if (!tambah) {
+            kolom_aktif.clear();
+        }
+        if (tetap_sparse) {
+            kolom_aktif.insert(kolom_aktif.end(), kolom.begin(), kolom.end());
+            std::sort(kolom_aktif.begin(), kolom_aktif.end());
+            kolom_aktif.erase(std::unique(kolom_aktif.begin(), kolom_aktif.end()), kolom_aktif.end());
+        }
+        grad_sparse = tetap_sparse;
+        grad_nol = false;
+        
+        // grad_bobot[o, k] += grad_output[b, o] * x[b, k] buat k yang bukan nol //
+        for (dl::index_t b = 0; b < batch_size; ++b) {
+            const double* g = grad_output.row_ptr(b);
+            const dl::index_t p0 = offset[b];
+            const dl::index_t p1 = offset[b + 1];
+            
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                const double grad_o = g[o];
+                double* gw = grad_bobot.row_ptr(o);
+                for (dl::index_t p = p0; p < p1; ++p) {
+                    gw[kolom[p]] += grad_o * nilai[p];
+                }
+            }
+        }
+        
+        return Tensor();
+    }
+    
+    // Kolom bobot yang gradient nya bisa bukan nol (valid kalau gradient_sparse() true) //
+    const std::vector<dl::index_t>& dapatkan_kolom_aktif() const { return kolom_aktif; }
+    bool gradient_sparse() const { return grad_sparse; }
+    
+    // Forward pass lewat autograd: operasi nya di rekam di tape //
+    // Backward nya gak perlu di panggil manual, cukup dl::autograd::backward(loss) //
+    Tensor forward_autograd(const Tensor& input) const {
+        DL_MEMORY_TAG("Dense::forward");
+        DL_PROFILE("Dense::forward_autograd",
+                   static_cast<uint64_t>(input.get_shape()[0]) * in_features * out_features);
+        return dl::autograd::linear(input, bobot, bias);
+    }
+    
+    // Ambil gradient bobot dan bias dari tape setelah dl::autograd::backward //
+    // Kalau lagi akumulasi, gradient tape nya di tambahkan ke gradient lama //
+    void ambil_grad_autograd() {
+        DL_MEMORY_TAG("Dense::gradien");
+        if (akumulasi_grad && !grad_nol) {
+            grad_bobot += dl::autograd::grad(bobot);
+            if (gunakan_bias) {
+                grad_bias += dl::autograd::grad(bias);
+            }
+        } else {
+            grad_bobot = dl::autograd::grad(bobot);
+            if (gunakan_bias) {
+                grad_bias = dl::autograd::grad(bias);
+            }
+        }
+        grad_nol = false;
+        grad_sparse = false;
+        kolom_aktif.clear();
+    }
+    
+    // Update bobot dengan gradient descent biasa //
+    // Sama kek dl::optim::SGD tanpa momentum, tapi bisa cuma nyentuh kolom aktif kalau input nya sparse //
     void update_bobot(double learning_rate) {
+        DL_PROFILE("Dense::update_bobot", num_parameters());
         // bobot = bobot - learning_rate * grad_bobot //
-        for (int i = 0; i < bobot.numel(); ++i) {
-            bobot[i] -= learning_rate * grad_bobot[i];
+        // Kalau gradient nya dari input sparse, kolom lain gradient nya nol jadi gak perlu di sentuh //
+        if (grad_sparse) {
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                double* w = bobot.row_ptr(o);
+                const double* gw = grad_bobot.row_ptr(o);
+                for (dl::index_t k : kolom_aktif) {
+                    w[k] -= learning_rate * gw[k];
+                }
+            }
+        } else {
+            for (dl::index_t i = 0; i < bobot.numel(); ++i) {
+                bobot[i] -= learning_rate * grad_bobot[i];
+            }
         }
         
         // bias = bias - learning_rate * grad_bias
         if (gunakan_bias) {
-            for (int i = 0; i < bias.numel(); ++i) {
+            for (dl::index_t i = 0; i < bias.numel(); ++i) {
                 bias[i] -= learning_rate * grad_bias[i];
             }
         }
+        sinkron_half();
+    }
+    
+    // Update bobot dan bias in-place pakai optimizer, id nya dari Optimizer::daftar_parameter //
+    // Bobot nya tetap Tensor yang sama, jadi gak perlu copy keluar lalu set_bobot lagi //
+    // Kalau gradient nya dari input sparse, cuma kolom aktif yang di update (Optimizer::update_kolom) //
+    void optimisasi(dl::optim::Optimizer& opt, int id_bobot, int id_bias) {
+        if (grad_sparse) {
+            opt.update_kolom(id_bobot, bobot.data_ptr(), grad_bobot.data_ptr(), out_features, in_features, kolom_aktif);
+        } else {
+            opt.update(id_bobot, bobot.data_ptr(), grad_bobot.data_ptr(), bobot.numel());
+        }
+        if (gunakan_bias) {
+            opt.update(id_bias, bias.data_ptr(), grad_bias.data_ptr(), bias.numel());
+        }
+        if (grad_sparse && presisi != dl::Presisi::FP64) {
+            bobot_half.salin_kolom(bobot, kolom_aktif);
+        } else {
+            sinkron_half();
+        }
+    }
+    
+    // Lepas cache input, dipakai gradient checkpointing biar aktivasi gak numpuk //
+    // Harus forward lagi sebelum backward kalau cache nya sudah di lepas //
+    void lepas_cache() {
+        cached_input = Tensor();
+        cached_sparse = SparseTensor();
+        cached_half = TensorHalf();
+    }
+    
+    // Ukuran cache input dalam bytes //
+    long long bytes_cache() const {
+        return static_cast<long long>(cached_input.numel()) * sizeof(double) +
+               (input_sparse ? cached_sparse.bytes() : 0) + cached_half.bytes();
     }
     
     // Getters untuk bobot dan bias //
@@ -203,30 +600,104 @@ public:
     const Tensor& dapatkan_grad_bobot() const { return grad_bobot; }
     const Tensor& dapatkan_grad_bias() const { return grad_bias; }
     
-    // Setters untuk bobot dan bias //
-    void set_bobot(const Tensor& w) { bobot = w; }
-    void set_bias(const Tensor& b) { bias = b; }
+    // Buffer gradient yang boleh di tulis dari luar (misal all-reduce data-parallel) //
+    // Penulis nya bisa nyentuh semua kolom, jadi gradient nya di anggap dense lagi //
+    void buffer_gradient(std::vector<std::pair<double*, dl::index_t>>& out) {
+        grad_sparse = false;
+        kolom_aktif.clear();
+        out.emplace_back(grad_bobot.data_ptr(), grad_bobot.numel());
+        if (gunakan_bias) {
+            out.emplace_back(grad_bias.data_ptr(), grad_bias.numel());
+        }
+    }
     
+    // Setters untuk bobot dan bias //
+    // Bobot dan bias selalu jadi leaf autograd, jadi status tape nya di reset //
+    void set_bobot(const Tensor& w) {
+        bobot = w;
+        bobot.set_requires_grad(true);
+        bobot.set_tape_slot(-1, 0);
+        sinkron_half();
+    }
+    void set_bias(const Tensor& b) {
+        bias = b;
+        bias.set_requires_grad(true);
+        bias.set_tape_slot(-1, 0);
+    }
+
+    /*
+    Lipat transformasi affine per output (y' = skala * y + geser) ke bobot dan bias:
+    bobot[o, :] *= skala[o], bias[o] = bias[o] * skala[o] + geser[o].
+    Dipakai buat lipat BatchNorm inferensi. Kalau layer nya belum pakai bias, bias nya di nyalakan.
+    */
+    void lipat_affine(const double* skala, const double* geser) {
+        DL_MEMORY_TAG("Dense::parameter");
+        if (!gunakan_bias) {
+            gunakan_bias = true;
+            bias = dl::zeros({out_features});
+            grad_bias = dl::zeros({out_features});
+        }
+        Tensor w = bobot;
+        Tensor b = bias;
+        for (dl::index_t o = 0; o < out_features; ++o) {
+            double* pw = w.row_ptr(o);
+            for (dl::index_t k = 0; k < in_features; ++k) {
+                pw[k] *= skala[o];
+            }
+            b[o] = b[o] * skala[o] + geser[o];
+        }
+        set_bobot(w);
+        set_bias(b);
+    }
+
     // Info layer //
-    int dapatkan_in_features() const { return in_features; }
-    int dapatkan_out_features() const { return out_features; }
+    dl::index_t dapatkan_in_features() const { return in_features; }
+    dl::index_t dapatkan_out_features() const { return out_features; }
     bool has_bias() const { return gunakan_bias; }
     
     // Jumlah parameter //
-    int num_parameters() const {
-        int params = in_features * out_features;
+    dl::index_t num_parameters() const {
+        dl::index_t params = in_features * out_features;
         if (gunakan_bias) {
             params += out_features;
         }
         return params;
     }
     
+    /*
+    Gradient accumulation: kalau nyala, backward (dense, half, sparse, dan autograd) nambah ke
+    grad_bobot / grad_bias yang sudah ada, jadi gradient beberapa micro-batch ke jumlah.
+    Yang reset nya cuma zero_grad, di panggil sekali di awal setiap langkah optimizer.
+    */
+    void atur_akumulasi_grad(bool nilai) { akumulasi_grad = nilai; }
+    bool akumulasi() const { return akumulasi_grad; }
+    
     // Zero gradients - panggil sebelum training batch baru //
+    // Buffer nya di nol-in di tempat; kalau gradient terakhir sparse cuma kolom aktif nya yang di sentuh //
     void zero_grad() {
-        grad_bobot = dl::zeros({out_features, in_features});
+        DL_MEMORY_TAG("Dense::gradien");
+        if (grad_bobot.numel() != out_features * in_features) {
+            grad_bobot = dl::zeros({out_features, in_features});
+        } else if (grad_sparse) {
+            for (dl::index_t o = 0; o < out_features; ++o) {
+                double* gw = grad_bobot.row_ptr(o);
+                for (dl::index_t k : kolom_aktif) {
+                    gw[k] = 0.0;
+                }
+            }
+        } else if (!grad_nol) {
+            std::fill(grad_bobot.begin(), grad_bobot.end(), 0.0);
+        }
         if (gunakan_bias) {
-            grad_bias = dl::zeros({out_features});
+            if (grad_bias.numel() != out_features) {
+                grad_bias = dl::zeros({out_features});
+            } else {
+                std::fill(grad_bias.begin(), grad_bias.end(), 0.0);
+            }
         }
+        grad_nol = true;
+        grad_sparse = false;
+        kolom_aktif.clear();
     }
 };
 
@@ -0,0 +1,551 @@
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include "Tensor.h"
+#include "NeuralNetwork.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+/*
+Data-parallel training multi-proses.
+
+Setiap proses (rank 0 .. world-1) pegang replika NeuralNetwork yang sama dan potongan data nya sendiri.
+Setelah backward, gradient semua rank di jumlah (all-reduce) pakai algoritma ring lewat TCP:
+    - rank r cuma konek ke rank r+1 (kirim) dan di konek rank r-1 (terima)
+    - reduce-scatter: world-1 langkah, setiap langkah kirim 1/world data ke tetangga dan jumlah yang di terima
+    - all-gather: world-1 langkah lagi, potongan yang sudah lengkap di edar kan ke semua rank
+Setiap rank kirim 2 * (world-1) / world * N elemen, gak tergantung jumlah rank (optimal bandwidth).
+Urutan penjumlahan tiap potongan sama di semua rank (hasil nya di copy di all-gather), jadi replika
+tetap sama persis bit per bit setelah langkah optimizer.
+
+Gradient di repo ini gradient dari sum(loss) (lihat gradient accumulation di NeuralNetwork.h),
+jadi jumlah gradient semua rank = gradient batch gabungan, gak perlu di bagi world.
+Training N rank dengan potongan data masing-masing sama dengan training satu proses di batch gabungan.
+
+Overlap: DataParallel pasang hook di NeuralNetwork. Begitu gradient sebuah layer final pas backward,
+gradient nya masuk bucket. Bucket yang sudah penuh (bytes_bucket) langsung di all-reduce thread
+komunikasi, sementara backward layer sebelum nya masih jalan. Optimizer baru melangkah setelah
+semua bucket selesai.
+
+Cara pakai (satu mesin, worker lewat localhost):
+    dl::distributed::luncurkan_lokal(4, [&](int rank) {
+        dl::distributed::GrupProses grup(rank, 4, 29500);
+        NeuralNetwork nn = ...;                      // Arsitektur sama di semua rank //
+        dl::distributed::DataParallel ddp(nn, grup); // Parameter rank 0 di broadcast ke semua //
+        Tensor Xr = dl::distributed::potong_rank(X, rank, 4);
+        Tensor yr = dl::distributed::potong_rank(y, rank, 4);
+        for (...) ddp.train_step(Xr, yr);
+        return 0;
+    });
+Atau tiap proses di jalan kan sendiri dengan env DL_RANK, DL_WORLD_SIZE, DL_PORT (dan DL_HOSTS
+"host0,host1,..." kalau beda mesin), lalu GrupProses::dari_env().
+
+Error jaringan (peer mati, timeout) itu fatal: pesan nya di tulis ke stderr lalu abort,
+karna rank lain gak mungkin lanjut tanpa rank yang hilang.
+*/
+
+namespace dl {
+namespace distributed {
+
+namespace detail {
+
+[[noreturn]] inline void gagal(const std::string& pesan) {
+    std::cerr << "[distributed] " << pesan;
+    if (errno != 0) std::cerr << ": " << std::strerror(errno);
+    std::cerr << std::endl;
+    std::abort();
+}
+
+inline void nonblok(int fd) {
+    const int flag = fcntl(fd, F_GETFL, 0);
+    if (flag < 0 || fcntl(fd, F_SETFL, flag | O_NONBLOCK) < 0) gagal("fcntl");
+}
+
+inline void atur_socket(int fd) {
+    int satu = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &satu, sizeof(satu));
+    int buffer = 4 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+}
+
+inline sockaddr_in alamat(const std::string& host, int port) {
+    sockaddr_in a;
+    std::memset(&a, 0, sizeof(a));
+    a.sin_family = AF_INET;
+    a.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &a.sin_addr) != 1) {
+        addrinfo hint;
+        std::memset(&hint, 0, sizeof(hint));
+        hint.ai_family = AF_INET;
+        addrinfo* hasil = nullptr;
+        if (getaddrinfo(host.c_str(), nullptr, &hint, &hasil) != 0 || !hasil) gagal("Host gak di kenal: " + host);
+        a.sin_addr = reinterpret_cast<sockaddr_in*>(hasil->ai_addr)->sin_addr;
+        freeaddrinfo(hasil);
+    }
+    return a;
+}
+
+inline long long sekarang_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Potong string "a,b,c" //
+inline std::vector<std::string> pisah_koma(const std::string& s) {
+    std::vector<std::string> out;
+    size_t mulai = 0;
+    while (mulai <= s.size()) {
+        size_t koma = s.find(',', mulai);
+        if (koma == std::string::npos) koma = s.size();
+        if (koma > mulai) out.push_back(s.substr(mulai, koma - mulai));
+        mulai = koma + 1;
+    }
+    return out;
+}
+
+} // namespace detail
+
+/*
+Grup proses dengan topologi ring.
+Rank r listen di port_dasar + r, konek ke rank r+1, dan terima koneksi dari rank r-1.
+Semua rank listen dulu baru konek (dengan retry), jadi urutan start proses nya bebas.
+*/
+class GrupProses {
+private:
+    int rank_saya;
+    int world;
+    int fd_berikut = -1;    // Kirim ke rank + 1 //
+    int fd_sebelum = -1;    // Terima dari rank - 1 //
+    int timeout_ms;
+    long long bytes_terkirim = 0;
+    Tensor::Storage terima_buf;
+
+public:
+    GrupProses(int rank, int world_size, int port_dasar, const std::vector<std::string>& hosts = {},
+               int timeout_ms_ = 60000)
+        : rank_saya(rank), world(world_size), timeout_ms(timeout_ms_) {
+        assert(world >= 1 && rank >= 0 && rank < world && "Rank harus di [0, world)");
+        assert(hosts.empty() || static_cast<int>(hosts.size()) == world);
+        if (world == 1) return;
+        auto host = [&hosts](int r) { return hosts.empty() ? std::string("127.0.0.1") : hosts[r]; };
+
+        // 1. Listen //
+        errno = 0;
+        int fd_listen = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd_listen < 0) detail::gagal("socket");
+        int satu = 1;
+        setsockopt(fd_listen, SOL_SOCKET, SO_REUSEADDR, &satu, sizeof(satu));
+        sockaddr_in a_saya = detail::alamat(hosts.empty() ? "127.0.0.1" : "0.0.0.0", port_dasar + rank);
+        if (bind(fd_listen, reinterpret_cast<sockaddr*>(&a_saya), sizeof(a_saya)) < 0) {
+            detail::gagal("bind port " + std::to_string(port_dasar + rank));
+        }
+        if (listen(fd_listen, 4) < 0) detail::gagal("listen");
+
+        // 2. Konek ke rank berikut nya, retry sampai rank itu listen //
+        const int berikut = (rank + 1) % world;
+        sockaddr_in a_berikut = detail::alamat(host(berikut), port_dasar + berikut);
+        const long long batas = detail::sekarang_ms() + timeout_ms;
+        while (true) {
+            fd_berikut = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd_berikut < 0) detail::gagal("socket");
+            if (connect(fd_berikut, reinterpret_cast<sockaddr*>(&a_berikut), sizeof(a_berikut)) == 0) break;
+            close(fd_berikut);
+            if (detail::sekarang_ms() > batas) detail::gagal("Gagal konek ke rank " + std::to_string(berikut));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // 3. Terima koneksi dari rank sebelum nya //
+        pollfd pf{fd_listen, POLLIN, 0};
+        if (poll(&pf, 1, timeout_ms) <= 0) detail::gagal("Rank sebelum nya gak konek");
+        fd_sebelum = accept(fd_listen, nullptr, nullptr);
+        if (fd_sebelum < 0) detail::gagal("accept");
+        close(fd_listen);
+
+        detail::atur_socket(fd_berikut);
+        detail::atur_socket(fd_sebelum);
+        detail::nonblok(fd_berikut);
+        detail::nonblok(fd_sebelum);
+
+        // 4. Jabat tangan: pastikan yang konek memang rank sebelum nya //
+        int32_t kirim = rank, terima = -1;
+        kirim_terima(&kirim, sizeof(kirim), &terima, sizeof(terima));
+        if (terima != (rank + world - 1) % world) {
+            errno = 0;
+            detail::gagal("Rank tetangga salah, dapat " + std::to_string(terima));
+        }
+        bytes_terkirim = 0;
+    }
+
+    // Dari env DL_RANK, DL_WORLD_SIZE, DL_PORT (bawaan 29500), DL_HOSTS (opsional) //
+    static GrupProses dari_env() {
+        const char* r = std::getenv("DL_RANK");
+        const char* w = std::getenv("DL_WORLD_SIZE");
+        const char* p = std::getenv("DL_PORT");
+        const char* h = std::getenv("DL_HOSTS");
+        assert(r && w && "DL_RANK dan DL_WORLD_SIZE harus di set");
+        return GrupProses(std::atoi(r), std::atoi(w), p ? std::atoi(p) : 29500,
+                          h ? detail::pisah_koma(h) : std::vector<std::string>());
+    }
+
+    GrupProses(GrupProses&& o) noexcept
+        : rank_saya(o.rank_saya), world(o.world), fd_berikut(o.fd_berikut), fd_sebelum(o.fd_sebelum),
+          timeout_ms(o.timeout_ms), bytes_terkirim(o.bytes_terkirim) {
+        o.fd_berikut = -1;
+        o.fd_sebelum = -1;
+    }
+    GrupProses(const GrupProses&) = delete;
+    GrupProses& operator=(const GrupProses&) = delete;
+    GrupProses& operator=(GrupProses&&) = delete;
+
+    ~GrupProses() {
+        if (fd_berikut >= 0) close(fd_berikut);
+        if (fd_sebelum >= 0) close(fd_sebelum);
+    }
+
+    int rank() const { return rank_saya; }
+    int world_size() const { return world; }
+    long long bytes_dikirim() const { return bytes_terkirim; }
+
+    /*
+    Kirim nk byte ke rank berikut sambil terima nt byte dari rank sebelum nya.
+    Dua-dua nya harus jalan bareng: kalau semua rank kirim dulu baru terima,
+    buffer socket nya penuh dan semua nya nunggu satu sama lain (deadlock).
+    */
+    void kirim_terima(const void* kirim, size_t nk, void* terima, size_t nt) {
+        const char* pk = static_cast<const char*>(kirim);
+        char* pt = static_cast<char*>(terima);
+        size_t sk = 0, st = 0;
+        while (sk < nk || st < nt) {
+            pollfd pf[2];
+            int n = 0, ik = -1, it = -1;
+            if (sk < nk) { pf[n] = pollfd{fd_berikut, POLLOUT, 0}; ik = n++; }
+            if (st < nt) { pf[n] = pollfd{fd_sebelum, POLLIN, 0}; it = n++; }
+            errno = 0;
+            const int r = poll(pf, n, timeout_ms);
+            if (r == 0) detail::gagal("Timeout nunggu rank tetangga");
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                detail::gagal("poll");
+            }
+            if (ik >= 0 && pf[ik].revents) {
+                const ssize_t w = send(fd_berikut, pk + sk, nk - sk, MSG_NOSIGNAL);
+                if (w > 0) {
+                    sk += static_cast<size_t>(w);
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    detail::gagal("send ke rank " + std::to_string((rank_saya + 1) % world));
+                }
+            }
+            if (it >= 0 && pf[it].revents) {
+                const ssize_t g = recv(fd_sebelum, pt + st, nt - st, 0);
+                if (g > 0) {
+                    st += static_cast<size_t>(g);
+                } else if (g == 0) {
+                    errno = 0;
+                    detail::gagal("Rank " + std::to_string((rank_saya + world - 1) % world) + " menutup koneksi");
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    detail::gagal("recv");
+                }
+            }
+        }
+        bytes_terkirim += static_cast<long long>(nk);
+    }
+
+    /*
+    All-reduce sum ring, hasil nya di tulis balik ke data di semua rank.
+    Potongan c = [c * n / world, (c + 1) * n / world).
+    */
+    void all_reduce(double* data, dl::index_t n) {
+        if (world == 1 || n == 0) return;
+        DL_PROFILE("distributed::all_reduce", static_cast<uint64_t>(n));
+        auto awal = [this, n](int c) { return static_cast<dl::index_t>(static_cast<long long>(n) * c / world); };
+        auto bytes = [&awal](int c) { return static_cast<size_t>(awal(c + 1) - awal(c)) * sizeof(double); };
+        const int r = rank_saya;
+
+        {
+            DL_MEMORY_TAG("distributed::buffer");
+            if (static_cast<dl::index_t>(terima_buf.size()) < n / world + 1) terima_buf.resize(n / world + 1);
+        }
+
+        // Reduce-scatter: setelah world-1 langkah, rank r pegang jumlah lengkap potongan (r + 1) % world //
+        for (int s = 0; s < world - 1; ++s) {
+            const int c_kirim = (r - s + world) % world;
+            const int c_terima = (r - s - 1 + 2 * world) % world;
+            kirim_terima(data + awal(c_kirim), bytes(c_kirim), terima_buf.data(), bytes(c_terima));
+            double* tujuan = data + awal(c_terima);
+            const dl::index_t m = awal(c_terima + 1) - awal(c_terima);
+            for (dl::index_t i = 0; i < m; ++i) tujuan[i] = terima_buf[i] + tujuan[i];
+        }
+        // All-gather: potongan yang sudah lengkap di edar kan keliling ring //
+        for (int s = 0; s < world - 1; ++s) {
+            const int c_kirim = (r + 1 - s + world) % world;
+            const int c_terima = (r - s + world) % world;
+            kirim_terima(data + awal(c_kirim), bytes(c_kirim), data + awal(c_terima), bytes(c_terima));
+        }
+    }
+
+    // Broadcast dari root, di terus kan keliling ring per blok biar pipelined //
+    void broadcast(double* data, dl::index_t n, int root = 0) {
+        if (world == 1 || n == 0) return;
+        const dl::index_t BLOK = 8192;
+        const bool kirim = (rank_saya + 1) % world != root;
+        for (dl::index_t i = 0; i < n; i += BLOK) {
+            const size_t b = static_cast<size_t>(std::min(BLOK, n - i)) * sizeof(double);
+            if (rank_saya != root) kirim_terima(nullptr, 0, data + i, b);
+            if (kirim) kirim_terima(data + i, b, nullptr, 0);
+        }
+    }
+
+    // Semua rank nunggu sampai semua rank sampai di sini //
+    // Pakai all_reduce world elemen, jadi setiap langkah ring nya memang kirim data (bukan 0 byte) //
+    void barrier() {
+        std::vector<double> x(static_cast<size_t>(world), 0.0);
+        all_reduce(x.data(), world);
+    }
+};
+
+// Baris bagian rank dari Tensor [N, ...]: [rank * N / world, (rank + 1) * N / world) //
+inline Tensor potong_rank(const Tensor& t, int rank, int world) {
+    Shape shape = t.get_shape();
+    const dl::index_t n = shape[0];
+    const dl::index_t per_baris = t.numel() / n;
+    const dl::index_t awal = static_cast<dl::index_t>(static_cast<long long>(n) * rank / world);
+    const dl::index_t akhir = static_cast<dl::index_t>(static_cast<long long>(n) * (rank + 1) / world);
+    shape[0] = akhir - awal;
+    Tensor hasil(shape);
+    std::copy(t.data_ptr() + awal * per_baris, t.data_ptr() + akhir * per_baris, hasil.data_ptr());
+    return hasil;
+}
+
+struct StatistikDDP {
+    long long langkah = 0;
+    long long bucket = 0;                 // Bucket yang sudah di all-reduce //
+    long long elemen = 0;                 // Elemen gradient yang di all-reduce //
+    double waktu_komunikasi_ms = 0.0;     // Total waktu all-reduce di thread komunikasi //
+    double waktu_tunggu_ms = 0.0;         // Waktu thread training nunggu komunikasi (gak ke overlap) //
+};
+
+/*
+Data-parallel di atas NeuralNetwork.
+Di constructor, parameter rank 0 di broadcast ke semua rank, jadi replika nya mulai sama persis.
+Setelah itu setiap train_step: forward / backward di potongan data rank ini, gradient nya
+di all-reduce per bucket sambil backward jalan, lalu semua rank melangkah dengan gradient yang sama.
+Gradient accumulation (atur_akumulasi_gradient) tetap jalan: all-reduce nya cuma di micro-batch terakhir.
+*/
+class DataParallel {
+private:
+    struct Bucket {
+        std::vector<std::pair<double*, dl::index_t>> buffer;
+        dl::index_t elemen = 0;
+        Tensor::Storage datar;
+    };
+
+    NeuralNetwork& nn;
+    GrupProses& grup;
+    dl::index_t elemen_bucket;
+
+    Bucket terbuka;
+    std::deque<Bucket> antrian;
+    std::vector<Tensor::Storage> bekas;    // Buffer datar yang di pakai ulang //
+    std::mutex mtx;
+    std::condition_variable cv_kerja;
+    std::condition_variable cv_selesai;
+    bool sibuk = false;
+    bool berhenti = false;
+    std::thread pekerja;
+
+    StatistikDDP statistik;
+    double loss_terakhir = 0.0;
+    double loss_lokal = 0.0;
+    double baris_lokal = 0.0;
+
+    void jalan() {
+        while (true) {
+            Bucket b;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_kerja.wait(lock, [this] { return berhenti || !antrian.empty(); });
+                if (antrian.empty()) return;
+                b = std::move(antrian.front());
+                antrian.pop_front();
+                sibuk = true;
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            {
+                DL_MEMORY_TAG("distributed::bucket");
+                b.datar.resize(static_cast<size_t>(b.elemen));
+            }
+            dl::index_t pos = 0;
+            for (const auto& p : b.buffer) {
+                std::copy(p.first, p.first + p.second, b.datar.data() + pos);
+                pos += p.second;
+            }
+            grup.all_reduce(b.datar.data(), b.elemen);
+            pos = 0;
+            for (const auto& p : b.buffer) {
+                std::copy(b.datar.data() + pos, b.datar.data() + pos + p.second, p.first);
+                pos += p.second;
+            }
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                statistik.bucket++;
+                statistik.elemen += b.elemen;
+                statistik.waktu_komunikasi_ms += ms;
+                bekas.push_back(std::move(b.datar));
+                sibuk = false;
+            }
+            cv_selesai.notify_all();
+        }
+    }
+
+    void kirim_bucket() {
+        if (terbuka.elemen == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!bekas.empty()) {
+                terbuka.datar = std::move(bekas.back());
+                bekas.pop_back();
+            }
+            antrian.push_back(std::move(terbuka));
+        }
+        terbuka = Bucket();
+        cv_kerja.notify_one();
+    }
+
+    // Hook: gradient layer i final, masuk bucket, bucket penuh langsung di kirim //
+    void gradient_siap(size_t i) {
+        for (const auto& p : nn.gradient_layer(i)) {
+            terbuka.buffer.push_back(p);
+            terbuka.elemen += p.second;
+            if (terbuka.elemen >= elemen_bucket) kirim_bucket();
+        }
+    }
+
+    // Hook: sisa bucket di kirim, tunggu semua all-reduce selesai sebelum optimizer melangkah //
+    void sebelum_optimizer() {
+        kirim_bucket();
+        const auto t0 = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_selesai.wait(lock, [this] { return antrian.empty() && !sibuk; });
+        statistik.waktu_tunggu_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        statistik.langkah++;
+    }
+
+public:
+    // bytes_bucket: ukuran bucket all-reduce, 0 artinya satu bucket di akhir backward (tanpa overlap) //
+    DataParallel(NeuralNetwork& model, GrupProses& g, size_t bytes_bucket = 256 * 1024)
+        : nn(model), grup(g),
+          elemen_bucket(bytes_bucket == 0 ? std::numeric_limits<dl::index_t>::max()
+                                          : static_cast<dl::index_t>(std::max<size_t>(1, bytes_bucket / sizeof(double)))) {
+        // Samakan parameter semua replika dengan rank 0, state lain (optimizer, random) tetap punya rank sendiri //
+        dl::snapshot::StateTraining s = nn.ambil_state();
+        grup.broadcast(s.parameter.data(), static_cast<dl::index_t>(s.parameter.size()), 0);
+        nn.pulihkan_state(s);
+
+        pekerja = std::thread([this] { jalan(); });
+        nn.atur_hook_gradient([this](size_t i) { gradient_siap(i); }, [this] { sebelum_optimizer(); });
+    }
+
+    ~DataParallel() {
+        nn.atur_hook_gradient(nullptr, nullptr);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            berhenti = true;
+        }
+        cv_kerja.notify_all();
+        pekerja.join();
+    }
+
+    DataParallel(const DataParallel&) = delete;
+    DataParallel& operator=(const DataParallel&) = delete;
+
+    /*
+    Satu train_step di potongan data rank ini.
+    Return loss rata-rata global (semua rank) setiap optimizer melangkah,
+    di micro-batch yang belum melangkah return loss lokal micro-batch nya.
+    */
+    template <typename Input>
+    double train_step(const Input& input, const Tensor& target) {
+        const double loss = nn.train_step(input, target);
+        const double baris = static_cast<double>(target.get_shape()[0]);
+        loss_lokal += loss * baris;
+        baris_lokal += baris;
+        if (nn.micro_batch_terkumpul() != 0) return loss;
+
+        // Thread komunikasi sudah idle (sebelum_optimizer nunggu), grup nya aman di pakai di sini //
+        double buf[2] = {loss_lokal, baris_lokal};
+        grup.all_reduce(buf, 2);
+        loss_lokal = 0.0;
+        baris_lokal = 0.0;
+        loss_terakhir = buf[0] / buf[1];
+        return loss_terakhir;
+    }
+
+    // Loss global langkah optimizer terakhir //
+    double loss_global() const { return loss_terakhir; }
+
+    StatistikDDP dapatkan_statistik() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return statistik;
+    }
+
+    NeuralNetwork& model() { return nn; }
+};
+
+/*
+Jalan kan fungsi(rank) di world proses di mesin ini (rank 0 di proses pemanggil, sisa nya fork).
+Panggil sebelum ada thread lain (thread pool parallel_for, snapshot, dll), karna fork cuma
+nyalin thread pemanggil. Return true kalau semua rank return 0.
+*/
+inline bool luncurkan_lokal(int world, const std::function<int(int)>& fungsi) {
+    std::cout.flush();
+    std::vector<pid_t> anak;
+    for (int r = 1; r < world; ++r) {
+        const pid_t pid = fork();
+        if (pid < 0) detail::gagal("fork");
+        if (pid == 0) {
+            const int kode = fungsi(r);
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(kode);
+        }
+        anak.push_back(pid);
+    }
+    bool sukses = fungsi(0) == 0;
+    for (pid_t pid : anak) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        sukses = sukses && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return sukses;
+}
+
+} // namespace distributed
+} // namespace dl
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef DROPOUT_H
+#define DROPOUT_H
+
+#include "Tensor.h"
+#include "Random.h"
+#include "Parallel.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/*
+Dropout: pas training, setiap elemen di buang (jadi 0) dengan peluang p,
+yang tersisa di skala 1 / (1 - p) biar nilai harapan nya tetap sama (inverted dropout).
+Pas inferensi, dropout gak ngapa-ngapain.
+
+Mask nya di simpan 1 bit per elemen (uint64_t isi 64 elemen),
+bukan Tensor double yang isi nya 0 / 1. Jadi cache nya 64x lebih kecil.
+
+Mask nya di bikin pakai Philox (Random.h) langsung di dalam loop yang sama dengan skala nya:
+setiap word 64 elemen butuh 16 blok Philox (4 x 32 bit per blok, satu angka 32 bit per elemen),
+elemen di simpan kalau angka nya >= p * 2^32.
+Elemen ke-i pakai blok counter + i / 4, jadi isi nya sama persis berapa pun jumlah thread nya,
+dan bisa di bikin ulang dari counter yang sama (gradient checkpointing pakai mask yang sama).
+
+Backward nya juga satu loop: grad_input = bit ? grad * skala : 0.
+*/
+
+class Dropout {
+public:
+    using Mask = std::vector<uint64_t, dl::memori::TrackingAllocator<uint64_t>>;
+
+private:
+    double p;
+    double skala;
+    uint32_t ambang;   // Elemen di buang kalau angka random 32 bit nya < ambang //
+
+    Mask mask;
+    dl::index_t n = 0;
+
+    static constexpr dl::index_t BLOK_PER_WORD = 16;
+    static constexpr dl::index_t GRAIN_WORD = 512;
+
+    // Bikin mask word w (64 elemen) dari 16 blok Philox //
+    uint64_t bikin_word(uint64_t counter, uint64_t key) const {
+        uint32_t out[4][dl::random::detail::LANE];
+        uint64_t word = 0;
+        for (int h = 0; h < 2; ++h) {
+            dl::random::detail::philox_batch(counter + static_cast<uint64_t>(h * dl::random::detail::LANE), key, out);
+            for (int l = 0; l < dl::random::detail::LANE; ++l) {
+                for (int c = 0; c < 4; ++c) {
+                    const int e = (h * dl::random::detail::LANE + l) * 4 + c;
+                    word |= static_cast<uint64_t>(out[c][l] >= ambang) << e;
+                }
+            }
+        }
+        return word;
+    }
+
+    // y[i] = bit i ? x[i] * skala : 0, buat word w //
+    void terapkan_word(const double* x, double* y, uint64_t word, dl::index_t jumlah) const {
+        for (dl::index_t e = 0; e < jumlah; ++e) {
+            y[e] = ((word >> e) & 1u) ? x[e] * skala : 0.0;
+        }
+    }
+
+public:
+    explicit Dropout(double p_ = 0.5) : p(p_) {
+        assert(p >= 0.0 && p < 1.0 && "Peluang dropout harus di [0, 1)");
+        skala = 1.0 / (1.0 - p);
+        ambang = static_cast<uint32_t>(std::min(p * 4294967296.0, 4294967295.0));
+    }
+
+    /*
+    Forward training: mask baru dari generator global, di bikin dan di terapkan dalam satu jalan.
+    */
+    Tensor forward(const Tensor& x) {
+        DL_MEMORY_TAG("Dropout::mask");
+        DL_PROFILE("Dropout::forward", x.numel());
+        n = x.numel();
+        const dl::index_t n_word = (n + 63) / 64;
+        mask.assign(n_word, 0);
+
+        auto& gen = dl::random::generator();
+        const uint64_t key = gen.dapatkan_seed();
+        const uint64_t counter = gen.ambil(static_cast<uint64_t>(n_word * BLOK_PER_WORD));
+
+        Tensor y(x.get_shape());
+        const double* px = x.data_ptr();
+        double* py = y.data_ptr();
+        uint64_t* pm = mask.data();
+        dl::parallel_for(0, n_word, GRAIN_WORD, [&](dl::index_t w0, dl::index_t w1) {
+            for (dl::index_t w = w0; w < w1; ++w) {
+                const uint64_t word = bikin_word(counter + static_cast<uint64_t>(w * BLOK_PER_WORD), key);
+                pm[w] = word;
+                const dl::index_t i = w * 64;
+                terapkan_word(px + i, py + i, word, std::min<dl::index_t>(64, n - i));
+            }
+        });
+        return y;
+    }
+
+    // Forward pakai mask forward terakhir (buat hitung ulang gradient checkpointing) //
+    Tensor forward_ulang(const Tensor& x) const {
+        DL_MEMORY_TAG("Dropout::mask");
+        assert(x.numel() == n && "Ukuran input beda dengan mask forward terakhir");
+        Tensor y(x.get_shape());
+        const double* px = x.data_ptr();
+        double* py = y.data_ptr();
+        for (dl::index_t w = 0; w * 64 < n; ++w) {
+            const dl::index_t i = w * 64;
+            terapkan_word(px + i, py + i, mask[w], std::min<dl::index_t>(64, n - i));
+        }
+        return y;
+    }
+
+    // Backward: grad_input = bit ? grad * skala : 0 //
+    Tensor backward(const Tensor& grad) const {
+        DL_MEMORY_TAG("Dropout::backward");
+        DL_PROFILE("Dropout::backward", grad.numel());
+        assert(grad.numel() == n && "Ukuran gradient beda dengan mask forward terakhir");
+        Tensor gx(grad.get_shape());
+        const double* pg = grad.data_ptr();
+        double* px = gx.data_ptr();
+        const uint64_t* pm = mask.data();
+        dl::parallel_for(0, (n + 63) / 64, GRAIN_WORD, [&](dl::index_t w0, dl::index_t w1) {
+            for (dl::index_t w = w0; w < w1; ++w) {
+                const dl::index_t i = w * 64;
+                terapkan_word(pg + i, px + i, pm[w], std::min<dl::index_t>(64, n - i));
+            }
+        });
+        return gx;
+    }
+
+    // Bit mask elemen i (1 = di simpan) //
+    bool di_simpan(dl::index_t i) const {
+        return (mask[i / 64] >> (i % 64)) & 1u;
+    }
+
+    double dapatkan_p() const { return p; }
+    const Mask& dapatkan_mask() const { return mask; }
+
+    // Ukuran cache mask dalam bytes //
+    long long bytes_cache() const {
+        return static_cast<long long>(mask.size()) * sizeof(uint64_t);
+    }
+
+    void lepas_mask() {
+        Mask().swap(mask);
+        n = 0;
+    }
+};
+
+#endif
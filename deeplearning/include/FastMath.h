@@ -0,0 +1,394 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include "Tensor.h"
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DL_FASTMATH_X86 1
+#endif
+
+/*
+exp, log, dan sigmoid versi cepat buat array double.
+std::exp / std::log itu panggilan libm satu-satu (scalar), jadi layer Sigmoid
+ke-limit sama libm, bukan sama bandwidth memori.
+
+Di sini pakai pendekatan polinomial, 4 double sekaligus pakai AVX2 + FMA kalau CPU nya ada,
+sisanya (atau CPU lain) pakai versi scalar dengan rumus yang sama.
+
+exp(x):
+    x = n * ln2 + r, |r| <= ln2 / 2   (ln2 di pecah hi + lo biar r nya akurat, Cody-Waite)
+    exp(r) = deret Taylor sampai r^13, sisa nya < 1e-17 relatif
+    exp(x) = exp(r) * 2^(n/2) * 2^(n - n/2)   (di kali dua kali biar hasil subnormal dan inf tetap benar)
+    Error maksimum (di ukur 4 juta titik di [-745, 710] vs long double): < 1 ULP buat hasil normal.
+    Hasil subnormal (x < -708.4) error absolut nya <= 1 subnormal terkecil (4.9e-324).
+
+log(x):
+    x = 2^k * m, m di [sqrt(1/2), sqrt(2)), f = m - 1, s = f / (2 + f)
+    log(m) = polinomial minimax derajat 14 di s (koefisien fdlibm)
+    log(x) = k * ln2 + log(m)
+    Error maksimum: < 1 ULP di seluruh range double positif (termasuk subnormal).
+
+sigmoid(x) = 1 / (1 + exp(-x)) pakai exp di atas, error maksimum 2.5 ULP relatif,
+atau 1.7e-16 absolut.
+
+Kasus khusus sama kek libm: exp(NaN) = NaN, exp(-inf) = 0, exp(inf) = inf,
+log(0) = -inf, log(negatif) = NaN, log(inf) = inf.
+
+Mode nya global, di cek semua aktivasi dan loss:
+    dl::fastmath::atur_mode(dl::fastmath::ModeMath::CEPAT);
+PRESISI (bawaan) tetap pakai std::exp / std::log, jadi hasil lama nya sama persis.
+*/
+
+namespace dl {
+namespace fastmath {
+
+enum class ModeMath {
+    PRESISI,  // std::exp / std::log (libm) //
+    CEPAT     // Polinomial di bawah, error maks 1 ULP (sigmoid 2.5 ULP) //
+};
+
+namespace detail {
+
+inline std::atomic<ModeMath>& mode_aktif() {
+    static std::atomic<ModeMath> mode{ModeMath::PRESISI};
+    return mode;
+}
+
+// Konstanta exp //
+constexpr double LOG2E = 1.4426950408889634;
+constexpr double LN2_HI = 6.93147180369123816490e-01;  // 32 bit atas ln2, n * LN2_HI exact //
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double MAGIC = 6755399441055744.0;            // 1.5 * 2^52, buat pembulatan ke integer //
+constexpr double EXP_MIN = -746.0;                      // exp(x) < 2^-1075 di bawah ini, jadi 0 //
+constexpr double EXP_MAX = 710.0;                       // exp(x) > DBL_MAX di atas ini, jadi inf //
+
+// Koefisien Taylor 1/k!, k = 2..13 //
+constexpr double E2 = 1.0 / 2.0;
+constexpr double E3 = 1.0 / 6.0;
+constexpr double E4 = 1.0 / 24.0;
+constexpr double E5 = 1.0 / 120.0;
+constexpr double E6 = 1.0 / 720.0;
+constexpr double E7 = 1.0 / 5040.0;
+constexpr double E8 = 1.0 / 40320.0;
+constexpr double E9 = 1.0 / 362880.0;
+constexpr double E10 = 1.0 / 3628800.0;
+constexpr double E11 = 1.0 / 39916800.0;
+constexpr double E12 = 1.0 / 479001600.0;
+constexpr double E13 = 1.0 / 6227020800.0;
+
+// Koefisien log(1+f) dari fdlibm (e_log.c) //
+constexpr double LG1 = 6.666666666666735130e-01;
+constexpr double LG2 = 3.999999999940941908e-01;
+constexpr double LG3 = 2.857142874366239149e-01;
+constexpr double LG4 = 2.222219843214978396e-01;
+constexpr double LG5 = 1.818357216161805012e-01;
+constexpr double LG6 = 1.531383769920937332e-01;
+constexpr double LG7 = 1.479819860511658591e-01;
+constexpr double SQRT2 = 1.41421356237309504880;
+
+inline uint64_t bits(double d) { uint64_t u; std::memcpy(&u, &d, 8); return u; }
+inline double dari_bits(uint64_t u) { double d; std::memcpy(&d, &u, 8); return d; }
+
+// 2^n, n di [-1022, 1023] //
+inline double pangkat2(int64_t n) {
+    return dari_bits(static_cast<uint64_t>(n + 1023) << 52);
+}
+
+} // namespace detail //
+
+// SCALAR //
+
+inline double exp_cepat(double x) {
+    using namespace detail;
+    if (x != x) return x;
+    x = (x < EXP_MIN) ? EXP_MIN : x;
+    x = (x > EXP_MAX) ? EXP_MAX : x;
+
+    const double nd = (x * LOG2E + MAGIC) - MAGIC;
+    double r = x - nd * LN2_HI;
+    r = r - nd * LN2_LO;
+
+    double p = E13;
+    p = p * r + E12;
+    p = p * r + E11;
+    p = p * r + E10;
+    p = p * r + E9;
+    p = p * r + E8;
+    p = p * r + E7;
+    p = p * r + E6;
+    p = p * r + E5;
+    p = p * r + E4;
+    p = p * r + E3;
+    p = p * r + E2;
+    p = p * r * r + r + 1.0;
+
+    const int64_t n = static_cast<int64_t>(nd);
+    const int64_t n1 = n >> 1;
+    return p * pangkat2(n1) * pangkat2(n - n1);
+}
+
+inline double log_cepat(double x) {
+    using namespace detail;
+    if (!(x > 0.0) || x == std::numeric_limits<double>::infinity()) {
+        if (x == 0.0) return -std::numeric_limits<double>::infinity();
+        if (x < 0.0) return std::numeric_limits<double>::quiet_NaN();
+        return x;  // NaN atau inf //
+    }
+
+    int64_t k = 0;
+    if (x < std::numeric_limits<double>::min()) {
+        x *= 18014398509481984.0;  // 2^54, subnormal jadi normal //
+        k = -54;
+    }
+    const uint64_t u = bits(x);
+    k += static_cast<int64_t>(u >> 52) - 1023;
+    double m = dari_bits((u & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+    if (m > SQRT2) {
+        m *= 0.5;
+        ++k;
+    }
+
+    const double f = m - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double w = z * z;
+    const double t1 = w * (LG2 + w * (LG4 + w * LG6));
+    const double t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+    const double R = t2 + t1;
+    const double hfsq = 0.5 * f * f;
+    const double kd = static_cast<double>(k);
+    return kd * LN2_HI - ((hfsq - (s * (hfsq + R) + kd * LN2_LO)) - f);
+}
+
+inline double sigmoid_cepat(double x) {
+    return 1.0 / (1.0 + exp_cepat(-x));
+}
+
+// KERNEL AVX2 + FMA //
+
+namespace detail {
+
+inline bool cpu_avx2_fma() {
+#ifdef DL_FASTMATH_X86
+    static const bool ada = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return ada;
+#else
+    return false;
+#endif
+}
+
+#ifdef DL_FASTMATH_X86
+__attribute__((target("avx2,fma")))
+inline __m256d exp_avx2(__m256d x) {
+    // max/min dengan x di operand kedua, jadi NaN nya lolos //
+    x = _mm256_max_pd(_mm256_set1_pd(EXP_MIN), x);
+    x = _mm256_min_pd(_mm256_set1_pd(EXP_MAX), x);
+
+    const __m256d nd = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(LOG2E)),
+                                       _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(nd, _mm256_set1_pd(LN2_HI), x);
+    r = _mm256_fnmadd_pd(nd, _mm256_set1_pd(LN2_LO), r);
+
+    __m256d p = _mm256_set1_pd(E13);
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E12));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E11));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E10));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E9));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E8));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E7));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E6));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E5));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E4));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E3));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(E2));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+
+    // 2^n1 * 2^n2, n1 = n >> 1, n2 = n - n1 //
+    const __m128i n = _mm256_cvtpd_epi32(nd);
+    const __m128i n1 = _mm_srai_epi32(n, 1);
+    const __m128i n2 = _mm_sub_epi32(n, n1);
+    const __m256i bias = _mm256_set1_epi64x(1023);
+    const __m256d s1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(n1), bias), 52));
+    const __m256d s2 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(n2), bias), 52));
+    return _mm256_mul_pd(_mm256_mul_pd(p, s1), s2);
+}
+
+__attribute__((target("avx2,fma")))
+inline __m256d log_avx2(__m256d x) {
+    const __m256d nol = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+
+    // Subnormal di skala 2^54 dulu //
+    const __m256d sub = _mm256_cmp_pd(x, _mm256_set1_pd(std::numeric_limits<double>::min()), _CMP_LT_OQ);
+    __m256d xs = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(18014398509481984.0)), sub);
+    __m256d k0 = _mm256_and_pd(sub, _mm256_set1_pd(-54.0));
+
+    const __m256i u = _mm256_castpd_si256(xs);
+    // Eksponen (11 bit) jadi double lewat trik MAGIC: bits(MAGIC) + e - MAGIC = e //
+    const __m256i e = _mm256_srli_epi64(u, 52);
+    __m256d k = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(e, _mm256_castpd_si256(_mm256_set1_pd(MAGIC)))),
+                              _mm256_set1_pd(MAGIC + 1023.0));
+    k = _mm256_add_pd(k, k0);
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(u, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll)),
+        _mm256_set1_epi64x(0x3FF0000000000000ll)));
+    const __m256d besar = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), besar);
+    k = _mm256_add_pd(k, _mm256_and_pd(besar, _mm256_set1_pd(1.0)));
+
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    const __m256d z = _mm256_mul_pd(s, s);
+    const __m256d w = _mm256_mul_pd(z, z);
+    __m256d t1 = _mm256_fmadd_pd(w, _mm256_set1_pd(LG6), _mm256_set1_pd(LG4));
+    t1 = _mm256_fmadd_pd(w, t1, _mm256_set1_pd(LG2));
+    t1 = _mm256_mul_pd(w, t1);
+    __m256d t2 = _mm256_fmadd_pd(w, _mm256_set1_pd(LG7), _mm256_set1_pd(LG5));
+    t2 = _mm256_fmadd_pd(w, t2, _mm256_set1_pd(LG3));
+    t2 = _mm256_fmadd_pd(w, t2, _mm256_set1_pd(LG1));
+    t2 = _mm256_mul_pd(z, t2);
+    const __m256d R = _mm256_add_pd(t2, t1);
+    const __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), f), f);
+    // k * LN2_HI - ((hfsq - (s * (hfsq + R) + k * LN2_LO)) - f) //
+    __m256d dalam = _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, R), _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO)));
+    dalam = _mm256_sub_pd(_mm256_sub_pd(hfsq, dalam), f);
+    __m256d hasil = _mm256_fmsub_pd(k, _mm256_set1_pd(LN2_HI), dalam);
+
+    // Kasus khusus: 0 -> -inf, negatif -> NaN, inf -> inf, NaN -> NaN //
+    hasil = _mm256_blendv_pd(hasil, x, _mm256_cmp_pd(x, inf, _CMP_EQ_OQ));
+    hasil = _mm256_blendv_pd(hasil, _mm256_set1_pd(-std::numeric_limits<double>::infinity()),
+                             _mm256_cmp_pd(x, nol, _CMP_EQ_OQ));
+    hasil = _mm256_blendv_pd(hasil, _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN()),
+                             _mm256_cmp_pd(x, nol, _CMP_LT_OQ));
+    hasil = _mm256_blendv_pd(hasil, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+    return hasil;
+}
+
+__attribute__((target("avx2,fma")))
+inline dl::index_t exp_array_avx2(const double* x, double* y, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(y + i, exp_avx2(_mm256_loadu_pd(x + i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2,fma")))
+inline dl::index_t log_array_avx2(const double* x, double* y, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(y + i, log_avx2(_mm256_loadu_pd(x + i)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2,fma")))
+inline dl::index_t sigmoid_array_avx2(const double* x, double* y, dl::index_t n) {
+    const __m256d satu = _mm256_set1_pd(1.0);
+    const __m256d tanda = _mm256_set1_pd(-0.0);
+    dl::index_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d e = exp_avx2(_mm256_xor_pd(_mm256_loadu_pd(x + i), tanda));
+        _mm256_storeu_pd(y + i, _mm256_div_pd(satu, _mm256_add_pd(satu, e)));
+    }
+    return i;
+}
+#endif
+
+} // namespace detail //
+
+// MODE //
+
+inline void atur_mode(ModeMath mode) {
+    detail::mode_aktif().store(mode, std::memory_order_relaxed);
+}
+
+inline ModeMath mode() {
+    return detail::mode_aktif().load(std::memory_order_relaxed);
+}
+
+inline const char* nama_mode(ModeMath m) {
+    return m == ModeMath::CEPAT ? "cepat" : "presisi";
+}
+
+// Ganti mode sementara selama objek ini hidup //
+class PakaiMode {
+private:
+    ModeMath sebelumnya;
+
+public:
+    explicit PakaiMode(ModeMath m) : sebelumnya(mode()) { atur_mode(m); }
+    ~PakaiMode() { atur_mode(sebelumnya); }
+
+    PakaiMode(const PakaiMode&) = delete;
+    PakaiMode& operator=(const PakaiMode&) = delete;
+};
+
+// Nama jalur yang di pakai mode CEPAT //
+inline const char* jalur() {
+    return detail::cpu_avx2_fma() ? "AVX2+FMA" : "scalar";
+}
+
+// SCALAR IKUT MODE, buat loop yang gak bisa di jadikan array (loss per elemen) //
+
+inline double exp(double x) {
+    return mode() == ModeMath::CEPAT ? exp_cepat(x) : std::exp(x);
+}
+
+inline double log(double x) {
+    return mode() == ModeMath::CEPAT ? log_cepat(x) : std::log(x);
+}
+
+inline double sigmoid(double x) {
+    return mode() == ModeMath::CEPAT ? sigmoid_cepat(x) : 1.0 / (1.0 + std::exp(-x));
+}
+
+// ARRAY IKUT MODE, y boleh sama dengan x (in-place) //
+
+inline void exp(const double* x, double* y, dl::index_t n) {
+    dl::index_t i = 0;
+    if (mode() == ModeMath::PRESISI) {
+        for (; i < n; ++i) y[i] = std::exp(x[i]);
+        return;
+    }
+#ifdef DL_FASTMATH_X86
+    if (detail::cpu_avx2_fma()) i = detail::exp_array_avx2(x, y, n);
+#endif
+    for (; i < n; ++i) y[i] = exp_cepat(x[i]);
+}
+
+inline void log(const double* x, double* y, dl::index_t n) {
+    dl::index_t i = 0;
+    if (mode() == ModeMath::PRESISI) {
+        for (; i < n; ++i) y[i] = std::log(x[i]);
+        return;
+    }
+#ifdef DL_FASTMATH_X86
+    if (detail::cpu_avx2_fma()) i = detail::log_array_avx2(x, y, n);
+#endif
+    for (; i < n; ++i) y[i] = log_cepat(x[i]);
+}
+
+inline void sigmoid(const double* x, double* y, dl::index_t n) {
+    dl::index_t i = 0;
+    if (mode() == ModeMath::PRESISI) {
+        for (; i < n; ++i) y[i] = 1.0 / (1.0 + std::exp(-x[i]));
+        return;
+    }
+#ifdef DL_FASTMATH_X86
+    if (detail::cpu_avx2_fma()) i = detail::sigmoid_array_avx2(x, y, n);
+#endif
+    for (; i < n; ++i) y[i] = sigmoid_cepat(x[i]);
+}
+
+} // namespace fastmath //
+} // namespace dl //
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef HALF_H
+#define HALF_H
+
+#include "Tensor.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define DL_HALF_X86 1
+#endif
+
+/*
+Format 16-bit buat mixed precision (bobot dan cache aktivasi).
+Training dan inference kita ke-limit bandwidth baca bobot,
+jadi kalau bobot nya di simpan 2 byte (bukan 8 byte double), yang di baca dari memori 4x lebih kecil.
+
+Dua format:
+- BF16 (bfloat16): 8 bit exponent kek float, 7 bit mantissa. Range nya sama kek float, presisi nya kasar.
+- FP16 (half)    : 5 bit exponent, 10 bit mantissa. Lebih presisi tapi range nya cuma sampai 65504.
+
+Konversi nya pakai instruksi CPU kalau ada (F16C buat FP16, AVX512_BF16 buat BF16),
+di cek pas runtime, jadi binary yang sama tetap jalan di CPU lama pakai konversi software.
+Pembulatan nya round-to-nearest-even, hasil jalur hardware dan software sama persis
+(kecuali payload NaN).
+*/
+
+namespace dl {
+
+enum class Presisi {
+    FP64,   // Default, semua double //
+    BF16,
+    FP16
+};
+
+inline const char* nama_presisi(Presisi p) {
+    switch (p) {
+        case Presisi::FP64: return "fp64";
+        case Presisi::BF16: return "bf16";
+        case Presisi::FP16: return "fp16";
+    }
+    return "?";
+}
+
+namespace half {
+
+// KONVERSI SOFTWARE //
+
+inline uint32_t bits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+inline float dari_bits(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+// float -> bf16, round-to-nearest-even, NaN tetap NaN //
+// Float subnormal jadi nol, sama kek instruksi AVX512_BF16 (VCVTNEPS2BF16) //
+inline uint16_t float_ke_bf16(float f) {
+    uint32_t u = bits(f);
+    if ((u & 0x7FFFFFFFu) > 0x7F800000u) {
+        return static_cast<uint16_t>((u >> 16) | 0x40);
+    }
+    if ((u & 0x7F800000u) == 0) {
+        return static_cast<uint16_t>((u >> 16) & 0x8000u);
+    }
+    u += 0x7FFFu + ((u >> 16) & 1u);
+    return static_cast<uint16_t>(u >> 16);
+}
+
+inline float bf16_ke_float(uint16_t h) {
+    return dari_bits(static_cast<uint32_t>(h) << 16);
+}
+
+// float -> fp16, round-to-nearest-even, overflow jadi inf, kecil banget jadi subnormal //
+inline uint16_t float_ke_fp16(float f) {
+    const uint32_t f32_inf = 255u << 23;
+    const uint32_t f16_maks = (127u + 16u) << 23;
+    const uint32_t magic_subnormal = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t u = bits(f);
+    const uint32_t tanda = u & 0x80000000u;
+    u ^= tanda;
+
+    uint16_t o;
+    if (u >= f16_maks) {
+        // Inf atau NaN //
+        o = (u > f32_inf) ? 0x7E00 : 0x7C00;
+    } else if (u < (113u << 23)) {
+        // Hasil nya subnormal atau nol, biar FPU yang bulatkan //
+        float x = dari_bits(u) + dari_bits(magic_subnormal);
+        o = static_cast<uint16_t>(bits(x) - magic_subnormal);
+    } else {
+        const uint32_t mantissa_ganjil = (u >> 13) & 1u;
+        u += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu;
+        u += mantissa_ganjil;
+        o = static_cast<uint16_t>(u >> 13);
+    }
+    return static_cast<uint16_t>(o | (tanda >> 16));
+}
+
+inline float fp16_ke_float(uint16_t h) {
+    const uint32_t exp_geser = 0x7C00u << 13;
+    uint32_t o = (static_cast<uint32_t>(h) & 0x7FFFu) << 13;
+    const uint32_t exp = exp_geser & o;
+    o += static_cast<uint32_t>(127 - 15) << 23;
+    if (exp == exp_geser) {
+        o += static_cast<uint32_t>(128 - 16) << 23;   // Inf / NaN //
+    } else if (exp == 0) {
+        o += 1u << 23;                                 // Nol / subnormal //
+        o = bits(dari_bits(o) - dari_bits(113u << 23));
+    }
+    return dari_bits(o | ((static_cast<uint32_t>(h) & 0x8000u) << 16));
+}
+
+// DETEKSI CPU //
+
+namespace detail {
+
+inline bool& paksa_software_flag() {
+    static bool paksa = false;
+    return paksa;
+}
+
+inline bool cpu_f16c() {
+#ifdef DL_HALF_X86
+    static const bool ada = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx2");
+    return ada && !paksa_software_flag();
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_avx512bf16() {
+#ifdef DL_HALF_X86
+    static const bool ada = __builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512f");
+    return ada && !paksa_software_flag();
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_avx2() {
+#ifdef DL_HALF_X86
+    static const bool ada = __builtin_cpu_supports("avx2");
+    return ada && !paksa_software_flag();
+#else
+    return false;
+#endif
+}
+
+#ifdef DL_HALF_X86
+__attribute__((target("avx2,f16c")))
+inline dl::index_t float_ke_fp16_f16c(const float* src, uint16_t* dst, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+    return i;
+}
+
+__attribute__((target("avx2,f16c")))
+inline dl::index_t fp16_ke_float_f16c(const uint16_t* src, float* dst, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    return i;
+}
+
+__attribute__((target("avx512f,avx512bf16")))
+inline dl::index_t float_ke_bf16_avx512(const float* src, uint16_t* dst, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        std::memcpy(dst + i, &h, sizeof(h));
+    }
+    return i;
+}
+
+// bf16 -> float cuma geser 16 bit, cukup AVX2 //
+__attribute__((target("avx2")))
+inline dl::index_t bf16_ke_float_avx2(const uint16_t* src, float* dst, dl::index_t n) {
+    dl::index_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(x, 16)));
+    }
+    return i;
+}
+#endif
+
+} // namespace detail //
+
+// Matikan jalur hardware (buat test / banding hasil), konversi nya jadi software semua //
+inline void paksa_software(bool nilai) {
+    detail::paksa_software_flag() = nilai;
+}
+
+// Nama jalur konversi yang aktif buat presisi p //
+inline const char* jalur_konversi(Presisi p) {
+    if (p == Presisi::FP16) return detail::cpu_f16c() ? "F16C" : "software";
+    if (p == Presisi::BF16) return detail::cpu_avx512bf16() ? "AVX512_BF16" : "software";
+    return "-";
+}
+
+// KONVERSI BULK //
+
+// float[n] -> 16-bit[n] //
+inline void ke_half(const float* src, uint16_t* dst, dl::index_t n, Presisi p) {
+    assert(p != Presisi::FP64 && "ke_half butuh presisi BF16 atau FP16");
+    dl::index_t i = 0;
+#ifdef DL_HALF_X86
+    if (p == Presisi::FP16 && detail::cpu_f16c()) i = detail::float_ke_fp16_f16c(src, dst, n);
+    if (p == Presisi::BF16 && detail::cpu_avx512bf16()) i = detail::float_ke_bf16_avx512(src, dst, n);
+#endif
+    if (p == Presisi::FP16) {
+        for (; i < n; ++i) dst[i] = float_ke_fp16(src[i]);
+    } else {
+        for (; i < n; ++i) dst[i] = float_ke_bf16(src[i]);
+    }
+}
+
+// double[n] -> 16-bit[n], lewat float per blok kecil di stack //
+inline void ke_half(const double* src, uint16_t* dst, dl::index_t n, Presisi p) {
+    constexpr dl::index_t BLOK = 256;
+    float buf[BLOK];
+    for (dl::index_t i = 0; i < n; i += BLOK) {
+        const dl::index_t m = (n - i < BLOK) ? n - i : BLOK;
+        for (dl::index_t j = 0; j < m; ++j) buf[j] = static_cast<float>(src[i + j]);
+        ke_half(buf, dst + i, m, p);
+    }
+}
+
+// 16-bit[n] -> float[n] //
+inline void dari_half(const uint16_t* src, float* dst, dl::index_t n, Presisi p) {
+    assert(p != Presisi::FP64 && "dari_half butuh presisi BF16 atau FP16");
+    dl::index_t i = 0;
+#ifdef DL_HALF_X86
+    if (p == Presisi::FP16 && detail::cpu_f16c()) i = detail::fp16_ke_float_f16c(src, dst, n);
+    if (p == Presisi::BF16 && detail::cpu_avx2()) i = detail::bf16_ke_float_avx2(src, dst, n);
+#endif
+    if (p == Presisi::FP16) {
+        for (; i < n; ++i) dst[i] = fp16_ke_float(src[i]);
+    } else {
+        for (; i < n; ++i) dst[i] = bf16_ke_float(src[i]);
+    }
+}
+
+} // namespace half //
+} // namespace dl //
+
+/*
+Tensor 16-bit, cuma buat penyimpanan.
+Gak ada operator aritmatika di sini: isi nya di konversi ke float per baris
+pas mau di pakai (lihat Dense), lalu di hitung dan di akumulasi di fp32.
+*/
+class TensorHalf {
+public:
+    using Storage = std::vector<uint16_t, dl::memori::TrackingAllocator<uint16_t>>;
+
+private:
+    Storage data;
+    Shape bentuk;
+    dl::index_t stride0 = 0;
+    dl::Presisi presisi = dl::Presisi::BF16;
+
+public:
+    TensorHalf() = default;
+
+    // Konversi dari Tensor double //
+    TensorHalf(const Tensor& t, dl::Presisi p) {
+        salin_dari(t, p);
+    }
+
+    // Isi ulang dari Tensor double, storage lama di pakai lagi kalau ukuran nya sama //
+    void salin_dari(const Tensor& t, dl::Presisi p) {
+        assert(p != dl::Presisi::FP64 && "TensorHalf butuh presisi BF16 atau FP16");
+        presisi = p;
+        bentuk = t.get_shape();
+        stride0 = bentuk.size() > 1 ? t.numel() / bentuk[0] : 1;
+        data.resize(static_cast<size_t>(t.numel()));
+        dl::half::ke_half(t.data_ptr(), data.data(), t.numel(), p);
+    }
+
+    // Isi ulang kolom tertentu saja dari Tensor 2D double (shape nya harus sama), buat update bobot sparse //
+    void salin_kolom(const Tensor& t, const std::vector<dl::index_t>& kolom) {
+        assert(t.get_shape() == bentuk && bentuk.size() == 2 && "salin_kolom butuh Tensor 2D dengan shape yang sama");
+        for (dl::index_t o = 0; o < bentuk[0]; ++o) {
+            const double* src = t.row_ptr(o);
+            uint16_t* dst = data.data() + o * stride0;
+            for (dl::index_t k : kolom) {
+                const float f = static_cast<float>(src[k]);
+                dst[k] = presisi == dl::Presisi::FP16 ? dl::half::float_ke_fp16(f) : dl::half::float_ke_bf16(f);
+            }
+        }
+    }
+
+    // Konversi balik ke Tensor double //
+    Tensor to_tensor() const {
+        Tensor t(bentuk);
+        std::vector<float> buf(data.size());
+        dl::half::dari_half(data.data(), buf.data(), numel(), presisi);
+        for (dl::index_t i = 0; i < numel(); ++i) t[i] = buf[i];
+        return t;
+    }
+
+    // Baris i di konversi ke float, dst minimal panjang stride baris //
+    void baris_ke_float(dl::index_t i, float* dst) const {
+        dl::half::dari_half(data.data() + i * stride0, dst, stride0, presisi);
+    }
+
+    const uint16_t* row_ptr(dl::index_t i) const { return data.data() + i * stride0; }
+    const Shape& get_shape() const { return bentuk; }
+    dl::index_t numel() const { return static_cast<dl::index_t>(data.size()); }
+    dl::Presisi get_presisi() const { return presisi; }
+    bool kosong() const { return data.empty(); }
+    long long bytes() const { return static_cast<long long>(data.size()) * sizeof(uint16_t); }
+};
+
+#endif
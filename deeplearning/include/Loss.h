@@ -4,7 +4,13 @@
 #include "Tensor.h"
 #include "Tensor_operator.h"
 #include "Tensor_factory.h"
+#include "Profiler.h"
+#include "FastMath.h"
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
 
 /*
 Apa sih itu binarycross entropy?
@@ -28,24 +34,26 @@ public:
     // Forward pass dengan numerical stability //
     // Kita clamp y_pred supaya tidak ada log(0) = -inf //
     static Tensor forward(const Tensor& y_pred, const Tensor& y_test) {
+        DL_MEMORY_TAG("Loss");
         Tensor out(y_pred.get_shape());
         const double eps = 1e-7;  // Small epsilon untuk numerical stability //
         
-        for (int i = 0; i < y_pred.numel(); ++i) {
+        for (dl::index_t i = 0; i < y_pred.numel(); ++i) {
             // Clamp y_pred antara eps dan 1-eps untuk menghindari log(0) //
             double p = std::max(eps, std::min(1.0 - eps, y_pred[i]));
             double y = y_test[i];
-            out[i] = -(y * std::log(p) + (1.0 - y) * std::log(1.0 - p));
+            out[i] = -(y * dl::fastmath::log(p) + (1.0 - y) * dl::fastmath::log(1.0 - p));
         }
         return out;
     }
 
     // Backward pass dengan numerical stability //
     static Tensor backward(const Tensor& y_pred, const Tensor& y_test) {
+        DL_MEMORY_TAG("Loss");
         Tensor out(y_pred.get_shape());
         const double eps = 1e-7;  // Small epsilon untuk numerical stability //
         
-        for (int i = 0; i < y_pred.numel(); ++i) {
+        for (dl::index_t i = 0; i < y_pred.numel(); ++i) {
             // Clamp y_pred untuk menghindari division by zero //
             double p = std::max(eps, std::min(1.0 - eps, y_pred[i]));
             double y = y_test[i];
@@ -56,4 +64,141 @@ public:
     }
 };
 
-#endif
\ No newline at end of file
+/*
+Softmax + Categorical Cross Entropy, buat klasifikasi banyak kelas.
+Dua-dua nya di gabung (fused) karna kalau di pisah, softmax nya harus
+nyimpen probabilitas [batch, kelas] dulu, lalu log nya bisa underflow jadi log(0).
+
+Rumus per baris (z = logits, c = label):
+loss = log(sum_j exp(z_j)) - z_c = logsumexp(z) - z_c
+
+logsumexp nya di hitung stabil: m = max(z), logsumexp = m + log(sum_j exp(z_j - m)).
+Per baris tiga jalan yang semua nya bisa di vektorisasi, gak ada cabang per elemen:
+max per blok 4 akumulator, exp(z - m) satu baris sekaligus lewat dl::fastmath::exp (jalur AVX2),
+lalu jumlah nya. Di backward / softmax hasil exp nya langsung jadi output, jadi exp nya cuma sekali.
+
+Backward nya langsung softmax(z) - onehot(c), gak perlu lewat turunan log dan softmax satu-satu.
+Sama kek BinaryCrossEnrtopy, gradient nya per sampel (gak di bagi batch).
+
+Label nya integer (indeks kelas 0..kelas-1), di simpan di Tensor [batch] atau [batch, 1].
+Label yang negatif, >= kelas, bukan bilangan bulat, atau NaN lempar std::out_of_range
+(di cek pas runtime, label nya dari data luar dan di pakai buat indeks baris logits).
+*/
+
+class SoftmaxCrossEntropy {
+private:
+    // Max satu baris, 4 akumulator biar compiler bisa vektorisasi (gak ada dependensi antar iterasi) //
+    static double max_baris(const double* z, dl::index_t n) {
+        double m0 = z[0], m1 = z[0], m2 = z[0], m3 = z[0];
+        dl::index_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            m0 = std::max(m0, z[j]);
+            m1 = std::max(m1, z[j + 1]);
+            m2 = std::max(m2, z[j + 2]);
+            m3 = std::max(m3, z[j + 3]);
+        }
+        for (; j < n; ++j) {
+            m0 = std::max(m0, z[j]);
+        }
+        return std::max(std::max(m0, m1), std::max(m2, m3));
+    }
+
+    // e[j] = exp(z[j] - m) satu baris sekaligus, return jumlah nya. e boleh sama dengan z //
+    static double exp_geser_jumlah(const double* z, double* e, dl::index_t n, double m) {
+        for (dl::index_t j = 0; j < n; ++j) {
+            e[j] = z[j] - m;
+        }
+        dl::fastmath::exp(e, e, n);
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        dl::index_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            s0 += e[j];
+            s1 += e[j + 1];
+            s2 += e[j + 2];
+            s3 += e[j + 3];
+        }
+        for (; j < n; ++j) {
+            s0 += e[j];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    // p = softmax(z) satu baris, p boleh sama dengan z //
+    static void softmax_baris(const double* z, double* p, dl::index_t n) {
+        const double m = max_baris(z, n);
+        const double inv = 1.0 / exp_geser_jumlah(z, p, n, m);
+        for (dl::index_t j = 0; j < n; ++j) {
+            p[j] *= inv;
+        }
+    }
+
+    static void cek_jumlah_label(const Tensor& label, dl::index_t batch) {
+        if (label.numel() != batch) {
+            throw std::invalid_argument("SoftmaxCrossEntropy: jumlah label " + std::to_string(label.numel()) +
+                                        " beda dengan batch " + std::to_string(batch));
+        }
+    }
+
+    static dl::index_t ambil_label(const Tensor& label, dl::index_t b, dl::index_t kelas) {
+        const double v = label[b];
+        // !(v >= 0) juga nangkep NaN //
+        if (!(v >= 0.0) || v >= static_cast<double>(kelas) || v != std::floor(v)) {
+            throw std::out_of_range("SoftmaxCrossEntropy: label baris " + std::to_string(b) + " = " +
+                                    std::to_string(v) + " bukan kelas 0.." + std::to_string(kelas - 1));
+        }
+        return static_cast<dl::index_t>(v);
+    }
+
+public:
+    // Softmax stabil per baris, cuma di pakai kalau probabilitas nya memang di minta (predict) //
+    static Tensor softmax(const Tensor& logits) {
+        DL_MEMORY_TAG("Aktivasi");
+        DL_PROFILE("Softmax::forward", logits.numel());
+        const dl::index_t batch = logits.get_shape()[0];
+        const dl::index_t kelas = logits.get_shape()[1];
+        Tensor out(logits.get_shape());
+        for (dl::index_t b = 0; b < batch; ++b) {
+            softmax_baris(logits.row_ptr(b), out.row_ptr(b), kelas);
+        }
+        return out;
+    }
+
+    // Forward: loss per sampel, shape [batch] //
+    static Tensor forward(const Tensor& logits, const Tensor& label) {
+        DL_MEMORY_TAG("Loss");
+        DL_PROFILE("SoftmaxCrossEntropy::forward", logits.numel());
+        const dl::index_t batch = logits.get_shape()[0];
+        const dl::index_t kelas = logits.get_shape()[1];
+        cek_jumlah_label(label, batch);
+        Tensor out({batch});
+        // Buffer exp satu baris, di pakai ulang semua baris //
+        Tensor::Storage e(static_cast<size_t>(kelas));
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* z = logits.row_ptr(b);
+            const dl::index_t c = ambil_label(label, b, kelas);
+            const double m = max_baris(z, kelas);
+            const double s = exp_geser_jumlah(z, e.data(), kelas, m);
+            out[b] = m + dl::fastmath::log(s) - z[c];
+        }
+        return out;
+    }
+
+    // Backward: gradient ke logits = softmax(z) - onehot(label), shape [batch, kelas] //
+    static Tensor backward(const Tensor& logits, const Tensor& label) {
+        DL_MEMORY_TAG("Loss");
+        DL_PROFILE("SoftmaxCrossEntropy::backward", logits.numel());
+        const dl::index_t batch = logits.get_shape()[0];
+        const dl::index_t kelas = logits.get_shape()[1];
+        cek_jumlah_label(label, batch);
+        Tensor out(logits.get_shape());
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const dl::index_t c = ambil_label(label, b, kelas);
+            double* g = out.row_ptr(b);
+            softmax_baris(logits.row_ptr(b), g, kelas);
+            g[c] -= 1.0;
+        }
+        return out;
+    }
+};
+
+#endif
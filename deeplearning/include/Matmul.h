@@ -0,0 +1,266 @@
+#ifndef MATMUL_H
+#define MATMUL_H
+
+#include "Tensor.h"
+#include "Parallel.h"
+#include "Profiler.h"
+#include "Autotune.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/*
+Perkalian matriks umum: 2D x 2D, batched 3D x 3D, dan broadcast dimensi batch.
+
+    dl::matmul(a, b)                        // [M, K] x [K, N] -> [M, N] //
+    dl::matmul(q, dl::transpos(k))          // [B, M, K] x [B, N, K]^T -> [B, M, N] //
+    dl::matmul(x, w)                        // [B, M, K] x [K, N] -> [B, M, N], w di broadcast //
+    dl::matmul(dl::transpos(a), b)          // Transpos dua matriks terakhir, gak ada copy //
+
+Operand boleh rank 2 atau 3. Dimensi batch harus sama, atau salah satu nya 1 / rank 2
+(di broadcast, gak di copy). Hasil nya rank 2 kalau dua-dua nya rank 2, selain itu [B, M, N].
+
+Transpos cuma nukar stride baris dan kolom. Data nya baru di sentuh pas packing:
+kernel nya gaya GotoBLAS, A di pack per panel MR baris, B per panel NR kolom, jadi
+kernel mikro selalu baca memori berurutan apa pun layout operand nya.
+    blok NC kolom B  (panel B KC x NC, di L3)
+      blok KC dari K (panel A MC x KC, di L2)
+        blok MC baris A
+          kernel mikro MR x NR, MR * NR akumulator di register
+Setiap C[i, j] di jumlah dengan urutan k berurutan (0, 1, 2, ...) pakai madd yang sama dengan
+Autotune: akumulator mulai dari 0, blok KC berikut nya lanjut dari nilai C sebelum nya.
+Jadi hasil nya sama persis bit per bit dengan tuning::linear dan loop biasa, berapa pun
+ukuran blok, layout operand, dan thread nya.
+
+Thread: batch di bagi ke thread kalau jumlah batch nya cukup, kalau gak per blok MC baris.
+*/
+
+namespace dl {
+
+// Operand matmul: Tensor plus flag transpos (dua dimensi terakhir) //
+struct OperandMatmul {
+    const Tensor* tensor;
+    bool transpos;
+
+    OperandMatmul(const Tensor& t, bool transpos_ = false) : tensor(&t), transpos(transpos_) {}
+};
+
+inline OperandMatmul transpos(const Tensor& t) {
+    return OperandMatmul(t, true);
+}
+
+namespace gemm {
+
+constexpr index_t MR = 4;
+constexpr index_t NR = 8;
+constexpr index_t KC = 256;      // Panel mikro B KC x NR = 16 KB, muat di L1 //
+constexpr index_t MC = 128;      // Panel A MC x KC = 256 KB, muat di L2 //
+constexpr index_t NC = 2048;     // Panel B KC x NC = 4 MB //
+constexpr index_t KECIL = 32 * 32 * 32;   // M * N * K segini ke bawah gak usah packing //
+
+// Matriks logis [baris, kolom] dengan stride sembarang //
+struct Pandangan {
+    const double* data;
+    index_t baris;
+    index_t kolom;
+    index_t sb;     // Stride baris //
+    index_t sk;     // Stride kolom //
+
+    // Offset elemen (i, k) dari data, index_t semua biar matriks > 2^31 elemen gak overflow //
+    index_t offset(index_t i, index_t k) const { return i * sb + k * sk; }
+    double at(index_t i, index_t k) const { return data[offset(i, k)]; }
+};
+
+/*
+Pack A[i0 : i0 + mc, k0 : k0 + kc] per panel MR baris: panel p berisi kc x MR,
+elemen (i, k) di [k * MR + i]. Baris sisa di isi 0 biar kernel mikro gak perlu cabang.
+*/
+inline void pack_a(const Pandangan& a, index_t i0, index_t mc, index_t k0, index_t kc, double* tujuan) {
+    for (index_t ip = 0; ip < mc; ip += MR) {
+        const index_t mr = std::min(MR, mc - ip);
+        double* p = tujuan + ip * kc;
+        if (a.sk == 1) {
+            for (index_t k = 0; k < kc; ++k) {
+                for (index_t i = 0; i < mr; ++i) p[k * MR + i] = a.data[(i0 + ip + i) * a.sb + k0 + k];
+                for (index_t i = mr; i < MR; ++i) p[k * MR + i] = 0.0;
+            }
+        } else {
+            for (index_t k = 0; k < kc; ++k) {
+                const double* kol = a.data + (k0 + k) * a.sk + (i0 + ip) * a.sb;
+                for (index_t i = 0; i < mr; ++i) p[k * MR + i] = kol[i * a.sb];
+                for (index_t i = mr; i < MR; ++i) p[k * MR + i] = 0.0;
+            }
+        }
+    }
+}
+
+// Pack B[k0 : k0 + kc, j0 : j0 + nc] per panel NR kolom, elemen (k, j) di [k * NR + j] //
+inline void pack_b(const Pandangan& b, index_t k0, index_t kc, index_t j0, index_t nc, double* tujuan) {
+    for (index_t jp = 0; jp < nc; jp += NR) {
+        const index_t nr = std::min(NR, nc - jp);
+        double* p = tujuan + jp * kc;
+        if (b.sk == 1) {
+            for (index_t k = 0; k < kc; ++k) {
+                const double* baris = b.data + (k0 + k) * b.sb + j0 + jp;
+                for (index_t j = 0; j < nr; ++j) p[k * NR + j] = baris[j];
+                for (index_t j = nr; j < NR; ++j) p[k * NR + j] = 0.0;
+            }
+        } else {
+            for (index_t j = 0; j < nr; ++j) {
+                const double* kol = b.data + (j0 + jp + j) * b.sk + k0 * b.sb;
+                for (index_t k = 0; k < kc; ++k) p[k * NR + j] = kol[k * b.sb];
+            }
+            for (index_t j = nr; j < NR; ++j) {
+                for (index_t k = 0; k < kc; ++k) p[k * NR + j] = 0.0;
+            }
+        }
+    }
+}
+
+/*
+Kernel mikro: C[mr x nr] (+)= panel A x panel B.
+lanjut = false -> akumulator mulai dari 0 (blok KC pertama), true -> lanjut dari C.
+*/
+inline void mikro(index_t kc, const double* pa, const double* pb, double* c, index_t ldc,
+                  index_t mr, index_t nr, bool lanjut) {
+    double acc[MR][NR] = {};
+    if (lanjut) {
+        for (index_t i = 0; i < mr; ++i) {
+            for (index_t j = 0; j < nr; ++j) acc[i][j] = c[i * ldc + j];
+        }
+    }
+    for (index_t k = 0; k < kc; ++k) {
+        const double* av = pa + k * MR;
+        const double* bv = pb + k * NR;
+        for (index_t i = 0; i < MR; ++i) {
+            for (index_t j = 0; j < NR; ++j) {
+                acc[i][j] = tuning::detail::madd(av[i], bv[j], acc[i][j]);
+            }
+        }
+    }
+    for (index_t i = 0; i < mr; ++i) {
+        for (index_t j = 0; j < nr; ++j) c[i * ldc + j] = acc[i][j];
+    }
+}
+
+// Satu blok MC baris x NC kolom dari panel yang sudah di pack //
+inline void makro(index_t mc, index_t nc, index_t kc, const double* pa, const double* pb,
+                  double* c, index_t ldc, bool lanjut) {
+    for (index_t jp = 0; jp < nc; jp += NR) {
+        const index_t nr = std::min(NR, nc - jp);
+        for (index_t ip = 0; ip < mc; ip += MR) {
+            const index_t mr = std::min(MR, mc - ip);
+            mikro(kc, pa + ip * kc, pb + jp * kc, c + ip * ldc + jp, ldc, mr, nr, lanjut);
+        }
+    }
+}
+
+// Matriks kecil: loop biasa, urutan k nya sama dengan kernel blok //
+inline void naif(const Pandangan& a, const Pandangan& b, double* c) {
+    const index_t M = a.baris, K = a.kolom, N = b.kolom;
+    for (index_t i = 0; i < M; ++i) {
+        for (index_t j = 0; j < N; ++j) {
+            double s = 0.0;
+            for (index_t k = 0; k < K; ++k) s = tuning::detail::madd(a.at(i, k), b.at(k, j), s);
+            c[i * N + j] = s;
+        }
+    }
+}
+
+// C [M, N] contiguous = A x B. paralel = bagi blok MC baris ke thread //
+inline void kalikan(const Pandangan& a, const Pandangan& b, double* c, bool paralel) {
+    const index_t M = a.baris, K = a.kolom, N = b.kolom;
+    if (M == 0 || N == 0) return;
+    if (K == 0) {
+        std::fill(c, c + M * N, 0.0);
+        return;
+    }
+    if (M * N * K <= KECIL) {
+        naif(a, b, c);
+        return;
+    }
+
+    DL_MEMORY_TAG("Matmul");
+    const index_t kc_max = std::min(KC, K);
+    const index_t nc_max = std::min(NC, (N + NR - 1) / NR * NR);
+    Tensor::Storage panel_b(static_cast<size_t>(kc_max * nc_max));
+    const index_t blok_m = (M + MC - 1) / MC;
+
+    for (index_t j0 = 0; j0 < N; j0 += NC) {
+        const index_t nc = std::min(NC, N - j0);
+        for (index_t k0 = 0; k0 < K; k0 += KC) {
+            const index_t kc = std::min(KC, K - k0);
+            const bool lanjut = k0 > 0;
+            pack_b(b, k0, kc, j0, nc, panel_b.data());
+
+            auto jalan = [&](index_t m0, index_t m1) {
+                Tensor::Storage panel_a(static_cast<size_t>(MC * kc));
+                for (index_t blok = m0; blok < m1; ++blok) {
+                    const index_t i0 = blok * MC;
+                    const index_t mc = std::min(MC, M - i0);
+                    pack_a(a, i0, mc, k0, kc, panel_a.data());
+                    makro(mc, nc, kc, panel_a.data(), panel_b.data(), c + i0 * N + j0, N, lanjut);
+                }
+            };
+            if (paralel && blok_m > 1) {
+                dl::parallel_for(0, blok_m, 1, jalan);
+            } else {
+                jalan(0, blok_m);
+            }
+        }
+    }
+}
+
+// Pandangan matriks ke-b dari operand rank 2 / 3, transpos nya lewat stride //
+inline Pandangan pandangan(const OperandMatmul& op, index_t b) {
+    const Shape& s = op.tensor->get_shape();
+    const int r = static_cast<int>(s.size());
+    const index_t baris = s[r - 2], kolom = s[r - 1];
+    const index_t batch = r == 3 ? s[0] : 1;
+    const double* data = op.tensor->data_ptr() + (batch == 1 ? 0 : b) * baris * kolom;
+    if (op.transpos) return Pandangan{data, kolom, baris, 1, kolom};
+    return Pandangan{data, baris, kolom, kolom, 1};
+}
+
+} // namespace gemm //
+
+inline Tensor matmul(const OperandMatmul& a, const OperandMatmul& b) {
+    const Shape& sa = a.tensor->get_shape();
+    const Shape& sb = b.tensor->get_shape();
+    const int ra = static_cast<int>(sa.size());
+    const int rb = static_cast<int>(sb.size());
+    assert((ra == 2 || ra == 3) && (rb == 2 || rb == 3) && "matmul cuma untuk Tensor rank 2 / 3");
+
+    const index_t batch_a = ra == 3 ? sa[0] : 1;
+    const index_t batch_b = rb == 3 ? sb[0] : 1;
+    assert((batch_a == batch_b || batch_a == 1 || batch_b == 1) && "Dimensi batch matmul gak bisa di broadcast");
+    const index_t batch = std::max(batch_a, batch_b);
+
+    const gemm::Pandangan a0 = gemm::pandangan(a, 0);
+    const gemm::Pandangan b0 = gemm::pandangan(b, 0);
+    assert(a0.kolom == b0.baris && "Dimensi dalam matmul gak cocok");
+    const index_t M = a0.baris, N = b0.kolom;
+
+    DL_MEMORY_TAG("Matmul");
+    DL_PROFILE("Tensor::matmul", batch * M * N * a0.kolom);
+    Tensor hasil = (ra == 2 && rb == 2) ? Tensor(Shape{M, N}) : Tensor(Shape{batch, M, N});
+    double* c = hasil.data_ptr();
+
+    // Batch nya cukup buat semua thread -> satu batch per thread, kalau gak paralel di dalam matriks //
+    if (batch > 1 && batch >= dl::jumlah_thread()) {
+        dl::parallel_for(0, batch, 1, [&](index_t b0_, index_t b1_) {
+            for (index_t i = b0_; i < b1_; ++i) {
+                gemm::kalikan(gemm::pandangan(a, i), gemm::pandangan(b, i), c + i * M * N, false);
+            }
+        });
+    } else {
+        for (index_t i = 0; i < batch; ++i) {
+            gemm::kalikan(gemm::pandangan(a, i), gemm::pandangan(b, i), c + i * M * N, true);
+        }
+    }
+    return hasil;
+}
+
+} // namespace dl //
+
+#endif
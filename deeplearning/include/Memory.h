@@ -0,0 +1,532 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/*
+Ini bagian akuntansi memori buat storage Tensor.
+Setiap Tensor pasti alokasi memori, tapi selama ini kita gak tau
+sebenarnya model kita makan memori berapa banyak pas training.
+
+Cara kerja nya:
+1. Storage Tensor pakai allocator sendiri (TrackingAllocator).
+2. Setiap alokasi di catat: bytes sekarang, bytes puncak (peak), jumlah alokasi.
+3. Setiap alokasi juga di kasih "tag" sesuai call site nya,
+   misal "Dense::forward", "adam::state", "NeuralNetwork::cache_aktivasi".
+   Tag nya di set pakai DL_MEMORY_TAG("...") di awal fungsi, berlaku sampai keluar scope.
+
+Tag di simpan di header kecil sebelum data, jadi pas dealokasi kita tau
+harus ngurangin statistik tag yang mana, tanpa perlu map pointer -> tag.
+
+Blok mentah nya di ambil dari Backend yang bisa di ganti (lihat atur_backend).
+Default nya AlignedBackend, jadi data Tensor selalu ter-align 64 bytes.
+Buat buffer besar bisa pakai HugePageBackend biar TLB miss nya berkurang:
+    dl::memori::aktifkan_huge_page();   // buffer >= 2 MB pakai transparent huge page //
+*/
+
+namespace dl {
+namespace memori {
+
+// Statistik per tag //
+struct StatistikTag {
+    std::string nama;
+    int64_t bytes_sekarang = 0;
+    int64_t bytes_puncak = 0;
+    int64_t jumlah_alokasi = 0;
+    int64_t jumlah_dealokasi = 0;
+};
+
+// Statistik keseluruhan //
+struct Statistik {
+    int64_t bytes_sekarang = 0;
+    int64_t bytes_puncak = 0;
+    int64_t jumlah_alokasi = 0;
+    int64_t jumlah_dealokasi = 0;
+    std::vector<StatistikTag> per_tag;
+};
+
+// Semua storage Tensor ter-align segini, cukup buat load AVX-512 yang aligned //
+constexpr std::size_t ALIGNMENT = 64;
+
+/*
+Backend alokasi yang bisa di ganti-ganti (pluggable).
+Backend cuma ngurusin blok mentah, akuntansi tag dan statistik tetap di sini.
+Blok yang di return wajib ter-align ALIGNMENT bytes.
+penanda bebas di isi backend, nanti di kasih balik pas dealokasi.
+Backend harus hidup lebih lama dari semua buffer yang dia alokasi.
+*/
+class Backend {
+public:
+    virtual ~Backend() = default;
+    virtual void* alokasi(std::size_t bytes, int& penanda) = 0;
+    virtual void dealokasi(void* p, std::size_t bytes, int penanda) noexcept = 0;
+    virtual const char* nama() const = 0;
+};
+
+// Backend default: heap biasa tapi ter-align 64 bytes //
+class AlignedBackend : public Backend {
+public:
+    void* alokasi(std::size_t bytes, int& penanda) override {
+        penanda = 0;
+        // aligned_alloc minta ukuran kelipatan alignment //
+        return std::aligned_alloc(ALIGNMENT, bulatkan(bytes, ALIGNMENT));
+    }
+
+    void dealokasi(void* p, std::size_t, int) noexcept override {
+        std::free(p);
+    }
+
+    const char* nama() const override { return "aligned-64"; }
+
+    static std::size_t bulatkan(std::size_t n, std::size_t kelipatan) {
+        return (n + kelipatan - 1) / kelipatan * kelipatan;
+    }
+};
+
+/*
+Mode huge page buat buffer besar.
+Page normal itu 4 KB, jadi bobot Dense 1024x1024 (8 MB) butuh 2048 entry TLB.
+Dengan huge page 2 MB cukup 4 entry, TLB miss nya jauh berkurang.
+
+THP     = transparent huge page, alokasi ter-align 2 MB lalu madvise(MADV_HUGEPAGE).
+          Jalan di kernel yang THP nya "madvise" atau "always".
+HUGETLB = mmap dengan MAP_HUGETLB, butuh huge page yang sudah di reservasi
+          (/proc/sys/vm/nr_hugepages). Kalau gagal, otomatis jatuh ke THP.
+*/
+enum class ModeHugePage {
+    MATI,
+    THP,
+    HUGETLB
+};
+
+class HugePageBackend : public AlignedBackend {
+private:
+    std::atomic<ModeHugePage> mode;
+    std::atomic<std::size_t> ambang;
+
+    enum Penanda { HEAP = 0, HEAP_HUGE = 1, MMAP_HUGE = 2 };
+
+    /*
+    Cache blok huge page yang sudah di free.
+    Page fault pertama di huge page itu mahal (kernel harus nyari dan nge-nol-in 2 MB,
+    kadang sampai compaction dulu), dan training loop alokasi buffer dengan ukuran
+    yang sama terus setiap step. Jadi blok nya di simpan buat di pakai lagi.
+    */
+    struct Blok {
+        void* ptr;
+        std::size_t ukuran;
+        int penanda;
+    };
+    std::vector<Blok> cache;
+    std::size_t bytes_cache = 0;
+    std::size_t maks_cache;
+    std::mutex mtx;
+
+    /*
+    Kalau semua buffer mulai tepat di batas 2 MB, baris ke-i dari bobot, input, dan gradient
+    jatuh ke set cache L1/L2 yang sama, jadi saling nendang (cache aliasing).
+    Makanya awal data di geser sedikit, beda-beda setiap alokasi ("cache coloring").
+    Pergeseran nya < 2 MB, jadi awal blok asli tinggal di bulatkan ke bawah pas dealokasi.
+    */
+    static constexpr std::size_t LANGKAH_WARNA = 5 * ALIGNMENT;
+    static constexpr std::size_t JUMLAH_WARNA = 32;
+    std::atomic<std::size_t> warna_berikut{0};
+
+    static void lepas(const Blok& b) noexcept {
+#ifdef __linux__
+        if (b.penanda == MMAP_HUGE) {
+            munmap(b.ptr, b.ukuran);
+            return;
+        }
+#endif
+        std::free(b.ptr);
+    }
+
+public:
+    static constexpr std::size_t UKURAN_HUGE_PAGE = std::size_t(2) << 20;
+
+    // Buffer di bawah ambang tetap pakai heap biasa //
+    explicit HugePageBackend(ModeHugePage mode_ = ModeHugePage::THP,
+                             std::size_t ambang_ = UKURAN_HUGE_PAGE,
+                             std::size_t maks_cache_ = std::size_t(256) << 20)
+        : mode(mode_), ambang(ambang_), maks_cache(maks_cache_) {}
+
+    ~HugePageBackend() override { kosongkan_cache(); }
+
+    void atur_mode(ModeHugePage m) { mode.store(m); }
+    void atur_ambang(std::size_t bytes) { ambang.store(bytes); }
+    ModeHugePage dapatkan_mode() const { return mode.load(); }
+    std::size_t dapatkan_ambang() const { return ambang.load(); }
+
+    // Balikin semua blok di cache ke OS //
+    void kosongkan_cache() {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const Blok& b : cache) lepas(b);
+        cache.clear();
+        bytes_cache = 0;
+    }
+
+    void* alokasi(std::size_t bytes, int& penanda) override {
+        ModeHugePage m = mode.load(std::memory_order_relaxed);
+        if (m == ModeHugePage::MATI || bytes < ambang.load(std::memory_order_relaxed)) {
+            return AlignedBackend::alokasi(bytes, penanda);
+        }
+        const std::size_t geser =
+            (warna_berikut.fetch_add(1, std::memory_order_relaxed) % JUMLAH_WARNA) * LANGKAH_WARNA;
+        const std::size_t ukuran = bulatkan(bytes + geser, UKURAN_HUGE_PAGE);
+        void* p = ambil_blok(ukuran, m, penanda);
+        return p ? static_cast<char*>(p) + geser : nullptr;
+    }
+
+    void dealokasi(void* p, std::size_t bytes, int penanda) noexcept override {
+        if (penanda == HEAP) {
+            std::free(p);
+            return;
+        }
+        // Balik ke awal blok asli (ter-align 2 MB) //
+        const std::uintptr_t awal = reinterpret_cast<std::uintptr_t>(p) & ~(UKURAN_HUGE_PAGE - 1);
+        const std::size_t geser = reinterpret_cast<std::uintptr_t>(p) - awal;
+        Blok b{reinterpret_cast<void*>(awal), bulatkan(bytes + geser, UKURAN_HUGE_PAGE), penanda};
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (bytes_cache + b.ukuran <= maks_cache) {
+                cache.push_back(b);
+                bytes_cache += b.ukuran;
+                return;
+            }
+        }
+        lepas(b);
+    }
+
+    const char* nama() const override { return "huge-page"; }
+
+private:
+    // Ambil blok ter-align 2 MB, dari cache dulu kalau ada yang ukuran nya pas //
+    void* ambil_blok(std::size_t ukuran, ModeHugePage m, int& penanda) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (std::size_t i = 0; i < cache.size(); ++i) {
+                if (cache[i].ukuran == ukuran) {
+                    Blok b = cache[i];
+                    cache[i] = cache.back();
+                    cache.pop_back();
+                    bytes_cache -= b.ukuran;
+                    penanda = b.penanda;
+                    return b.ptr;
+                }
+            }
+        }
+
+#ifdef __linux__
+        if (m == ModeHugePage::HUGETLB) {
+            void* p = mmap(nullptr, ukuran, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                penanda = MMAP_HUGE;
+                return p;
+            }
+        }
+#endif
+
+        void* p = std::aligned_alloc(UKURAN_HUGE_PAGE, ukuran);
+#ifdef MADV_HUGEPAGE
+        if (p) madvise(p, ukuran, MADV_HUGEPAGE);
+#endif
+        penanda = HEAP_HUGE;
+        return p;
+    }
+};
+
+namespace detail {
+
+// Maksimal jumlah tag yang bisa di daftarkan //
+constexpr int MAKS_TAG = 64;
+
+struct Counter {
+    std::atomic<int64_t> sekarang{0};
+    std::atomic<int64_t> puncak{0};
+    std::atomic<int64_t> alokasi{0};
+    std::atomic<int64_t> dealokasi{0};
+
+    void tambah(int64_t bytes) {
+        int64_t baru = sekarang.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        int64_t lama = puncak.load(std::memory_order_relaxed);
+        while (baru > lama &&
+               !puncak.compare_exchange_weak(lama, baru, std::memory_order_relaxed)) {
+        }
+        alokasi.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void kurang(int64_t bytes) {
+        sekarang.fetch_sub(bytes, std::memory_order_relaxed);
+        dealokasi.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct Registry {
+    Counter total;
+    Counter per_tag[MAKS_TAG];
+    std::string nama[MAKS_TAG];
+    int jumlah_tag = 1;   // Tag 0 = "lainnya" (tanpa tag) //
+    std::mutex mtx;
+
+    Registry() { nama[0] = "lainnya"; }
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// Tag yang aktif di thread ini //
+inline int& tag_aktif() {
+    thread_local int tag = 0;
+    return tag;
+}
+
+// Backend yang aktif sekarang, default nya AlignedBackend //
+inline std::atomic<Backend*>& backend_aktif() {
+    static AlignedBackend bawaan;
+    static std::atomic<Backend*> aktif{&bawaan};
+    return aktif;
+}
+
+/*
+Header sebelum data, ukuran nya 64 bytes (satu cache line).
+Karna blok mentah dari backend ter-align 64 bytes, data setelah header juga ter-align 64 bytes.
+Header nyimpen backend yang ngalokasi blok ini, jadi dealokasi selalu balik ke backend yang benar
+walaupun backend aktif nya sudah di ganti.
+*/
+constexpr std::size_t UKURAN_HEADER = ALIGNMENT;
+
+struct Header {
+    int64_t bytes;      // Bytes yang di minta (yang di catat di statistik) //
+    int64_t total;      // Bytes blok mentah, termasuk header //
+    Backend* backend;
+    int32_t tag;
+    int32_t penanda;    // Info dari backend, misal blok nya dari mmap atau heap //
+};
+static_assert(sizeof(Header) <= UKURAN_HEADER, "Header terlalu besar");
+
+inline void* alokasi(std::size_t bytes) {
+    Backend* b = backend_aktif().load(std::memory_order_acquire);
+    const std::size_t total = UKURAN_HEADER + bytes;
+    int penanda = 0;
+    char* raw = static_cast<char*>(b->alokasi(total, penanda));
+    if (!raw) throw std::bad_alloc();
+
+    int tag = tag_aktif();
+    Header* h = reinterpret_cast<Header*>(raw);
+    h->bytes = static_cast<int64_t>(bytes);
+    h->total = static_cast<int64_t>(total);
+    h->backend = b;
+    h->tag = tag;
+    h->penanda = penanda;
+
+    Registry& r = registry();
+    r.total.tambah(h->bytes);
+    r.per_tag[tag].tambah(h->bytes);
+    return raw + UKURAN_HEADER;
+}
+
+inline void dealokasi(void* p) noexcept {
+    if (!p) return;
+    char* raw = static_cast<char*>(p) - UKURAN_HEADER;
+    Header* h = reinterpret_cast<Header*>(raw);
+
+    Registry& r = registry();
+    r.total.kurang(h->bytes);
+    r.per_tag[h->tag].kurang(h->bytes);
+    h->backend->dealokasi(raw, static_cast<std::size_t>(h->total), h->penanda);
+}
+
+} // namespace detail //
+
+// Ganti backend alokasi, return backend sebelum nya //
+// Buffer lama tetap di dealokasi sama backend yang ngalokasi nya //
+inline Backend* atur_backend(Backend* b) {
+    assert(b != nullptr && "Backend gak boleh nullptr");
+    return detail::backend_aktif().exchange(b, std::memory_order_acq_rel);
+}
+
+inline Backend* backend() {
+    return detail::backend_aktif().load(std::memory_order_acquire);
+}
+
+// Backend huge page bawaan, tinggal di aktifkan //
+inline HugePageBackend& huge_page_backend() {
+    static HugePageBackend b;
+    return b;
+}
+
+// Shortcut: buffer >= ambang pakai huge page, sisa nya tetap aligned 64 bytes //
+inline void aktifkan_huge_page(ModeHugePage mode = ModeHugePage::THP,
+                               std::size_t ambang = HugePageBackend::UKURAN_HUGE_PAGE) {
+    HugePageBackend& b = huge_page_backend();
+    b.atur_mode(mode);
+    b.atur_ambang(ambang);
+    atur_backend(&b);
+}
+
+// RAII buat pakai backend tertentu di scope sekarang //
+class PakaiBackend {
+private:
+    Backend* sebelumnya;
+
+public:
+    explicit PakaiBackend(Backend* b) : sebelumnya(atur_backend(b)) {}
+    ~PakaiBackend() { atur_backend(sebelumnya); }
+
+    PakaiBackend(const PakaiBackend&) = delete;
+    PakaiBackend& operator=(const PakaiBackend&) = delete;
+};
+
+// Daftarkan nama tag, return id nya. Nama yang sama dapat id yang sama //
+inline int daftar_tag(const char* nama) {
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mtx);
+    for (int i = 0; i < r.jumlah_tag; ++i) {
+        if (r.nama[i] == nama) return i;
+    }
+    if (r.jumlah_tag >= detail::MAKS_TAG) return 0;  // Penuh, masuk ke "lainnya" //
+    r.nama[r.jumlah_tag] = nama;
+    return r.jumlah_tag++;
+}
+
+/*
+Tag buat salinan buffer: kalau ada tag aktif, pakai itu.
+Kalau gak ada, salinan mewarisi tag buffer asli nya.
+Jadi misal Dense di copy ke dalam std::vector, bobot nya tetap ke-tag "Dense::parameter".
+*/
+inline int tag_warisan(const void* p) {
+    int aktif = detail::tag_aktif();
+    if (aktif != 0 || p == nullptr) return aktif;
+    const char* raw = static_cast<const char*>(p) - detail::UKURAN_HEADER;
+    return reinterpret_cast<const detail::Header*>(raw)->tag;
+}
+
+// RAII buat set tag aktif, tag sebelumnya di kembalikan pas keluar scope //
+class Tag {
+private:
+    int sebelumnya;
+
+public:
+    explicit Tag(int id) : sebelumnya(detail::tag_aktif()) {
+        detail::tag_aktif() = id;
+    }
+    ~Tag() { detail::tag_aktif() = sebelumnya; }
+
+    Tag(const Tag&) = delete;
+    Tag& operator=(const Tag&) = delete;
+};
+
+// Ambil statistik sekarang //
+inline Statistik statistik() {
+    detail::Registry& r = detail::registry();
+    Statistik s;
+    s.bytes_sekarang = r.total.sekarang.load(std::memory_order_relaxed);
+    s.bytes_puncak = r.total.puncak.load(std::memory_order_relaxed);
+    s.jumlah_alokasi = r.total.alokasi.load(std::memory_order_relaxed);
+    s.jumlah_dealokasi = r.total.dealokasi.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(r.mtx);
+    for (int i = 0; i < r.jumlah_tag; ++i) {
+        const detail::Counter& c = r.per_tag[i];
+        StatistikTag t;
+        t.nama = r.nama[i];
+        t.bytes_sekarang = c.sekarang.load(std::memory_order_relaxed);
+        t.bytes_puncak = c.puncak.load(std::memory_order_relaxed);
+        t.jumlah_alokasi = c.alokasi.load(std::memory_order_relaxed);
+        t.jumlah_dealokasi = c.dealokasi.load(std::memory_order_relaxed);
+        if (t.jumlah_alokasi > 0) {
+            s.per_tag.push_back(t);
+        }
+    }
+    return s;
+}
+
+// Reset peak ke nilai sekarang, berguna buat ngukur peak per epoch //
+inline void reset_puncak() {
+    detail::Registry& r = detail::registry();
+    r.total.puncak.store(r.total.sekarang.load());
+    for (int i = 0; i < detail::MAKS_TAG; ++i) {
+        r.per_tag[i].puncak.store(r.per_tag[i].sekarang.load());
+    }
+}
+
+// Format bytes biar enak di baca //
+inline std::string format_bytes(int64_t bytes) {
+    const char* satuan[] = {"B", "KB", "MB", "GB", "TB"};
+    double nilai = static_cast<double>(bytes);
+    int i = 0;
+    while ((nilai >= 1024.0 || nilai <= -1024.0) && i < 4) {
+        nilai /= 1024.0;
+        ++i;
+    }
+    std::string s = std::to_string(nilai);
+    s = s.substr(0, s.find('.') + 3);
+    return s + " " + satuan[i];
+}
+
+// Cetak laporan memori //
+inline void laporan(std::ostream& os = std::cout) {
+    Statistik s = statistik();
+    os << "Memori Tensor sekarang: " << format_bytes(s.bytes_sekarang)
+       << ", puncak: " << format_bytes(s.bytes_puncak)
+       << ", alokasi: " << s.jumlah_alokasi << std::endl;
+    for (const auto& t : s.per_tag) {
+        os << "  " << std::left << std::setw(30) << t.nama << std::right
+           << " sekarang: " << std::setw(12) << format_bytes(t.bytes_sekarang)
+           << " puncak: " << std::setw(12) << format_bytes(t.bytes_puncak)
+           << " alokasi: " << t.jumlah_alokasi << std::endl;
+    }
+}
+
+// Allocator buat std::vector, semua alokasi lewat detail::alokasi (jadi lewat backend aktif) //
+template <typename T>
+struct TrackingAllocator {
+    using value_type = T;
+
+    TrackingAllocator() noexcept = default;
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(detail::alokasi(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        detail::dealokasi(p);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const TrackingAllocator<T>&, const TrackingAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const TrackingAllocator<T>&, const TrackingAllocator<U>&) { return false; }
+
+} // namespace memori //
+} // namespace dl //
+
+// Macro buat set tag di scope sekarang, id tag nya cuma di daftarkan sekali //
+#define DL_MEMORY_CONCAT_INNER(a, b) a##b
+#define DL_MEMORY_CONCAT(a, b) DL_MEMORY_CONCAT_INNER(a, b)
+#define DL_MEMORY_TAG(nama) \
+    static const int DL_MEMORY_CONCAT(dl_memory_id_, __LINE__) = dl::memori::daftar_tag(nama); \
+    dl::memori::Tag DL_MEMORY_CONCAT(dl_memory_tag_, __LINE__)(DL_MEMORY_CONCAT(dl_memory_id_, __LINE__))
+
+#endif
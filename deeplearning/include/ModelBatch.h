@@ -0,0 +1,436 @@
+#ifndef MODEL_BATCH_H
+#define MODEL_BATCH_H
+
+#include "Tensor.h"
+#include "Tensor_factory.h"
+#include "Random.h"
+#include "FastMath.h"
+#include "Parallel.h"
+#include "Autotune.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/*
+ModelBatch: latih M network kecil yang shape nya sama sekaligus (sweep hyperparameter, ensemble).
+
+Kalau network 2 -> 4 -> 1 di latih satu NeuralNetwork per model, waktu nya habis di overhead
+per panggilan (alokasi Tensor, loop yang cuma 2 atau 4 putaran), bukan di hitungan nya.
+Di sini semua bobot M model di tumpuk jadi satu, dengan sumbu model paling dalam:
+    bobot[o][k][m], bias[o][m], aktivasi[b][fitur][m]
+Jadi setiap loop paling dalam jalan di atas model (M elemen contiguous) dan bisa di vectorize,
+satu instruksi SIMD ngerjain beberapa model sekaligus. Forward, backward, dan Adam
+nya satu kernel untuk semua model, dan model nya di bagi ke thread per potongan (parallel_for).
+
+Setiap model punya learning rate dan seed sendiri.
+Model m di inisialisasi sama persis dengan NeuralNetwork yang di buat setelah manual_seed(seed[m])
+(Kaiming normal, bias nol, layer di ambil berurutan), dan aritmatika per model nya mengikuti
+NeuralNetwork (Dense, ReLU, Sigmoid, Binary Cross Entropy, Adam), jadi hasil nya sama dengan
+melatih M NeuralNetwork satu per satu, cuma jauh lebih cepat.
+
+Semua model di latih di data yang sama (X [batch, in], y [batch, out]).
+
+Contoh:
+    ModelBatch mb({0.1, 0.03, 0.01, 0.003}, {1, 2, 3, 4});   // 4 model, lr dan seed masing-masing //
+    mb.tambah_dense(2, 4); mb.tambah_relu(); mb.tambah_dense(4, 1); mb.tambah_sigmoid();
+    std::vector<double> loss = mb.train_step(X, y);            // loss per model //
+*/
+
+class ModelBatch {
+public:
+    enum class JenisLayer { DENSE, RELU, SIGMOID };
+
+private:
+    using Storage = Tensor::Storage;
+
+    struct LayerBatch {
+        JenisLayer jenis;
+        dl::index_t in;
+        dl::index_t out;
+        // Cuma buat DENSE, semua nya dengan sumbu model paling dalam //
+        Storage bobot, bias;          // [out][in][M], [out][M] //
+        Storage grad_bobot, grad_bias;
+        Storage m_bobot, v_bobot;     // State Adam //
+        Storage m_bias, v_bias;
+    };
+
+    dl::index_t M;
+    std::vector<double> learning_rate;    // Per model //
+    std::vector<uint64_t> seed;           // Per model //
+    std::vector<uint64_t> offset_random;  // Posisi generator model m setelah inisialisasi layer terakhir //
+
+    std::vector<LayerBatch> layers;
+    dl::index_t fitur_terakhir = -1;
+
+    // Adam, sama dengan dl::optim::adam (AdamW tanpa weight decay) //
+    double beta1 = 0.9;
+    double beta2 = 0.999;
+    double epsilon = 1e-8;
+    long long t = 0;
+
+    // Aktivasi [batch][fitur][M] per layer, aktivasi[i] = input layer i (aktivasi[0] gak di pakai, input nya X) //
+    std::vector<Storage> aktivasi;
+    Storage grad_a, grad_b;     // Buffer gradient bolak-balik //
+
+    static constexpr dl::index_t GRAIN_MODEL = 64;
+
+    // Forward Dense untuk model [m0, m1). BC = input nya X yang di share semua model //
+    template <bool BC>
+    void forward_dense(const LayerBatch& d, const double* x, double* z, dl::index_t batch,
+                       dl::index_t m0, dl::index_t m1) const {
+        const double* w = d.bobot.data();
+        const double* bias = d.bias.data();
+        for (dl::index_t b = 0; b < batch; ++b) {
+            for (dl::index_t o = 0; o < d.out; ++o) {
+                double* zr = z + (b * d.out + o) * M;
+                for (dl::index_t m = m0; m < m1; ++m) zr[m] = 0.0;
+                // Urutan k nya sama dengan kernel Dense (dl::tuning::linear) //
+                for (dl::index_t k = 0; k < d.in; ++k) {
+                    const double* wr = w + (o * d.in + k) * M;
+                    if (BC) {
+                        const double xv = x[b * d.in + k];
+                        for (dl::index_t m = m0; m < m1; ++m) {
+                            zr[m] = dl::tuning::detail::madd(xv, wr[m], zr[m]);
+                        }
+                    } else {
+                        const double* xr = x + (b * d.in + k) * M;
+                        for (dl::index_t m = m0; m < m1; ++m) {
+                            zr[m] = dl::tuning::detail::madd(xr[m], wr[m], zr[m]);
+                        }
+                    }
+                }
+                const double* br = bias + o * M;
+                for (dl::index_t m = m0; m < m1; ++m) zr[m] = zr[m] + br[m];
+            }
+        }
+    }
+
+    // Backward Dense: akumulasi gradient bobot / bias, dan gradient input kalau gx != nullptr //
+    template <bool BC>
+    void backward_dense(LayerBatch& d, const double* x, const double* g, double* gx, dl::index_t batch,
+                        dl::index_t m0, dl::index_t m1) {
+        for (dl::index_t b = 0; b < batch; ++b) {
+            for (dl::index_t o = 0; o < d.out; ++o) {
+                const double* gr = g + (b * d.out + o) * M;
+                double* gbr = d.grad_bias.data() + o * M;
+                for (dl::index_t m = m0; m < m1; ++m) gbr[m] += gr[m];
+                for (dl::index_t k = 0; k < d.in; ++k) {
+                    double* gwr = d.grad_bobot.data() + (o * d.in + k) * M;
+                    if (BC) {
+                        const double xv = x[b * d.in + k];
+                        for (dl::index_t m = m0; m < m1; ++m) gwr[m] += gr[m] * xv;
+                    } else {
+                        const double* xr = x + (b * d.in + k) * M;
+                        for (dl::index_t m = m0; m < m1; ++m) gwr[m] += gr[m] * xr[m];
+                    }
+                }
+            }
+        }
+        if (!gx) return;
+        for (dl::index_t b = 0; b < batch; ++b) {
+            for (dl::index_t k = 0; k < d.in; ++k) {
+                double* gxr = gx + (b * d.in + k) * M;
+                for (dl::index_t m = m0; m < m1; ++m) gxr[m] = 0.0;
+            }
+            for (dl::index_t o = 0; o < d.out; ++o) {
+                const double* gr = g + (b * d.out + o) * M;
+                for (dl::index_t k = 0; k < d.in; ++k) {
+                    const double* wr = d.bobot.data() + (o * d.in + k) * M;
+                    double* gxr = gx + (b * d.in + k) * M;
+                    for (dl::index_t m = m0; m < m1; ++m) gxr[m] += gr[m] * wr[m];
+                }
+            }
+        }
+    }
+
+    // Adam untuk n elemen parameter, learning rate nya per model //
+    void adam(double* w, double* mom, double* vel, double* g, dl::index_t n,
+              double koreksi1, double koreksi2, dl::index_t m0, dl::index_t m1) const {
+        for (dl::index_t i = 0; i < n; ++i) {
+            double* wr = w + i * M;
+            double* mr = mom + i * M;
+            double* vr = vel + i * M;
+            double* gr = g + i * M;
+            for (dl::index_t m = m0; m < m1; ++m) {
+                mr[m] = beta1 * mr[m] + (1 - beta1) * gr[m];
+                vr[m] = beta2 * vr[m] + (1 - beta2) * (gr[m] * gr[m]);
+                const double m_hat = mr[m] / koreksi1;
+                const double v_hat = vr[m] / koreksi2;
+                wr[m] = wr[m] - learning_rate[m] * m_hat / (std::sqrt(v_hat) + epsilon);
+                gr[m] = 0.0;   // Sekalian zero_grad buat langkah berikut nya //
+            }
+        }
+    }
+
+    // Forward semua layer untuk model [m0, m1), output nya di aktivasi.back() //
+    void forward_range(const Tensor& X, dl::index_t batch, dl::index_t m0, dl::index_t m1) {
+        for (size_t i = 0; i < layers.size(); ++i) {
+            const LayerBatch& L = layers[i];
+            double* out = aktivasi[i + 1].data();
+            if (L.jenis == JenisLayer::DENSE) {
+                if (i == 0) {
+                    forward_dense<true>(L, X.data_ptr(), out, batch, m0, m1);
+                } else {
+                    forward_dense<false>(L, aktivasi[i].data(), out, batch, m0, m1);
+                }
+                continue;
+            }
+            // Aktivasi, layer pertama yang aktivasi gak di dukung (X nya gak punya sumbu model) //
+            const double* in = aktivasi[i].data();
+            for (dl::index_t r = 0; r < batch * L.out; ++r) {
+                const double* ir = in + r * M;
+                double* orow = out + r * M;
+                if (L.jenis == JenisLayer::RELU) {
+                    for (dl::index_t m = m0; m < m1; ++m) orow[m] = std::max(0.0, ir[m]);
+                } else {
+                    dl::fastmath::sigmoid(ir + m0, orow + m0, m1 - m0);
+                }
+            }
+        }
+    }
+
+    // Satu langkah lengkap untuk model [m0, m1), loss per model di tulis ke loss[m] //
+    void langkah_range(const Tensor& X, const Tensor& y, dl::index_t batch, double koreksi1, double koreksi2,
+                       double* loss, dl::index_t m0, dl::index_t m1) {
+        forward_range(X, batch, m0, m1);
+
+        // Binary Cross Entropy, loss dan gradient nya sama dengan BinaryCrossEnrtopy //
+        const double eps = 1e-7;
+        const dl::index_t out = fitur_terakhir;
+        const double* pred = aktivasi.back().data();
+        double* g = grad_a.data();
+        for (dl::index_t m = m0; m < m1; ++m) loss[m] = 0.0;
+        for (dl::index_t r = 0; r < batch * out; ++r) {
+            const double yv = y[r];
+            const double* pr = pred + r * M;
+            double* gr = g + r * M;
+            for (dl::index_t m = m0; m < m1; ++m) {
+                const double p = std::max(eps, std::min(1.0 - eps, pr[m]));
+                loss[m] += -(yv * dl::fastmath::log(p) + (1.0 - yv) * dl::fastmath::log(1.0 - p));
+                gr[m] = (p - yv) / (p * (1.0 - p));
+            }
+        }
+        for (dl::index_t m = m0; m < m1; ++m) loss[m] /= static_cast<double>(batch * out);
+
+        // Backward dari layer terakhir //
+        double* g_sekarang = grad_a.data();
+        double* g_berikut = grad_b.data();
+        for (size_t i = layers.size(); i-- > 0;) {
+            LayerBatch& L = layers[i];
+            if (L.jenis == JenisLayer::DENSE) {
+                if (i == 0) {
+                    backward_dense<true>(L, X.data_ptr(), g_sekarang, nullptr, batch, m0, m1);
+                } else {
+                    backward_dense<false>(L, aktivasi[i].data(), g_sekarang, g_berikut, batch, m0, m1);
+                    std::swap(g_sekarang, g_berikut);
+                }
+                continue;
+            }
+            // Aktivasi: in-place di buffer gradient //
+            for (dl::index_t r = 0; r < batch * L.out; ++r) {
+                double* gr = g_sekarang + r * M;
+                if (L.jenis == JenisLayer::RELU) {
+                    const double* ir = aktivasi[i].data() + r * M;
+                    for (dl::index_t m = m0; m < m1; ++m) gr[m] = gr[m] * ((ir[m] > 0) ? 1.0 : 0.0);
+                } else {
+                    const double* sr = aktivasi[i + 1].data() + r * M;
+                    for (dl::index_t m = m0; m < m1; ++m) gr[m] = gr[m] * (sr[m] * (1.0 - sr[m]));
+                }
+            }
+        }
+
+        // Adam, urutan parameter per model sama kek NeuralNetwork (bobot lalu bias per Dense) //
+        for (auto& L : layers) {
+            if (L.jenis != JenisLayer::DENSE) continue;
+            adam(L.bobot.data(), L.m_bobot.data(), L.v_bobot.data(), L.grad_bobot.data(), L.out * L.in,
+                 koreksi1, koreksi2, m0, m1);
+            adam(L.bias.data(), L.m_bias.data(), L.v_bias.data(), L.grad_bias.data(), L.out,
+                 koreksi1, koreksi2, m0, m1);
+        }
+    }
+
+    void siapkan_buffer(dl::index_t batch) {
+        DL_MEMORY_TAG("ModelBatch::aktivasi");
+        aktivasi.resize(layers.size() + 1);
+        dl::index_t maks = 0;
+        for (size_t i = 0; i < layers.size(); ++i) {
+            const size_t n = static_cast<size_t>(batch * layers[i].out * M);
+            if (aktivasi[i + 1].size() != n) aktivasi[i + 1].assign(n, 0.0);
+            maks = std::max(maks, std::max(layers[i].in, layers[i].out));
+        }
+        const size_t n_grad = static_cast<size_t>(batch * maks * M);
+        if (grad_a.size() != n_grad) {
+            grad_a.assign(n_grad, 0.0);
+            grad_b.assign(n_grad, 0.0);
+        }
+    }
+
+public:
+    // M model, semua dengan learning rate yang sama, seed model m = seed_awal + m //
+    explicit ModelBatch(dl::index_t jumlah_model, double lr = 0.001, uint64_t seed_awal = 0)
+        : M(jumlah_model), learning_rate(jumlah_model, lr), seed(jumlah_model), offset_random(jumlah_model, 0) {
+        assert(M > 0 && "ModelBatch butuh minimal satu model");
+        for (dl::index_t m = 0; m < M; ++m) seed[m] = seed_awal + static_cast<uint64_t>(m);
+    }
+
+    // Learning rate dan seed per model //
+    ModelBatch(const std::vector<double>& lr, const std::vector<uint64_t>& seeds)
+        : M(static_cast<dl::index_t>(lr.size())), learning_rate(lr), seed(seeds), offset_random(lr.size(), 0) {
+        assert(M > 0 && lr.size() == seeds.size() && "Jumlah learning rate dan seed harus sama");
+    }
+
+    /*
+    Tambah Dense, bobot model m di ambil dari generator Philox dengan seed[m],
+    lanjut dari posisi setelah layer sebelum nya. Generator global nya di kembalikan lagi.
+    */
+    void tambah_dense(dl::index_t in_features, dl::index_t out_features) {
+        DL_MEMORY_TAG("ModelBatch::parameter");
+        assert((fitur_terakhir < 0 || fitur_terakhir == in_features) && "in_features harus sama dengan output layer sebelum nya");
+        LayerBatch L;
+        L.jenis = JenisLayer::DENSE;
+        L.in = in_features;
+        L.out = out_features;
+        const size_t n_w = static_cast<size_t>(out_features * in_features * M);
+        const size_t n_b = static_cast<size_t>(out_features * M);
+        L.bobot.assign(n_w, 0.0);
+        L.bias.assign(n_b, 0.0);
+        L.grad_bobot.assign(n_w, 0.0);
+        L.grad_bias.assign(n_b, 0.0);
+        L.m_bobot.assign(n_w, 0.0);
+        L.v_bobot.assign(n_w, 0.0);
+        L.m_bias.assign(n_b, 0.0);
+        L.v_bias.assign(n_b, 0.0);
+
+        auto& gen = dl::random::generator();
+        const uint64_t seed_lama = gen.dapatkan_seed();
+        const uint64_t offset_lama = gen.dapatkan_offset();
+        for (dl::index_t m = 0; m < M; ++m) {
+            gen.seed(seed[m]);
+            gen.atur_offset(offset_random[m]);
+            Tensor w = dl::kaiming_normal({out_features, in_features});
+            offset_random[m] = gen.dapatkan_offset();
+            for (dl::index_t i = 0; i < out_features * in_features; ++i) {
+                L.bobot[i * M + m] = w[i];
+            }
+        }
+        gen.seed(seed_lama);
+        gen.atur_offset(offset_lama);
+
+        layers.push_back(std::move(L));
+        fitur_terakhir = out_features;
+    }
+
+    void tambah_relu() { tambah_aktivasi(JenisLayer::RELU); }
+    void tambah_sigmoid() { tambah_aktivasi(JenisLayer::SIGMOID); }
+
+private:
+    void tambah_aktivasi(JenisLayer jenis) {
+        assert(!layers.empty() && "Layer pertama ModelBatch harus Dense");
+        LayerBatch L;
+        L.jenis = jenis;
+        L.in = fitur_terakhir;
+        L.out = fitur_terakhir;
+        layers.push_back(std::move(L));
+    }
+
+public:
+    /*
+    Satu langkah training semua model: forward, Binary Cross Entropy, backward, Adam.
+    Return loss rata-rata per model.
+    */
+    std::vector<double> train_step(const Tensor& X, const Tensor& y) {
+        DL_PROFILE("ModelBatch::train_step", static_cast<uint64_t>(M) * X.get_shape()[0]);
+        assert(!layers.empty() && layers[0].jenis == JenisLayer::DENSE && "Layer pertama ModelBatch harus Dense");
+        assert(X.get_shape()[1] == layers[0].in && "Kolom X harus sama dengan in_features layer pertama");
+        const dl::index_t batch = X.get_shape()[0];
+        assert(y.numel() == batch * fitur_terakhir && "Ukuran y harus [batch, out_features]");
+        siapkan_buffer(batch);
+
+        ++t;
+        const double koreksi1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+        const double koreksi2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+
+        std::vector<double> loss(static_cast<size_t>(M));
+        dl::parallel_for(0, M, GRAIN_MODEL, [&](dl::index_t m0, dl::index_t m1) {
+            langkah_range(X, y, batch, koreksi1, koreksi2, loss.data(), m0, m1);
+        });
+        return loss;
+    }
+
+    // Training beberapa epoch, verbose nya nampilin loss rata-rata, terbaik, dan terburuk //
+    void train(const Tensor& X, const Tensor& y, int epochs = 100, bool verbose = true) {
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            std::vector<double> loss = train_step(X, y);
+            if (verbose && (epoch + 1) % 10 == 0) {
+                double rata = 0.0;
+                for (double l : loss) rata += l;
+                rata /= static_cast<double>(M);
+                std::cout << "Epoch " << (epoch + 1) << "/" << epochs << " - Loss rata-rata: " << rata
+                          << " (terbaik " << *std::min_element(loss.begin(), loss.end())
+                          << ", terburuk " << *std::max_element(loss.begin(), loss.end()) << ")" << std::endl;
+            }
+        }
+    }
+
+    // Prediksi semua model, output [M, batch, out_features] //
+    Tensor predict(const Tensor& X) {
+        DL_MEMORY_TAG("ModelBatch::predict");
+        const dl::index_t batch = X.get_shape()[0];
+        siapkan_buffer(batch);
+        dl::parallel_for(0, M, GRAIN_MODEL, [&](dl::index_t m0, dl::index_t m1) {
+            forward_range(X, batch, m0, m1);
+        });
+        Tensor out({M, batch, fitur_terakhir});
+        const double* a = aktivasi.back().data();
+        for (dl::index_t m = 0; m < M; ++m) {
+            for (dl::index_t r = 0; r < batch * fitur_terakhir; ++r) {
+                out[m * batch * fitur_terakhir + r] = a[r * M + m];
+            }
+        }
+        return out;
+    }
+
+    // Bobot Dense ke-i (dihitung dari Dense saja) milik model m, shape [out, in] //
+    Tensor dapatkan_bobot(size_t dense_ke, dl::index_t m) const {
+        const LayerBatch& L = dense(dense_ke);
+        Tensor w({L.out, L.in});
+        for (dl::index_t i = 0; i < L.out * L.in; ++i) w[i] = L.bobot[i * M + m];
+        return w;
+    }
+
+    Tensor dapatkan_bias(size_t dense_ke, dl::index_t m) const {
+        const LayerBatch& L = dense(dense_ke);
+        Tensor b({L.out});
+        for (dl::index_t i = 0; i < L.out; ++i) b[i] = L.bias[i * M + m];
+        return b;
+    }
+
+    const LayerBatch& dense(size_t dense_ke) const {
+        for (const auto& L : layers) {
+            if (L.jenis == JenisLayer::DENSE && dense_ke-- == 0) return L;
+        }
+        assert(false && "Dense ke-i gak ada");
+        return layers.front();
+    }
+
+    dl::index_t jumlah_model() const { return M; }
+    long long langkah() const { return t; }
+    double dapatkan_learning_rate(dl::index_t m) const { return learning_rate[m]; }
+    void atur_learning_rate(dl::index_t m, double lr) { learning_rate[m] = lr; }
+    uint64_t dapatkan_seed(dl::index_t m) const { return seed[m]; }
+
+    // Jumlah parameter satu model //
+    dl::index_t num_parameters() const {
+        dl::index_t n = 0;
+        for (const auto& L : layers) {
+            if (L.jenis == JenisLayer::DENSE) n += L.out * L.in + L.out;
+        }
+        return n;
+    }
+};
+
+#endif
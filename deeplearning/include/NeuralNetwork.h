@@ -7,50 +7,300 @@
 #include "Sigmoid.h"
 #include "ReLu.h"
 #include "Dense.h"
-#include "Adam.h"
+#include "Dropout.h"
+#include "Normalization.h"
+#include "SparseTensor.h"
+#include "Optimizer.h"
 #include "Loss.h"
+#include "Autograd.h"
+#include "Snapshot.h"
+#include "Reduction.h"
 #include <vector>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
 
 /*
 Neural Network Class
 Ini adalah kelas utama untuk membuat dan melatih neural network.
 Cara kerja nya:
-1. Tambah layer-layer (Dense, ReLU, Sigmoid)
+1. Tambah layer-layer (Dense, ReLU, Sigmoid, Dropout, BatchNorm, LayerNorm)
 2. Forward pass: input -> layer1 -> layer2 -> ... -> output
 3. Backward pass: hitung gradient dari loss ke setiap layer
-4. Update bobot dengan Adam optimizer
+4. Update bobot dengan optimizer (default Adam, bisa di ganti, lihat Optimizer.h)
+
+Loss nya Binary Cross Entropy (output Sigmoid), kecuali layer terakhir nya
+SoftmaxCrossEntropy (tambah_softmax_cross_entropy), buat klasifikasi banyak kelas.
+
+Mode training / inferensi (atur_training): Dropout cuma aktif pas training,
+BatchNorm pakai statistik batch pas training dan running stats pas inferensi.
+predict() selalu jalan sebagai inferensi.
+
+Snapshot state training (atur_snapshot / lanjutkan_dari, lihat Snapshot.h):
+bobot, state optimizer, dan posisi random di salin tiap k langkah lalu di tulis di thread background,
+training nya bisa di lanjut bit-exact dari file itu.
+
+Habis training, bekukan_untuk_inferensi() melipat BatchNorm yang tepat setelah Dense
+ke bobot dan bias Dense nya, jadi layer BatchNorm nya hilang dari jalur forward.
 */
 
 // Enum untuk jenis layer //
 enum class LayerType {
     DENSE,
     RELU,
-    SIGMOID
+    SIGMOID,
+    DROPOUT,
+    BATCH_NORM,
+    LAYER_NORM,
+    SOFTMAX_CROSS_ENTROPY   // Kepala klasifikasi banyak kelas, wajib layer terakhir //
 };
 
 // Struct untuk menyimpan informasi layer //
 struct LayerInfo {
     LayerType type;
-    int dense_index;  // Index ke vector dense_layers jika type == DENSE //
+    // Index ke vector dense_layers jika type == DENSE, dropout_layers jika DROPOUT, //
+    // batchnorm_layers jika BATCH_NORM, layernorm_layers jika LAYER_NORM //
+    int dense_index;
+};
+
+// Statistik gradient checkpointing, biar trade-off compute vs memori nya kelihatan //
+struct StatistikCheckpoint {
+    long long layer_dihitung_ulang = 0;   // Total layer yang di forward ulang //
+    long long layer_forward = 0;          // Total layer yang di forward biasa //
+    double waktu_forward_ms = 0.0;
+    double waktu_recompute_ms = 0.0;
+    long long bytes_aktivasi = 0;         // Aktivasi yang di simpan setelah forward terakhir //
+    long long bytes_aktivasi_puncak = 0;  // Puncak aktivasi tersimpan (setelah forward atau recompute) //
+    
+    // Persentase compute tambahan dari recompute //
+    double overhead_compute() const {
+        return waktu_forward_ms > 0.0 ? 100.0 * waktu_recompute_ms / waktu_forward_ms : 0.0;
+    }
 };
 
 class NeuralNetwork {
 private:
     std::vector<Dense> dense_layers;       // Semua Dense layers //
+    std::vector<Dropout> dropout_layers;   // Semua Dropout layers //
+    std::vector<BatchNorm> batchnorm_layers;
+    std::vector<LayerNorm> layernorm_layers;
     std::vector<LayerInfo> layer_order;    // Urutan layer //
-    std::vector<adam> optimizers;          // Adam optimizer untuk setiap Dense layer //
+    
+    // Satu optimizer buat semua layer, state nya contiguous di dalam optimizer //
+    std::unique_ptr<dl::optim::Optimizer> optimizer;
+    // Id slot optimizer (bobot, bias) untuk setiap Dense layer, bias = -1 kalau gak pakai bias //
+    std::vector<std::pair<int, int>> slot_optimizer;
+    // Id slot optimizer (gamma, beta) untuk setiap BatchNorm dan LayerNorm //
+    std::vector<std::pair<int, int>> slot_batchnorm;
+    std::vector<std::pair<int, int>> slot_layernorm;
     
     // Cache untuk backward pass //
-    std::vector<Tensor> activations;       // Menyimpan output setiap layer //
-    std::vector<Tensor> pre_activations;   // Menyimpan output sebelum aktivasi (untuk ReLU backward) //
+    // activations[i] = input layer i, activations[i+1] = output layer i //
+    std::vector<Tensor> activations;
+    
+    // Input sparse forward terakhir, activations[0] nya di biarkan kosong //
+    // Cuma boleh kalau layer pertama nya Dense //
+    SparseTensor input_sparse;
+    bool pakai_input_sparse = false;
+    
+    // Gradient checkpointing //
+    int checkpoint_setiap = 0;             // Simpan aktivasi setiap k layer (0 = mati) //
+    std::vector<int> checkpoint_layer;     // Atau daftar layer checkpoint pilihan user //
+    StatistikCheckpoint statistik_ckpt;
     
     double learning_rate;
+    
+    // Presisi penyimpanan bobot dan cache aktivasi Dense (lihat Half.h) //
+    dl::Presisi presisi = dl::Presisi::FP64;
+    
+    // Kalau true, training pakai tape autograd bukan backward manual //
+    bool pakai_autograd = false;
+    
+    // Mode training (Dropout aktif) atau inferensi //
+    bool mode_training = true;
+    
+    // true setelah bekukan_untuk_inferensi, network nya gak bisa di latih lagi //
+    bool beku = false;
+    
+    // Jumlah langkah optimizer yang sudah jalan //
+    long long langkah_training = 0;
+    
+    // Gradient accumulation: optimizer cuma melangkah setiap akumulasi_setiap micro-batch //
+    int akumulasi_setiap = 1;
+    int micro_terkumpul = 0;          // Micro-batch di jendela yang sekarang //
+    double jumlah_loss_micro = 0.0;   // sum(loss rata-rata micro-batch * jumlah elemen loss nya) //
+    double elemen_micro = 0.0;
+    double loss_efektif = 0.0;        // Loss rata-rata jendela terakhir yang sudah selesai //
+    
+    // Hook data-parallel (lihat Distributed.h) //
+    std::function<void(size_t)> hook_gradient_siap;   // Gradient layer ke-i sudah final //
+    std::function<void()> hook_sebelum_optimizer;     // Tunggu semua gradient selesai di olah //
+    
+    // Snapshot berkala: setiap snapshot_setiap langkah, state nya di tulis async ke path_snapshot //
+    int snapshot_setiap = 0;
+    std::string path_snapshot;
+    std::unique_ptr<dl::snapshot::PenulisAsync> penulis_snapshot;
+    
+    // Layer yang jadi no-op di mode sekarang, di lewati tanpa copy sama sekali //
+    bool layer_dilewati(size_t i) const {
+        return !mode_training && layer_order[i].type == LayerType::DROPOUT;
+    }
+    
+    // Batas segmen checkpoint, selalu di mulai 0 dan di akhiri jumlah layer //
+    std::vector<size_t> batas_segmen() const {
+        const size_t L = layer_order.size();
+        std::vector<size_t> batas;
+        batas.push_back(0);
+        if (checkpoint_setiap > 0) {
+            for (size_t i = checkpoint_setiap; i < L; i += checkpoint_setiap) {
+                batas.push_back(i);
+            }
+        } else {
+            for (int c : checkpoint_layer) {
+                if (c > 0 && static_cast<size_t>(c) < L) {
+                    batas.push_back(c);
+                }
+            }
+        }
+        batas.push_back(L);
+        batas.erase(std::unique(batas.begin(), batas.end()), batas.end());
+        return batas;
+    }
+    
+    // Hitung ulang aktivasi di dalam segmen [awal, akhir) dari checkpoint activations[awal] //
+    void hitung_ulang_segmen(size_t awal, size_t akhir) {
+        DL_MEMORY_TAG("NeuralNetwork::recompute");
+        DL_PROFILE("NeuralNetwork::recompute", akhir - awal);
+        auto t0 = std::chrono::steady_clock::now();
+        
+        Tensor current = activations[awal];
+        for (size_t i = awal; i < akhir; ++i) {
+            if (!layer_dilewati(i)) {
+                current = forward_layer(i, current, true);
+            }
+            // activations[akhir] itu checkpoint segmen berikut nya, sudah ada //
+            if (i + 1 < akhir) {
+                activations[i + 1] = current;
+            }
+        }
+        
+        statistik_ckpt.layer_dihitung_ulang += akhir - awal;
+        statistik_ckpt.waktu_recompute_ms +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        long long bytes = bytes_aktivasi_tersimpan();
+        if (bytes > statistik_ckpt.bytes_aktivasi_puncak) {
+            statistik_ckpt.bytes_aktivasi_puncak = bytes;
+        }
+    }
+    
+    // Total bytes aktivasi yang lagi di simpan (termasuk cache input Dense) //
+    long long bytes_aktivasi_tersimpan() const {
+        long long bytes = 0;
+        for (const auto& a : activations) {
+            bytes += static_cast<long long>(a.numel()) * sizeof(double);
+        }
+        for (const auto& d : dense_layers) {
+            bytes += d.bytes_cache();
+        }
+        for (const auto& d : dropout_layers) {
+            bytes += d.bytes_cache();
+        }
+        for (const auto& n : batchnorm_layers) {
+            bytes += n.bytes_cache();
+        }
+        for (const auto& n : layernorm_layers) {
+            bytes += n.bytes_cache();
+        }
+        if (pakai_input_sparse) {
+            bytes += input_sparse.bytes();
+        }
+        return bytes;
+    }
+
+    // Daftarkan bobot dan bias satu Dense ke optimizer, bias gak kena weight decay //
+    std::pair<int, int> daftar_ke_optimizer(const Dense& d) {
+        int id_bobot = optimizer->daftar_parameter(d.dapatkan_bobot().numel(), true);
+        int id_bias = d.has_bias() ? optimizer->daftar_parameter(d.dapatkan_bias().numel(), false) : -1;
+        return {id_bobot, id_bias};
+    }
+    
+    // Daftarkan gamma dan beta layer normalisasi, dua-dua nya gak kena weight decay //
+    std::pair<int, int> daftar_normalisasi(dl::index_t fitur) {
+        int id_gamma = optimizer->daftar_parameter(fitur, false);
+        int id_beta = optimizer->daftar_parameter(fitur, false);
+        return {id_gamma, id_beta};
+    }
+    
+    /*
+    Semua jalur training lewat sini dulu. Bukan assert: setelah bekukan_untuk_inferensi
+    BatchNorm nya sudah di lipat ke Dense, training lagi bakal ngupdate bobot yang artinya sudah beda.
+    */
+    void pastikan_belum_beku(const char* fungsi) const {
+        if (beku) {
+            throw std::logic_error(std::string(fungsi) +
+                                   ": network sudah di bekukan untuk inferensi, gak bisa di latih lagi");
+        }
+    }
+    
+    // Lepas cache layer i yang punya cache sendiri (Dense, BatchNorm, LayerNorm) //
+    void lepas_cache_layer(size_t i) {
+        const LayerInfo& info = layer_order[i];
+        if (info.type == LayerType::DENSE) {
+            dense_layers[info.dense_index].lepas_cache();
+        } else if (info.type == LayerType::BATCH_NORM) {
+            batchnorm_layers[info.dense_index].lepas_cache();
+        } else if (info.type == LayerType::LAYER_NORM) {
+            layernorm_layers[info.dense_index].lepas_cache();
+        }
+    }
 
 public:
     // Constructor //
-    NeuralNetwork(double lr = 0.001) : learning_rate(lr) {}
+    // Default nya Adam (AdamW tanpa weight decay), sama kek dulu //
+    NeuralNetwork(double lr = 0.001) : optimizer(dl::optim::adam(lr)), learning_rate(lr) {}
+    
+    // Constructor dengan optimizer pilihan, misal NeuralNetwork(dl::optim::lamb(0.01)) //
+    explicit NeuralNetwork(std::unique_ptr<dl::optim::Optimizer> opt)
+        : optimizer(std::move(opt)), learning_rate(optimizer->dapatkan_learning_rate()) {}
+    
+    // Ganti optimizer, semua parameter di daftarkan ulang (state nya mulai dari nol) //
+    void atur_optimizer(std::unique_ptr<dl::optim::Optimizer> opt) {
+        optimizer = std::move(opt);
+        learning_rate = optimizer->dapatkan_learning_rate();
+        slot_optimizer.clear();
+        for (const auto& d : dense_layers) {
+            slot_optimizer.push_back(daftar_ke_optimizer(d));
+        }
+        slot_batchnorm.clear();
+        for (const auto& n : batchnorm_layers) {
+            slot_batchnorm.push_back(daftar_normalisasi(n.dapatkan_fitur()));
+        }
+        slot_layernorm.clear();
+        for (const auto& n : layernorm_layers) {
+            slot_layernorm.push_back(daftar_normalisasi(n.dapatkan_fitur()));
+        }
+    }
+    
+    const dl::optim::Optimizer& dapatkan_optimizer() const { return *optimizer; }
+    
+    /*
+    Mixed precision: bobot dan cache aktivasi Dense di simpan BF16/FP16, akumulasi fp32,
+    bobot master double tetap di update optimizer. Cuma berlaku di jalur backward manual,
+    jalur autograd tetap pakai bobot master.
+    */
+    void atur_presisi(dl::Presisi p) {
+        presisi = p;
+        for (auto& d : dense_layers) {
+            d.atur_presisi(p);
+        }
+    }
     
     // Factory method untuk membuat neural network //
     static NeuralNetwork membuat_neural(double learning_rate = 0.001) {
@@ -58,11 +308,14 @@ public:
     }
     
     // Tambah Dense layer //
-    void tambah_dense(int in_features, int out_features, bool gunakan_bias = true) {
+    void tambah_dense(dl::index_t in_features, dl::index_t out_features, bool gunakan_bias = true) {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
         dense_layers.push_back(Dense(in_features, out_features, gunakan_bias));
+        dense_layers.back().atur_presisi(presisi);
+        dense_layers.back().atur_akumulasi_grad(akumulasi_setiap > 1);
         
-        // Buat optimizer untuk layer ini //
-        optimizers.push_back(adam(learning_rate));
+        // Daftarkan parameter layer ini ke optimizer //
+        slot_optimizer.push_back(daftar_ke_optimizer(dense_layers.back()));
         
         // Simpan urutan layer //
         LayerInfo info;
@@ -73,6 +326,7 @@ public:
     
     // Tambah ReLU activation //
     void tambah_relu() {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
         LayerInfo info;
         info.type = LayerType::RELU;
         info.dense_index = -1;  // Tidak relevan untuk aktivasi //
@@ -81,137 +335,607 @@ public:
     
     // Tambah Sigmoid activation //
     void tambah_sigmoid() {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
         LayerInfo info;
         info.type = LayerType::SIGMOID;
         info.dense_index = -1;  // Tidak relevan untuk aktivasi //
         layer_order.push_back(info);
     }
     
+    // Tambah Dropout dengan peluang buang p, cuma aktif di mode training //
+    void tambah_dropout(double p = 0.5) {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
+        dropout_layers.push_back(Dropout(p));
+        LayerInfo info;
+        info.type = LayerType::DROPOUT;
+        info.dense_index = dropout_layers.size() - 1;
+        layer_order.push_back(info);
+    }
+    
+    /*
+    Tambah BatchNorm over batch untuk input [batch, fitur].
+    running_mean / running_var nya di update pakai momentum setiap forward training.
+    */
+    void tambah_batch_norm(dl::index_t fitur, double momentum = 0.1, double eps = 1e-5) {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
+        batchnorm_layers.push_back(BatchNorm(fitur, momentum, eps));
+        slot_batchnorm.push_back(daftar_normalisasi(fitur));
+        LayerInfo info;
+        info.type = LayerType::BATCH_NORM;
+        info.dense_index = batchnorm_layers.size() - 1;
+        layer_order.push_back(info);
+    }
+    
+    // Tambah LayerNorm (normalisasi per sampel di sepanjang fitur) //
+    void tambah_layer_norm(dl::index_t fitur, double eps = 1e-5) {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
+        layernorm_layers.push_back(LayerNorm(fitur, eps));
+        slot_layernorm.push_back(daftar_normalisasi(fitur));
+        LayerInfo info;
+        info.type = LayerType::LAYER_NORM;
+        info.dense_index = layernorm_layers.size() - 1;
+        layer_order.push_back(info);
+    }
+    
+    // Mode training (true) atau inferensi (false), Dropout jadi no-op di inferensi //
+    void atur_training(bool nilai = true) {
+        mode_training = nilai;
+    }
+    
+    bool sedang_training() const {
+        return mode_training;
+    }
+    
+    /*
+    Tambah kepala Softmax + Categorical Cross Entropy (harus layer terakhir).
+    Target nya label integer [batch] atau [batch, 1], bukan one-hot.
+    Pas training, output forward nya tetap logits dan loss nya di hitung fused,
+    jadi probabilitas nya gak pernah di buat. predict() yang nge-softmax output nya.
+    */
+    void tambah_softmax_cross_entropy() {
+        assert(!kepala_softmax() && "Softmax cross entropy harus layer terakhir");
+        LayerInfo info;
+        info.type = LayerType::SOFTMAX_CROSS_ENTROPY;
+        info.dense_index = -1;
+        layer_order.push_back(info);
+    }
+    
+    // Apakah layer terakhir nya kepala softmax cross entropy //
+    bool kepala_softmax() const {
+        return !layer_order.empty() && layer_order.back().type == LayerType::SOFTMAX_CROSS_ENTROPY;
+    }
+    
+    // FORWARD SATU LAYER //
+    // Dipakai forward biasa dan juga recompute gradient checkpointing (ulang = true) //
+    Tensor forward_layer(size_t i, const Tensor& current, bool ulang = false) {
+        const LayerInfo& info = layer_order[i];
+        
+        switch (info.type) {
+            case LayerType::DENSE:
+                // Dense layer: output = input @ W^T + bias //
+                // Layer pertama dengan input sparse ambil input nya langsung dari input_sparse //
+                if (i == 0 && pakai_input_sparse) {
+                    return dense_layers[info.dense_index].forward(input_sparse);
+                }
+                return dense_layers[info.dense_index].forward(current);
+            case LayerType::RELU:
+                // ReLU: max(0, x) //
+                return ReLu::forward(current);
+            case LayerType::SIGMOID:
+                // Sigmoid: 1 / (1 + exp(-x)) //
+                return Sigmoid::forward(current);
+            case LayerType::DROPOUT:
+                // Recompute wajib pakai mask yang sama dengan forward nya //
+                if (ulang) {
+                    return dropout_layers[info.dense_index].forward_ulang(current);
+                }
+                return dropout_layers[info.dense_index].forward(current);
+            case LayerType::BATCH_NORM:
+                // Recompute pakai statistik batch yang sama, tapi running stats nya gak di update lagi //
+                return batchnorm_layers[info.dense_index].forward(current, mode_training, !ulang);
+            case LayerType::LAYER_NORM:
+                return layernorm_layers[info.dense_index].forward(current);
+            case LayerType::SOFTMAX_CROSS_ENTROPY:
+                // Logits di terusin apa ada nya, softmax nya fused di loss //
+                return current;
+        }
+        return current;
+    }
+    
     // FORWARD PASS //
     // Input melewati semua layer secara berurutan //
+    /*
+    activations[i] adalah input layer i, dan activations[i+1] output nya.
+    Kalau gradient checkpointing aktif, yang di simpan cuma aktivasi di batas segmen
+    (plus segmen terakhir, karna backward langsung mulai dari situ).
+    Sisa nya di kosongkan dan cache input Dense nya di lepas, nanti di hitung ulang pas backward.
+    */
     Tensor forward(const Tensor& input) {
+        input_sparse = SparseTensor();
+        pakai_input_sparse = false;
+        return forward_dari_input(input);
+    }
+    
+    // Forward dengan input sparse (CSR), layer pertama wajib Dense //
+    Tensor forward(const SparseTensor& input) {
+        assert(!layer_order.empty() && layer_order[0].type == LayerType::DENSE &&
+               "Input sparse butuh Dense sebagai layer pertama");
+        {
+            DL_MEMORY_TAG("NeuralNetwork::cache_aktivasi");
+            input_sparse = input;
+        }
+        pakai_input_sparse = true;
+        return forward_dari_input(Tensor());
+    }
+    
+private:
+    Tensor forward_dari_input(const Tensor& input) {
+        DL_MEMORY_TAG("NeuralNetwork::cache_aktivasi");
+        auto t0 = std::chrono::steady_clock::now();
+        
         // Bersihkan cache //
-        activations.clear();
-        pre_activations.clear();
+        const size_t L = layer_order.size();
+        activations.assign(L + 1, Tensor());
         
         // Simpan input sebagai aktivasi pertama //
-        activations.push_back(input);
+        activations[0] = input;
+        
+        std::vector<size_t> batas = batas_segmen();
+        size_t awal_segmen_terakhir = batas.size() >= 2 ? batas[batas.size() - 2] : 0;
         
         Tensor current = input;
         
         // Lewati setiap layer //
+        for (size_t i = 0; i < L; ++i) {
+            if (!layer_dilewati(i)) {
+                current = forward_layer(i, current);
+            }
+            
+            // Simpan output layer ini kalau perlu //
+            bool simpan = (i + 1 >= awal_segmen_terakhir) ||
+                          std::binary_search(batas.begin(), batas.end(), i + 1);
+            if (simpan) {
+                activations[i + 1] = current;
+            }
+            // Layer di luar segmen terakhir nanti di hitung ulang, termasuk layer tepat sebelum batas, //
+            // jadi yang di simpan di batas cuma tensor aktivasi nya, cache layer nya tetap di lepas //
+            if (i < awal_segmen_terakhir) {
+                lepas_cache_layer(i);
+            }
+        }
+        
+        statistik_ckpt.layer_forward += L;
+        statistik_ckpt.waktu_forward_ms +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        statistik_ckpt.bytes_aktivasi = bytes_aktivasi_tersimpan();
+        if (statistik_ckpt.bytes_aktivasi > statistik_ckpt.bytes_aktivasi_puncak) {
+            statistik_ckpt.bytes_aktivasi_puncak = statistik_ckpt.bytes_aktivasi;
+        }
+        
+        return current;
+    }
+
+public:
+    
+    // Nyalakan atau matikan mode autograd //
+    void gunakan_autograd(bool nilai = true) {
+        pakai_autograd = nilai;
+    }
+    
+    // FORWARD PASS AUTOGRAD //
+    // Sama kek forward biasa, tapi semua operasi di rekam di tape //
+    // Gak ada cache aktivasi di sini, yang nyimpen tensor buat backward itu tape nya //
+    Tensor forward_autograd(const Tensor& input) {
+        Tensor current = input;
+        
         for (size_t i = 0; i < layer_order.size(); ++i) {
             const LayerInfo& info = layer_order[i];
             
             switch (info.type) {
-                case LayerType::DENSE: {
-                    // Dense layer: output = input @ W^T + bias //
-                    pre_activations.push_back(current);  // Simpan sebelum forward //
-                    current = dense_layers[info.dense_index].forward(current);
+                case LayerType::DENSE:
+                    current = dense_layers[info.dense_index].forward_autograd(current);
                     break;
-                }
-                case LayerType::RELU: {
-                    // ReLU: max(0, x) //
-                    pre_activations.push_back(current);  // Simpan sebelum aktivasi //
-                    current = ReLu::forward(current);
+                case LayerType::RELU:
+                    current = dl::autograd::relu(current);
                     break;
-                }
-                case LayerType::SIGMOID: {
-                    // Sigmoid: 1 / (1 + exp(-x)) //
-                    pre_activations.push_back(current);  // Simpan sebelum aktivasi //
-                    current = Sigmoid::forward(current);
+                case LayerType::SIGMOID:
+                    current = dl::autograd::sigmoid(current);
+                    break;
+                case LayerType::DROPOUT:
+                    if (mode_training) {
+                        current = dl::autograd::dropout(current, dropout_layers[info.dense_index]);
+                    }
+                    break;
+                case LayerType::BATCH_NORM:
+                    current = batchnorm_layers[info.dense_index].forward_autograd(current, mode_training);
+                    break;
+                case LayerType::LAYER_NORM:
+                    current = layernorm_layers[info.dense_index].forward_autograd(current);
+                    break;
+                case LayerType::SOFTMAX_CROSS_ENTROPY:
                     break;
-                }
             }
-            
-            // Simpan output layer ini //
-            activations.push_back(current);
         }
         
         return current;
     }
     
+    // BACKWARD SATU LAYER //
+    // activations[i] dan activations[i+1] harus sudah ada //
+    Tensor backward_layer(size_t i, const Tensor& grad) {
+        const LayerInfo& info = layer_order[i];
+        
+        switch (info.type) {
+            case LayerType::DENSE:
+                // Dense backward: hitung gradient untuk bobot dan input //
+                return dense_layers[info.dense_index].backward(grad);
+            case LayerType::RELU: {
+                // ReLU backward: grad * (1 jika x > 0, else 0) //
+                Tensor relu_grad = ReLu::backward(activations[i]);
+                return grad * relu_grad;
+            }
+            case LayerType::SIGMOID: {
+                // Sigmoid backward: grad * sigmoid(x) * (1 - sigmoid(x)) //
+                // activations[i+1] adalah output sigmoid //
+                Tensor sig_grad = Sigmoid::backward(activations[i + 1]);
+                return grad * sig_grad;
+            }
+            case LayerType::DROPOUT:
+                // Inferensi: dropout nya identitas //
+                if (!mode_training) {
+                    return grad;
+                }
+                return dropout_layers[info.dense_index].backward(grad);
+            case LayerType::BATCH_NORM:
+                return batchnorm_layers[info.dense_index].backward(grad);
+            case LayerType::LAYER_NORM:
+                return layernorm_layers[info.dense_index].backward(grad);
+            case LayerType::SOFTMAX_CROSS_ENTROPY:
+                // grad dari loss sudah softmax - onehot terhadap logits //
+                return grad;
+        }
+        return grad;
+    }
+    
     // BACKWARD PASS //
     // Menghitung gradient dari loss ke setiap layer //
+    /*
+    Backward nya jalan per segmen dari belakang.
+    Segmen yang aktivasi nya di buang pas forward di hitung ulang dulu dari checkpoint di awal segmen,
+    lalu di backward, lalu aktivasi nya di buang lagi sebelum lanjut ke segmen sebelum nya.
+    Jadi yang hidup bersamaan cuma checkpoint + satu segmen.
+    */
     void backward(const Tensor& y_pred, const Tensor& y_true) {
-        // Hitung gradient dari loss function (Binary Cross Entropy) //
-        Tensor grad = BinaryCrossEnrtopy::backward(y_pred, y_true);
+        DL_MEMORY_TAG("NeuralNetwork::backward");
+        // Hitung gradient dari loss function (Binary Cross Entropy atau Softmax Cross Entropy) //
+        Tensor grad = kepala_softmax() ? SoftmaxCrossEntropy::backward(y_pred, y_true)
+                                       : BinaryCrossEnrtopy::backward(y_pred, y_true);
         
-        // Backward melalui setiap layer (dari belakang ke depan) //
-        for (int i = layer_order.size() - 1; i >= 0; --i) {
-            const LayerInfo& info = layer_order[i];
+        std::vector<size_t> batas = batas_segmen();
+        
+        // Backward melalui setiap segmen (dari belakang ke depan) //
+        for (size_t seg = batas.size() - 1; seg >= 1; --seg) {
+            size_t awal = batas[seg - 1];
+            size_t akhir = batas[seg];
+            bool segmen_terakhir = (seg == batas.size() - 1);
             
-            switch (info.type) {
-                case LayerType::DENSE: {
-                    // Dense backward: hitung gradient untuk bobot dan input //
-                    grad = dense_layers[info.dense_index].backward(grad);
-                    break;
+            if (!segmen_terakhir) {
+                hitung_ulang_segmen(awal, akhir);
+            }
+            
+            for (size_t i = akhir; i-- > awal;) {
+                grad = backward_layer(i, grad);
+                if (hook_gradient_siap && micro_batch_terakhir()) {
+                    hook_gradient_siap(i);
                 }
-                case LayerType::RELU: {
-                    // ReLU backward: grad * (1 jika x > 0, else 0) //
-                    Tensor relu_grad = ReLu::backward(pre_activations[i]);
-                    grad = grad * relu_grad;
-                    break;
+            }
+            
+            // Lepas aktivasi segmen ini, checkpoint di awal segmen masih di pakai segmen sebelum nya //
+            if (checkpoint_aktif()) {
+                for (size_t i = awal + 1; i < akhir; ++i) {
+                    activations[i] = Tensor();
                 }
-                case LayerType::SIGMOID: {
-                    // Sigmoid backward: grad * sigmoid(x) * (1 - sigmoid(x)) //
-                    // activations[i+1] adalah output sigmoid //
-                    Tensor sig_output = activations[i + 1];
-                    Tensor sig_grad = Sigmoid::backward(sig_output);
-                    grad = grad * sig_grad;
-                    break;
+                for (size_t i = awal; i < akhir; ++i) {
+                    lepas_cache_layer(i);
                 }
             }
         }
     }
     
-    // OPTIMISASI (Adam) //
-    // Update bobot dengan Adam optimizer //
+    // GRADIENT CHECKPOINTING //
+    // Simpan aktivasi setiap k layer saja, sisa nya di hitung ulang pas backward //
+    // k = 0 artinya mati (semua aktivasi di simpan kek biasa) //
+    void atur_gradient_checkpoint(int setiap_k) {
+        checkpoint_setiap = setiap_k;
+        checkpoint_layer.clear();
+    }
+    
+    // Atau pilih sendiri layer mana yang input nya jadi checkpoint //
+    // Misal {2, 5} artinya input layer ke-2 dan ke-5 (0-based) di simpan //
+    void atur_gradient_checkpoint(const std::vector<int>& layers) {
+        checkpoint_setiap = 0;
+        checkpoint_layer = layers;
+        std::sort(checkpoint_layer.begin(), checkpoint_layer.end());
+    }
+    
+    bool checkpoint_aktif() const {
+        return checkpoint_setiap > 0 || !checkpoint_layer.empty();
+    }
+    
+    const StatistikCheckpoint& statistik_checkpoint() const {
+        return statistik_ckpt;
+    }
+    
+    void reset_statistik_checkpoint() {
+        statistik_ckpt = StatistikCheckpoint();
+    }
+    
+    // OPTIMISASI //
+    // Update bobot semua Dense layer in-place pakai optimizer //
     void optimisasi() {
+        DL_MEMORY_TAG("NeuralNetwork::optimisasi");
+        pastikan_belum_beku("optimisasi");
+        optimizer->mulai_langkah();
         for (size_t i = 0; i < dense_layers.size(); ++i) {
-            // Dapatkan bobot dan gradient dari Dense layer //
-            Tensor bobot = dense_layers[i].dapatkan_bobot();
-            Tensor grad_bobot = dense_layers[i].dapatkan_grad_bobot();
-            Tensor bias = dense_layers[i].dapatkan_bias();
-            Tensor grad_bias = dense_layers[i].dapatkan_grad_bias();
-            
-            // Update dengan Adam //
-            optimizers[i].update(bobot, grad_bobot, bias, grad_bias);
-            
-            // Set kembali bobot yang sudah di-update //
-            dense_layers[i].set_bobot(bobot);
-            dense_layers[i].set_bias(bias);
+            dense_layers[i].optimisasi(*optimizer, slot_optimizer[i].first, slot_optimizer[i].second);
+        }
+        for (size_t i = 0; i < batchnorm_layers.size(); ++i) {
+            batchnorm_layers[i].optimisasi(*optimizer, slot_batchnorm[i].first, slot_batchnorm[i].second);
+        }
+        for (size_t i = 0; i < layernorm_layers.size(); ++i) {
+            layernorm_layers[i].optimisasi(*optimizer, slot_layernorm[i].first, slot_layernorm[i].second);
         }
     }
     
     // TRAINING LOOP //
     // Satu langkah training lengkap //
     double train_step(const Tensor& input, const Tensor& target) {
-        // 1. Zero gradients //
-        zero_grad();
+        pastikan_belum_beku("train_step");
+        double loss = pakai_autograd ? train_step_autograd(input, target) : train_step_manual(input, target);
+        if (micro_terkumpul == 0) {
+            setelah_langkah();
+        }
+        return loss;
+    }
+    
+    // Satu langkah training dengan input sparse, selalu lewat backward manual //
+    double train_step(const SparseTensor& input, const Tensor& target) {
+        pastikan_belum_beku("train_step");
+        assert(!pakai_autograd && "Input sparse belum di dukung jalur autograd");
+        double loss = train_step_manual(input, target);
+        if (micro_terkumpul == 0) {
+            setelah_langkah();
+        }
+        return loss;
+    }
+    
+    long long langkah() const {
+        return langkah_training;
+    }
+    
+    /*
+    GRADIENT ACCUMULATION
+    Buat batch efektif yang aktivasi nya gak muat di memori: batch nya di potong jadi k micro-batch,
+    setiap train_step cuma forward / backward satu micro-batch dan gradient nya di tambahkan
+    ke gradient yang sudah ada, optimizer nya baru melangkah di micro-batch ke-k.
+    
+    Skala loss: gradient dari BinaryCrossEnrtopy / SoftmaxCrossEntropy di sini itu gradient dari
+    sum(loss) (gak di bagi jumlah elemen), jadi jumlah gradient k micro-batch sudah sama persis
+    dengan gradient batch gabungan nya, berapa pun ukuran micro-batch nya. Gak perlu di skala 1/k.
+    Loss yang di laporkan untuk satu langkah (loss_akumulasi) itu rata-rata per elemen
+    di semua micro-batch, jadi sama dengan loss batch gabungan.
+    
+    Hasil nya cuma sama dengan batch besar kalau gak ada layer stokastik: Dense / ReLU / Sigmoid / LayerNorm
+    per baris, jadi aman. Dropout mask nya Philox dengan counter dari generator global
+    yang maju per panggilan forward (per word 64 elemen), jadi kalau batch nya di potong elemen yang sama
+    dapat bit mask yang beda, dan loss nya juga beda dengan batch besar.
+    Biar sama, counter mask nya harus di turunkan per baris (counter = indeks baris global), bukan per panggilan.
+    BatchNorm statistik nya per micro-batch, itu juga beda dengan batch besar.
+    Langkah (snapshot berkala, langkah()) di hitung per langkah optimizer, bukan per micro-batch,
+    dan snapshot gak nyimpen gradient setengah jalan, jadi ambil snapshot di batas jendela.
+    */
+    void atur_akumulasi_gradient(int k) {
+        assert(k >= 1 && "Jumlah micro-batch per langkah minimal 1");
+        assert(micro_terkumpul == 0 && "Jendela akumulasi masih setengah jalan");
+        akumulasi_setiap = k;
+        for (auto& layer : dense_layers) {
+            layer.atur_akumulasi_grad(k > 1);
+        }
+    }
+    
+    int akumulasi_gradient() const {
+        return akumulasi_setiap;
+    }
+    
+    // Micro-batch yang gradient nya sudah terkumpul tapi belum di pakai optimizer //
+    int micro_batch_terkumpul() const {
+        return micro_terkumpul;
+    }
+    
+    // Loss rata-rata langkah optimizer terakhir (gabungan semua micro-batch nya) //
+    double loss_akumulasi() const {
+        return loss_efektif;
+    }
+    
+    // true kalau backward yang sekarang jalan itu micro-batch terakhir sebelum optimizer melangkah //
+    bool micro_batch_terakhir() const {
+        return micro_terkumpul + 1 >= akumulasi_setiap;
+    }
+    
+    /*
+    Hook gradient, di pakai DataParallel buat all-reduce sambil backward masih jalan.
+    siap(i) di panggil begitu gradient layer ke-i sudah final untuk langkah ini
+    (urutan nya dari layer terakhir ke layer pertama, cuma di micro-batch terakhir kalau akumulasi).
+    sebelum_optimizer() di panggil tepat sebelum optimizer melangkah, tempat nunggu komunikasi nya selesai.
+    Kosongkan dua-dua nya (nullptr) buat mematikan.
+    */
+    void atur_hook_gradient(std::function<void(size_t)> siap, std::function<void()> sebelum_optimizer) {
+        hook_gradient_siap = std::move(siap);
+        hook_sebelum_optimizer = std::move(sebelum_optimizer);
+    }
+    
+    // Buffer gradient parameter layer ke-i (kosong buat layer tanpa parameter) //
+    std::vector<std::pair<double*, dl::index_t>> gradient_layer(size_t i) {
+        std::vector<std::pair<double*, dl::index_t>> out;
+        const LayerInfo& info = layer_order[i];
+        switch (info.type) {
+            case LayerType::DENSE:
+                dense_layers[info.dense_index].buffer_gradient(out);
+                break;
+            case LayerType::BATCH_NORM:
+                batchnorm_layers[info.dense_index].buffer_gradient(out);
+                break;
+            case LayerType::LAYER_NORM:
+                layernorm_layers[info.dense_index].buffer_gradient(out);
+                break;
+            default:
+                break;
+        }
+        return out;
+    }
+    
+    size_t jumlah_layer() const {
+        return layer_order.size();
+    }
+    
+    // Akses read-only layer, buat nyalin bobot ke snapshot serving (lihat Online.h) //
+    const LayerInfo& info_layer(size_t i) const {
+        return layer_order[i];
+    }
+    
+    const Dense& dapatkan_dense(int k) const { return dense_layers[k]; }
+    const BatchNorm& dapatkan_batchnorm(int k) const { return batchnorm_layers[k]; }
+    const LayerNorm& dapatkan_layernorm(int k) const { return layernorm_layers[k]; }
+    dl::Presisi dapatkan_presisi() const { return presisi; }
+    
+    /*
+    Satu langkah optimizer untuk batch besar, di jalan kan per ukuran_micro baris.
+    Aktivasi yang hidup bersamaan cuma satu micro-batch. Return loss rata-rata batch besar nya.
+    */
+    double train_step_micro(const Tensor& input, const Tensor& target, dl::index_t ukuran_micro) {
+        DL_MEMORY_TAG("NeuralNetwork::micro_batch");
+        pastikan_belum_beku("train_step_micro");
+        assert(ukuran_micro > 0 && "Ukuran micro-batch harus positif");
+        const dl::index_t batch = input.get_shape()[0];
+        assert(target.get_shape()[0] == batch && "Jumlah baris input dan target harus sama");
+        const int k_lama = akumulasi_setiap;
+        atur_akumulasi_gradient(static_cast<int>((batch + ukuran_micro - 1) / ukuran_micro));
+        for (dl::index_t awal = 0; awal < batch; awal += ukuran_micro) {
+            const dl::index_t akhir = std::min(batch, awal + ukuran_micro);
+            train_step(potong_baris(input, awal, akhir), potong_baris(target, awal, akhir));
+        }
+        atur_akumulasi_gradient(k_lama);
+        return loss_efektif;
+    }
+    
+private:
+    // Baris [awal, akhir) dari Tensor (dimensi pertama nya batch) //
+    static Tensor potong_baris(const Tensor& t, dl::index_t awal, dl::index_t akhir) {
+        Shape shape = t.get_shape();
+        const dl::index_t per_baris = t.numel() / shape[0];
+        shape[0] = akhir - awal;
+        Tensor hasil(shape);
+        std::copy(t.data_ptr() + awal * per_baris, t.data_ptr() + akhir * per_baris, hasil.data_ptr());
+        return hasil;
+    }
+    
+    // Catat loss micro-batch, optimizer melangkah kalau jendela akumulasi nya sudah penuh //
+    void selesai_micro_batch(double loss, dl::index_t elemen) {
+        jumlah_loss_micro += loss * static_cast<double>(elemen);
+        elemen_micro += static_cast<double>(elemen);
+        if (++micro_terkumpul < akumulasi_setiap) {
+            return;
+        }
+        if (hook_sebelum_optimizer) {
+            hook_sebelum_optimizer();
+        }
+        optimisasi();
+        loss_efektif = jumlah_loss_micro / elemen_micro;
+        micro_terkumpul = 0;
+        jumlah_loss_micro = 0.0;
+        elemen_micro = 0.0;
+    }
+    
+    // Hitung langkah dan kirim snapshot berkala kalau sudah waktu nya //
+    void setelah_langkah() {
+        ++langkah_training;
+        if (snapshot_setiap > 0 && langkah_training % snapshot_setiap == 0) {
+            snapshot_async(path_snapshot);
+        }
+    }
+    
+    template <typename Input>
+    double train_step_manual(const Input& input, const Tensor& target) {
+        pastikan_belum_beku("train_step_manual");
+        // 1. Zero gradients, sekali di awal jendela akumulasi //
+        if (micro_terkumpul == 0) {
+            zero_grad();
+        }
         
         // 2. Forward pass //
         Tensor output = forward(input);
         
         // 3. Hitung loss //
-        Tensor loss_tensor = BinaryCrossEnrtopy::forward(output, target);
-        double loss = 0.0;
-        for (int i = 0; i < loss_tensor.numel(); ++i) {
-            loss += loss_tensor[i];
-        }
-        loss /= loss_tensor.numel();  // Rata-rata loss //
+        Tensor loss_tensor = kepala_softmax() ? SoftmaxCrossEntropy::forward(output, target)
+                                              : BinaryCrossEnrtopy::forward(output, target);
+        double loss = dl::mean(loss_tensor);  // Rata-rata loss //
         
         // 4. Backward pass //
         backward(output, target);
         
-        // 5. Update bobot dengan Adam //
-        optimisasi();
+        // 5. Update bobot dengan Adam, kalau jendela akumulasi nya sudah penuh //
+        selesai_micro_batch(loss, loss_tensor.numel());
         
         return loss;
     }
     
-    // Training untuk beberapa epoch //
-    void train(const Tensor& X, const Tensor& y, int epochs = 100, bool verbose = true) {
+public:
+
+    // Satu langkah training pakai tape autograd //
+    double train_step_autograd(const Tensor& input, const Tensor& target) {
+        pastikan_belum_beku("train_step_autograd");
+        dl::autograd::Tape& tp = dl::autograd::tape();
+        tp.reset();
+        if (micro_terkumpul == 0) {
+            zero_grad();
+        }
+        
+        // 1. Forward, semua operasi di rekam //
+        Tensor output = forward_autograd(input);
+        
+        // 2. Loss juga di rekam, jadi backward mulai dari sini //
+        Tensor loss_tensor = kepala_softmax() ? dl::autograd::softmax_cross_entropy(output, target)
+                                              : dl::autograd::binary_cross_entropy(output, target);
+        double loss = dl::mean(loss_tensor);
+        
+        // 3. Backward lewat tape, saved tensor di lepas satu per satu //
+        dl::autograd::backward(loss_tensor);
+        for (auto& layer : dense_layers) {
+            layer.ambil_grad_autograd();
+        }
+        for (auto& layer : batchnorm_layers) {
+            layer.ambil_grad_autograd();
+        }
+        for (auto& layer : layernorm_layers) {
+            layer.ambil_grad_autograd();
+        }
+        tp.reset();
+        if (hook_gradient_siap && micro_batch_terakhir()) {
+            for (size_t i = layer_order.size(); i-- > 0;) {
+                hook_gradient_siap(i);
+            }
+        }
+        
+        // 4. Update bobot dengan Adam, kalau jendela akumulasi nya sudah penuh //
+        selesai_micro_batch(loss, loss_tensor.numel());
+        
+        return loss;
+    }
+    
+    // Training untuk beberapa epoch, X bisa Tensor atau SparseTensor //
+    template <typename Input>
+    void train(const Input& X, const Tensor& y, int epochs = 100, bool verbose = true) {
+        pastikan_belum_beku("train");
         for (int epoch = 0; epoch < epochs; ++epoch) {
             double loss = train_step(X, y);
             
@@ -222,16 +946,319 @@ public:
         }
     }
     
-    // Prediksi (tanpa training) //
+    // Prediksi (tanpa training), selalu mode inferensi //
+    // Kalau kepala nya softmax, output nya probabilitas per kelas //
     Tensor predict(const Tensor& input) {
-        return forward(input);
+        return predict_inferensi(input);
+    }
+    
+    Tensor predict(const SparseTensor& input) {
+        return predict_inferensi(input);
     }
     
+private:
+    template <typename Input>
+    Tensor predict_inferensi(const Input& input) {
+        const bool training_lama = mode_training;
+        mode_training = false;
+        Tensor output = forward(input);
+        mode_training = training_lama;
+        return kepala_softmax() ? SoftmaxCrossEntropy::softmax(output) : output;
+    }
+    
+public:
+    
     // Zero semua gradients //
     void zero_grad() {
         for (auto& layer : dense_layers) {
             layer.zero_grad();
         }
+        for (auto& layer : batchnorm_layers) {
+            layer.zero_grad();
+        }
+        for (auto& layer : layernorm_layers) {
+            layer.zero_grad();
+        }
+    }
+    
+    /*
+    Bekukan network buat serving: setiap BatchNorm yang tepat setelah Dense di lipat ke Dense nya,
+        bobot'[o, :] = bobot[o, :] * skala[o]
+        bias'[o]     = bias[o] * skala[o] + geser[o]
+    dengan skala = gamma / sqrt(running_var + eps), geser = beta - running_mean * skala.
+    Layer BatchNorm nya di hapus dari urutan layer dan dari batchnorm_layers (parameter nya gak di
+    optimisasi / snapshot lagi), jadi forward nya cuma Dense. Dense tanpa bias yang jadi punya bias
+    dapat slot optimizer baru buat bias nya, biar slot nya gak -1 lagi.
+    BatchNorm yang gak tepat setelah Dense tetap ada (jalan pakai running stats).
+    Network nya pindah ke mode inferensi, semua jalur training lempar std::logic_error.
+    Return jumlah BatchNorm yang di lipat.
+    */
+    int bekukan_untuk_inferensi() {
+        DL_MEMORY_TAG("NeuralNetwork::bekukan");
+        int dilipat = 0;
+        std::vector<LayerInfo> urutan_baru;
+        std::vector<bool> bn_dilipat(batchnorm_layers.size(), false);
+        for (size_t i = 0; i < layer_order.size(); ++i) {
+            const LayerInfo& info = layer_order[i];
+            if (info.type == LayerType::BATCH_NORM && !urutan_baru.empty() &&
+                urutan_baru.back().type == LayerType::DENSE) {
+                const BatchNorm& bn = batchnorm_layers[info.dense_index];
+                Dense& d = dense_layers[urutan_baru.back().dense_index];
+                assert(d.dapatkan_out_features() == bn.dapatkan_fitur() && "Fitur BatchNorm beda dengan output Dense");
+                std::vector<double> skala(bn.dapatkan_fitur()), geser(bn.dapatkan_fitur());
+                bn.skala_geser_inferensi(skala.data(), geser.data());
+                const bool punya_bias = d.has_bias();
+                d.lipat_affine(skala.data(), geser.data());
+                if (!punya_bias) {
+                    slot_optimizer[urutan_baru.back().dense_index].second =
+                        optimizer->daftar_parameter(d.dapatkan_bias().numel(), false);
+                }
+                bn_dilipat[info.dense_index] = true;
+                ++dilipat;
+                continue;
+            }
+            urutan_baru.push_back(info);
+        }
+        layer_order = std::move(urutan_baru);
+        
+        // BatchNorm yang di lipat di buang, indeks yang sisa di geser //
+        std::vector<int> indeks_bn(batchnorm_layers.size(), -1);
+        std::vector<BatchNorm> bn_sisa;
+        std::vector<std::pair<int, int>> slot_bn_sisa;
+        for (size_t k = 0; k < batchnorm_layers.size(); ++k) {
+            if (bn_dilipat[k]) continue;
+            indeks_bn[k] = static_cast<int>(bn_sisa.size());
+            bn_sisa.push_back(std::move(batchnorm_layers[k]));
+            slot_bn_sisa.push_back(slot_batchnorm[k]);
+        }
+        batchnorm_layers = std::move(bn_sisa);
+        slot_batchnorm = std::move(slot_bn_sisa);
+        for (auto& info : layer_order) {
+            if (info.type == LayerType::BATCH_NORM) {
+                info.dense_index = indeks_bn[info.dense_index];
+            }
+        }
+        
+        // Cache dan checkpoint lama gak cocok lagi dengan urutan layer yang baru //
+        activations.clear();
+        checkpoint_setiap = 0;
+        checkpoint_layer.clear();
+        for (auto& d : dense_layers) {
+            d.lepas_cache();
+        }
+        for (auto& n : batchnorm_layers) {
+            n.lepas_cache();
+        }
+        mode_training = false;
+        beku = true;
+        return dilipat;
+    }
+    
+    bool sudah_beku() const {
+        return beku;
+    }
+    
+    // SNAPSHOT STATE TRAINING //
+    
+    // Tanda tangan arsitektur (urutan layer + ukuran + presisi), buat cek snapshot nya cocok //
+    std::string tanda_arsitektur() const {
+        std::ostringstream os;
+        for (const auto& info : layer_order) {
+            switch (info.type) {
+                case LayerType::DENSE: {
+                    const Dense& d = dense_layers[info.dense_index];
+                    os << "dense " << d.dapatkan_in_features() << " " << d.dapatkan_out_features()
+                       << (d.has_bias() ? " b" : "") << ";";
+                    break;
+                }
+                case LayerType::RELU: os << "relu;"; break;
+                case LayerType::SIGMOID: os << "sigmoid;"; break;
+                case LayerType::DROPOUT: os << "dropout " << dropout_layers[info.dense_index].dapatkan_p() << ";"; break;
+                case LayerType::BATCH_NORM: os << "batchnorm " << batchnorm_layers[info.dense_index].dapatkan_fitur() << ";"; break;
+                case LayerType::LAYER_NORM: os << "layernorm " << layernorm_layers[info.dense_index].dapatkan_fitur() << ";"; break;
+                case LayerType::SOFTMAX_CROSS_ENTROPY: os << "softmax_ce;"; break;
+            }
+        }
+        os << dl::nama_presisi(presisi);
+        return os.str();
+    }
+    
+    /*
+    Salin state training sekarang (parameter, state optimizer, posisi random, langkah).
+    Cuma memcpy, serialisasi dan I/O nya urusan yang nerima.
+    Urutan parameter: Dense (bobot, bias), BatchNorm (gamma, beta, running mean, running var), LayerNorm (gamma, beta).
+    */
+    dl::snapshot::StateTraining ambil_state() const {
+        dl::snapshot::StateTraining s;
+        ambil_state(s);
+        return s;
+    }
+    
+    // Sama, tapi di isi ke s yang sudah ada, kapasitas buffer nya di pakai ulang //
+    void ambil_state(dl::snapshot::StateTraining& s) const {
+        DL_MEMORY_TAG("snapshot");
+        s.parameter.clear();
+        s.arsitektur = tanda_arsitektur();
+        s.optimizer = optimizer->jenis();
+        s.langkah = langkah_training;
+        s.langkah_optimizer = optimizer->langkah();
+        s.learning_rate = optimizer->dapatkan_learning_rate();
+        s.seed_random = dl::random::generator().dapatkan_seed();
+        s.offset_random = dl::random::generator().dapatkan_offset();
+        std::ostringstream engine;
+        engine << dl::get_random_engine();
+        s.engine_std = engine.str();
+        
+        auto tambah = [&s](const Tensor& t) {
+            s.parameter.insert(s.parameter.end(), t.data_ptr(), t.data_ptr() + t.numel());
+        };
+        for (const auto& d : dense_layers) {
+            tambah(d.dapatkan_bobot());
+            if (d.has_bias()) tambah(d.dapatkan_bias());
+        }
+        for (const auto& n : batchnorm_layers) {
+            tambah(n.dapatkan_gamma());
+            tambah(n.dapatkan_beta());
+            tambah(n.dapatkan_running_mean());
+            tambah(n.dapatkan_running_var());
+        }
+        for (const auto& n : layernorm_layers) {
+            tambah(n.dapatkan_gamma());
+            tambah(n.dapatkan_beta());
+        }
+        const Tensor::Storage& st = optimizer->dapatkan_state();
+        s.state_optimizer.assign(st.begin(), st.end());
+    }
+    
+    // Jumlah double di StateTraining::parameter untuk network ini (urutan nya sama dengan ambil_state) //
+    size_t jumlah_parameter_state() const {
+        size_t n = 0;
+        for (const auto& d : dense_layers) {
+            n += static_cast<size_t>(d.dapatkan_bobot().numel());
+            if (d.has_bias()) n += static_cast<size_t>(d.dapatkan_bias().numel());
+        }
+        for (const auto& b : batchnorm_layers) {
+            n += 4 * static_cast<size_t>(b.dapatkan_fitur());
+        }
+        for (const auto& l : layernorm_layers) {
+            n += 2 * static_cast<size_t>(l.dapatkan_fitur());
+        }
+        return n;
+    }
+    
+    /*
+    Cek snapshot cocok dengan network ini: tanda tangan layer, jumlah parameter,
+    jenis optimizer, dan ukuran state optimizer nya. Kalau gak cocok, alasan nya di isi.
+    */
+    bool cocok_dengan_state(const dl::snapshot::StateTraining& s, std::string* alasan = nullptr) const {
+        auto gagal = [alasan](const std::string& pesan) {
+            if (alasan) *alasan = pesan;
+            return false;
+        };
+        if (s.arsitektur != tanda_arsitektur()) {
+            return gagal("arsitektur beda: snapshot '" + s.arsitektur + "', network '" + tanda_arsitektur() + "'");
+        }
+        if (s.parameter.size() != jumlah_parameter_state()) {
+            return gagal("jumlah parameter beda: snapshot " + std::to_string(s.parameter.size()) +
+                         ", network " + std::to_string(jumlah_parameter_state()));
+        }
+        if (s.optimizer != optimizer->jenis()) {
+            return gagal("optimizer beda: snapshot " + s.optimizer + ", network " + optimizer->jenis());
+        }
+        if (s.state_optimizer.size() != optimizer->ukuran_state()) {
+            return gagal("ukuran state optimizer beda: snapshot " + std::to_string(s.state_optimizer.size()) +
+                         ", network " + std::to_string(optimizer->ukuran_state()));
+        }
+        return true;
+    }
+    
+    /*
+    Pulihkan state dari snapshot. Semua ukuran nya di cek dulu (cocok_dengan_state),
+    kalau ada yang beda return false dan network nya gak di ubah sama sekali.
+    */
+    bool pulihkan_state(const dl::snapshot::StateTraining& s) {
+        DL_MEMORY_TAG("snapshot");
+        if (!cocok_dengan_state(s)) {
+            return false;
+        }
+        size_t pos = 0;
+        auto ambil = [&s, &pos](const Tensor& bentuk) {
+            Tensor t(bentuk.get_shape());
+            std::copy(s.parameter.begin() + pos, s.parameter.begin() + pos + t.numel(), t.data_ptr());
+            pos += t.numel();
+            return t;
+        };
+        for (auto& d : dense_layers) {
+            d.set_bobot(ambil(d.dapatkan_bobot()));
+            if (d.has_bias()) d.set_bias(ambil(d.dapatkan_bias()));
+        }
+        for (auto& n : batchnorm_layers) {
+            n.set_gamma(ambil(n.dapatkan_gamma()));
+            n.set_beta(ambil(n.dapatkan_beta()));
+            Tensor mean = ambil(n.dapatkan_running_mean());
+            n.set_running(mean, ambil(n.dapatkan_running_var()));
+        }
+        for (auto& n : layernorm_layers) {
+            n.set_gamma(ambil(n.dapatkan_gamma()));
+            n.set_beta(ambil(n.dapatkan_beta()));
+        }
+        
+        const bool ok = optimizer->pulihkan_state(s.state_optimizer.data(), s.state_optimizer.size(), s.langkah_optimizer);
+        assert(ok && "Ukuran state optimizer sudah di cek");
+        (void)ok;
+        optimizer->atur_learning_rate(s.learning_rate);
+        learning_rate = s.learning_rate;
+        
+        dl::random::generator().seed(s.seed_random);
+        dl::random::generator().atur_offset(s.offset_random);
+        std::istringstream engine(s.engine_std);
+        engine >> dl::get_random_engine();
+        
+        langkah_training = s.langkah;
+        micro_terkumpul = 0;
+        jumlah_loss_micro = 0.0;
+        elemen_micro = 0.0;
+        zero_grad();
+        return true;
+    }
+    
+    // Kirim snapshot state sekarang ke penulis background, gak nunggu I/O //
+    void snapshot_async(const std::string& path) {
+        if (!penulis_snapshot) {
+            penulis_snapshot.reset(new dl::snapshot::PenulisAsync());
+        }
+        std::unique_ptr<dl::snapshot::StateTraining> s = penulis_snapshot->ambil_bekas();
+        ambil_state(*s);
+        penulis_snapshot->kirim(std::move(s), path);
+    }
+    
+    // Snapshot berkala setiap k langkah train_step ke path (k = 0 matikan) //
+    void atur_snapshot(const std::string& path, int setiap_langkah) {
+        path_snapshot = path;
+        snapshot_setiap = setiap_langkah;
+    }
+    
+    // Tunggu semua snapshot yang antri sampai ke disk //
+    void tunggu_snapshot() {
+        if (penulis_snapshot) {
+            penulis_snapshot->tunggu();
+        }
+    }
+    
+    dl::snapshot::StatistikSnapshot statistik_snapshot() const {
+        return penulis_snapshot ? penulis_snapshot->dapatkan_statistik() : dl::snapshot::StatistikSnapshot();
+    }
+    
+    /*
+    Lanjutkan training dari file snapshot. Return false kalau file nya gak ada, rusak,
+    atau gak cocok dengan network / optimizer ini (network nya gak di ubah).
+    */
+    bool lanjutkan_dari(const std::string& path) {
+        dl::snapshot::StateTraining s;
+        if (!dl::snapshot::baca_file(path, s)) {
+            return false;
+        }
+        return pulihkan_state(s);
     }
     
     // Info tentang network //
@@ -240,7 +1267,7 @@ public:
         std::cout << "Total layer: " << layer_order.size() << std::endl;
         std::cout << "Dense layer: " << dense_layers.size() << std::endl;
         
-        int total_params = 0;
+        dl::index_t total_params = 0;
         int layer_num = 1;
         
         for (const auto& info : layer_order) {
@@ -260,11 +1287,86 @@ public:
                 case LayerType::SIGMOID:
                     std::cout << "Sigmoid";
                     break;
+                case LayerType::DROPOUT:
+                    std::cout << "Dropout(p=" << dropout_layers[info.dense_index].dapatkan_p() << ")";
+                    break;
+                case LayerType::BATCH_NORM: {
+                    const BatchNorm& n = batchnorm_layers[info.dense_index];
+                    std::cout << "BatchNorm(" << n.dapatkan_fitur() << ")";
+                    total_params += n.num_parameters();
+                    break;
+                }
+                case LayerType::LAYER_NORM: {
+                    const LayerNorm& n = layernorm_layers[info.dense_index];
+                    std::cout << "LayerNorm(" << n.dapatkan_fitur() << ")";
+                    total_params += n.num_parameters();
+                    break;
+                }
+                case LayerType::SOFTMAX_CROSS_ENTROPY:
+                    std::cout << "Softmax + CrossEntropy";
+                    break;
             }
             std::cout << std::endl;
         }
         
         std::cout << "Total parameter: " << total_params << std::endl;
+        if (beku) {
+            std::cout << "Beku untuk inferensi (BatchNorm di lipat ke Dense)" << std::endl;
+        }
+        if (dl::fastmath::mode() == dl::fastmath::ModeMath::CEPAT) {
+            std::cout << "Math: " << dl::fastmath::nama_mode(dl::fastmath::mode())
+                      << " (" << dl::fastmath::jalur() << ")" << std::endl;
+        }
+        if (presisi != dl::Presisi::FP64) {
+            std::cout << "Presisi: " << dl::nama_presisi(presisi)
+                      << " (konversi " << dl::half::jalur_konversi(presisi) << ")" << std::endl;
+            
+            // Memori jalur 16-bit vs kalau jalur yang sama pakai fp32 //
+            long long param_half = 0, param_master = 0, param_fp32 = 0;
+            long long cache_half = 0, cache_fp32 = 0;
+            for (const auto& d : dense_layers) {
+                const long long b16 = d.dapatkan_bobot_half().bytes();
+                param_half += b16;
+                param_fp32 += b16 / sizeof(uint16_t) * sizeof(float);
+                param_master += static_cast<long long>(d.num_parameters()) * sizeof(double);
+                cache_half += static_cast<long long>(d.elemen_cache_half()) * sizeof(uint16_t);
+                cache_fp32 += static_cast<long long>(d.elemen_cache_half()) * sizeof(float);
+            }
+            std::cout << "  Bobot Dense: 16-bit " << dl::memori::format_bytes(param_half)
+                      << " (fp32: " << dl::memori::format_bytes(param_fp32) << ")"
+                      << ", master fp64: " << dl::memori::format_bytes(param_master) << std::endl;
+            std::cout << "  Cache aktivasi Dense: 16-bit " << dl::memori::format_bytes(cache_half)
+                      << " (fp32: " << dl::memori::format_bytes(cache_fp32) << ")"
+                      << ", buffer kerja fp32: " << dl::memori::format_bytes(Dense::bytes_buffer_half())
+                      << std::endl;
+        }
+        std::cout << "Optimizer: " << optimizer->nama()
+                  << ", state: " << dl::memori::format_bytes(optimizer->bytes_state()) << std::endl;
+        if (akumulasi_setiap > 1) {
+            std::cout << "Gradient accumulation: " << akumulasi_setiap << " micro-batch per langkah" << std::endl;
+        }
+        
+        // Info snapshot state training //
+        if (penulis_snapshot) {
+            dl::snapshot::StatistikSnapshot s = penulis_snapshot->dapatkan_statistik();
+            std::cout << "Snapshot: " << s.ditulis << " di tulis, " << s.dilewati << " di lewati, "
+                      << s.gagal << " gagal, langkah terakhir di disk: " << s.langkah_terakhir
+                      << ", waktu tulis background: " << s.waktu_tulis_ms << " ms" << std::endl;
+        }
+        
+        // Info gradient checkpointing //
+        if (checkpoint_aktif()) {
+            const StatistikCheckpoint& s = statistik_ckpt;
+            std::cout << "Gradient checkpoint: " << (batas_segmen().size() - 1) << " segmen"
+                      << ", layer di hitung ulang: " << s.layer_dihitung_ulang
+                      << " dari " << s.layer_forward << " forward"
+                      << ", overhead compute: " << s.overhead_compute() << "%"
+                      << ", puncak aktivasi: " << dl::memori::format_bytes(s.bytes_aktivasi_puncak)
+                      << std::endl;
+        }
+        
+        // Pemakaian memori Tensor sejauh ini //
+        dl::memori::laporan(std::cout);
         std::cout << "========================================" << std::endl;
     }
 };
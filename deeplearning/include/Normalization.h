@@ -0,0 +1,438 @@
+#ifndef NORMALIZATION_H
+#define NORMALIZATION_H
+
+#include "Tensor.h"
+#include "Tensor_factory.h"
+#include "Autograd.h"
+#include "Optimizer.h"
+#include "Profiler.h"
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/*
+Layer normalisasi buat input 2D [batch, fitur].
+Dua-dua nya: y = gamma * x_hat + beta, x_hat = (x - mean) / sqrt(var + eps),
+gamma dan beta parameter yang di latih (per fitur).
+
+BatchNorm: mean dan var nya per fitur, di hitung di sepanjang batch.
+    Pas training pakai statistik batch, sambil update running_mean / running_var (moving average).
+    Pas inferensi pakai running_mean / running_var, jadi cuma y = skala * x + geser per fitur.
+    Kalau BatchNorm nya tepat setelah Dense, skala dan geser itu bisa di lipat ke bobot dan bias
+    Dense nya (NeuralNetwork::bekukan_untuk_inferensi), jadi pas serving gak ada biaya normalisasi.
+
+LayerNorm: mean dan var nya per baris (per sampel), di sepanjang fitur.
+    Gak tergantung batch, jadi training dan inferensi nya sama.
+
+Mean dan var nya satu kali jalan (Welford), bukan jumlah x lalu jumlah x^2
+(yang bisa kehilangan presisi kalau mean nya jauh lebih besar dari std nya).
+Di BatchNorm, Welford nya jalan per baris dengan semua fitur sekaligus,
+jadi loop dalam nya contiguous di memori dan bisa di vectorize.
+
+Backward (N = jumlah elemen yang di rata-rata, g = grad output):
+    dx_hat = g * gamma
+    dx     = inv_std / N * (N * dx_hat - sum(dx_hat) - x_hat * sum(dx_hat * x_hat))
+    dgamma = sum(g * x_hat), dbeta = sum(g)
+Kedua sum nya di hitung bareng dalam satu jalan, lalu dx di jalan kedua.
+*/
+
+class BatchNorm {
+private:
+    dl::index_t fitur;
+    double eps;
+    double momentum;
+
+    Tensor gamma, beta;
+    Tensor grad_gamma, grad_beta;
+    Tensor running_mean, running_var;
+
+    // Cache buat backward //
+    Tensor cached_xhat;                 // [batch, fitur] //
+    std::vector<double> inv_std;        // [fitur] //
+    bool cache_training = false;        // Cache nya dari forward training atau inferensi //
+
+    // x_hat = (x - mean) * inv_std di simpan ke cache, y = gamma * x_hat + beta //
+    void normalisasi(const Tensor& x, const double* mean, Tensor& y) {
+        const dl::index_t batch = x.get_shape()[0];
+        cached_xhat = Tensor(x.get_shape());
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* px = x.row_ptr(b);
+            double* ph = cached_xhat.row_ptr(b);
+            double* py = y.row_ptr(b);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                ph[j] = (px[j] - mean[j]) * inv_std[j];
+                py[j] = gamma[j] * ph[j] + beta[j];
+            }
+        }
+    }
+
+public:
+    BatchNorm(dl::index_t fitur_, double momentum_ = 0.1, double eps_ = 1e-5)
+        : fitur(fitur_), eps(eps_), momentum(momentum_) {
+        DL_MEMORY_TAG("BatchNorm::parameter");
+        gamma = dl::ones({fitur});
+        beta = dl::zeros({fitur});
+        gamma.set_requires_grad(true);
+        beta.set_requires_grad(true);
+        grad_gamma = dl::zeros({fitur});
+        grad_beta = dl::zeros({fitur});
+        running_mean = dl::zeros({fitur});
+        running_var = dl::ones({fitur});
+    }
+
+    /*
+    Forward. training = true pakai statistik batch,
+    update_running = false kalau cuma hitung ulang (gradient checkpointing) biar running stats gak ke-update dua kali.
+    */
+    Tensor forward(const Tensor& x, bool training, bool update_running = true) {
+        DL_MEMORY_TAG("BatchNorm::cache");
+        DL_PROFILE("BatchNorm::forward", x.numel());
+        assert(x.get_shape().size() == 2 && x.get_shape()[1] == fitur && "Input BatchNorm harus [batch, fitur]");
+        const dl::index_t batch = x.get_shape()[0];
+        Tensor y(x.get_shape());
+        inv_std.assign(fitur, 0.0);
+        cache_training = training;
+
+        if (!training) {
+            // Inferensi: statistik nya running stats, y = gamma * x_hat + beta //
+            std::vector<double> mean(fitur);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                mean[j] = running_mean[j];
+                inv_std[j] = 1.0 / std::sqrt(running_var[j] + eps);
+            }
+            normalisasi(x, mean.data(), y);
+            return y;
+        }
+
+        assert(batch > 1 && "BatchNorm training butuh batch > 1");
+        // Welford per fitur, satu baris sekaligus //
+        std::vector<double> mean(fitur, 0.0), m2(fitur, 0.0);
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* px = x.row_ptr(b);
+            const double inv_n = 1.0 / static_cast<double>(b + 1);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                const double delta = px[j] - mean[j];
+                mean[j] += delta * inv_n;
+                m2[j] += delta * (px[j] - mean[j]);
+            }
+        }
+
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            const double var = m2[j] / static_cast<double>(batch);
+            inv_std[j] = 1.0 / std::sqrt(var + eps);
+            if (update_running) {
+                // Running var pakai var unbiased (bagi batch - 1), sama kek PyTorch //
+                const double var_unbiased = m2[j] / static_cast<double>(batch - 1);
+                running_mean[j] = (1.0 - momentum) * running_mean[j] + momentum * mean[j];
+                running_var[j] = (1.0 - momentum) * running_var[j] + momentum * var_unbiased;
+            }
+        }
+
+        normalisasi(x, mean.data(), y);
+        return y;
+    }
+
+    /*
+    Backward, gradient gamma dan beta nya di tambahkan ke dgamma / dbeta.
+    Kalau forward nya inferensi, mean dan var nya konstan, jadi dx = g * gamma * inv_std.
+    */
+    Tensor backward(const Tensor& grad, double* dgamma, double* dbeta) const {
+        DL_MEMORY_TAG("BatchNorm::backward");
+        DL_PROFILE("BatchNorm::backward", grad.numel());
+        assert(cached_xhat.numel() == grad.numel() && "Backward BatchNorm butuh forward dulu");
+        const dl::index_t batch = grad.get_shape()[0];
+        Tensor gx(grad.get_shape());
+
+        // Jalan pertama: sum(g) dan sum(g * x_hat) per fitur //
+        std::vector<double> sum_g(fitur, 0.0), sum_gx(fitur, 0.0);
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* pg = grad.row_ptr(b);
+            const double* ph = cached_xhat.row_ptr(b);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                sum_g[j] += pg[j];
+                sum_gx[j] += pg[j] * ph[j];
+            }
+        }
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            dbeta[j] += sum_g[j];
+            dgamma[j] += sum_gx[j];
+        }
+
+        // Jalan kedua: dx = gamma * inv_std / N * (N * g - sum(g) - x_hat * sum(g * x_hat)) //
+        const double inv_n = cache_training ? 1.0 / static_cast<double>(batch) : 0.0;
+        std::vector<double> k(fitur);
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            k[j] = gamma[j] * inv_std[j];
+            sum_g[j] *= inv_n;
+            sum_gx[j] *= inv_n;
+        }
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* pg = grad.row_ptr(b);
+            const double* ph = cached_xhat.row_ptr(b);
+            double* px = gx.row_ptr(b);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                px[j] = k[j] * (pg[j] - sum_g[j] - ph[j] * sum_gx[j]);
+            }
+        }
+        return gx;
+    }
+
+    // Backward, gradient gamma dan beta nya di akumulasi di layer //
+    Tensor backward(const Tensor& grad) {
+        return backward(grad, grad_gamma.data_ptr(), grad_beta.data_ptr());
+    }
+
+    // Forward yang di rekam di tape autograd, gamma dan beta jadi leaf //
+    Tensor forward_autograd(const Tensor& x, bool training) {
+        Tensor y = forward(x, training);
+
+        dl::autograd::Tape& tp = dl::autograd::tape();
+        std::vector<int> input = {tp.slot_dari(x), tp.slot_dari(gamma), tp.slot_dari(beta)};
+        if (!dl::autograd::perlu_rekam(input)) return y;
+
+        const BatchNorm* pl = this;
+        tp.rekam(y, input, [pl](const Tensor& dy) {
+            std::vector<Tensor> grads(3);
+            grads[1] = dl::zeros({pl->fitur});
+            grads[2] = dl::zeros({pl->fitur});
+            grads[0] = pl->backward(dy, grads[1].data_ptr(), grads[2].data_ptr());
+            return grads;
+        });
+        return y;
+    }
+
+    // Ambil gradient gamma dan beta dari tape setelah dl::autograd::backward //
+    // Di tambahkan ke gradient lama kek backward manual, jadi bisa di akumulasi antar micro-batch //
+    void ambil_grad_autograd() {
+        DL_MEMORY_TAG("BatchNorm::gradien");
+        grad_gamma += dl::autograd::grad(gamma);
+        grad_beta += dl::autograd::grad(beta);
+    }
+
+    // y = skala * x + geser pakai running stats (inferensi) //
+    void skala_geser_inferensi(double* skala, double* geser) const {
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            skala[j] = gamma[j] / std::sqrt(running_var[j] + eps);
+            geser[j] = beta[j] - running_mean[j] * skala[j];
+        }
+    }
+
+    void optimisasi(dl::optim::Optimizer& opt, int id_gamma, int id_beta) {
+        opt.update(id_gamma, gamma.data_ptr(), grad_gamma.data_ptr(), fitur);
+        opt.update(id_beta, beta.data_ptr(), grad_beta.data_ptr(), fitur);
+    }
+
+    void zero_grad() {
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            grad_gamma[j] = 0.0;
+            grad_beta[j] = 0.0;
+        }
+    }
+
+    void lepas_cache() {
+        cached_xhat = Tensor();
+    }
+
+    long long bytes_cache() const {
+        return static_cast<long long>(cached_xhat.numel()) * sizeof(double);
+    }
+
+    dl::index_t dapatkan_fitur() const { return fitur; }
+    double dapatkan_eps() const { return eps; }
+    dl::index_t num_parameters() const { return 2 * fitur; }
+    const Tensor& dapatkan_gamma() const { return gamma; }
+    const Tensor& dapatkan_beta() const { return beta; }
+    const Tensor& dapatkan_grad_gamma() const { return grad_gamma; }
+    const Tensor& dapatkan_grad_beta() const { return grad_beta; }
+    void buffer_gradient(std::vector<std::pair<double*, dl::index_t>>& out) {
+        out.emplace_back(grad_gamma.data_ptr(), fitur);
+        out.emplace_back(grad_beta.data_ptr(), fitur);
+    }
+    const Tensor& dapatkan_running_mean() const { return running_mean; }
+    const Tensor& dapatkan_running_var() const { return running_var; }
+    void set_running(const Tensor& mean, const Tensor& var) {
+        running_mean = mean;
+        running_var = var;
+    }
+
+    // Gamma dan beta selalu jadi leaf autograd, jadi status tape nya di reset //
+    void set_gamma(const Tensor& g) {
+        gamma = g;
+        gamma.set_requires_grad(true);
+        gamma.set_tape_slot(-1, 0);
+    }
+    void set_beta(const Tensor& b) {
+        beta = b;
+        beta.set_requires_grad(true);
+        beta.set_tape_slot(-1, 0);
+    }
+};
+
+class LayerNorm {
+private:
+    dl::index_t fitur;
+    double eps;
+
+    Tensor gamma, beta;
+    Tensor grad_gamma, grad_beta;
+
+    // Cache buat backward //
+    Tensor cached_xhat;            // [batch, fitur] //
+    std::vector<double> inv_std;   // [batch] //
+
+public:
+    explicit LayerNorm(dl::index_t fitur_, double eps_ = 1e-5) : fitur(fitur_), eps(eps_) {
+        DL_MEMORY_TAG("LayerNorm::parameter");
+        gamma = dl::ones({fitur});
+        beta = dl::zeros({fitur});
+        gamma.set_requires_grad(true);
+        beta.set_requires_grad(true);
+        grad_gamma = dl::zeros({fitur});
+        grad_beta = dl::zeros({fitur});
+    }
+
+    Tensor forward(const Tensor& x) {
+        DL_MEMORY_TAG("LayerNorm::cache");
+        DL_PROFILE("LayerNorm::forward", x.numel());
+        assert(x.get_shape().size() == 2 && x.get_shape()[1] == fitur && "Input LayerNorm harus [batch, fitur]");
+        const dl::index_t batch = x.get_shape()[0];
+        Tensor y(x.get_shape());
+        cached_xhat = Tensor(x.get_shape());
+        inv_std.assign(batch, 0.0);
+        const double inv_f = 1.0 / static_cast<double>(fitur);
+
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* px = x.row_ptr(b);
+            // Welford di sepanjang baris //
+            double mean = 0.0, m2 = 0.0;
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                const double delta = px[j] - mean;
+                mean += delta / static_cast<double>(j + 1);
+                m2 += delta * (px[j] - mean);
+            }
+            const double is = 1.0 / std::sqrt(m2 * inv_f + eps);
+            inv_std[b] = is;
+
+            double* ph = cached_xhat.row_ptr(b);
+            double* py = y.row_ptr(b);
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                ph[j] = (px[j] - mean) * is;
+                py[j] = gamma[j] * ph[j] + beta[j];
+            }
+        }
+        return y;
+    }
+
+    // Backward, gradient gamma dan beta nya di tambahkan ke dgamma / dbeta //
+    Tensor backward(const Tensor& grad, double* dgamma, double* dbeta) const {
+        DL_MEMORY_TAG("LayerNorm::backward");
+        DL_PROFILE("LayerNorm::backward", grad.numel());
+        assert(cached_xhat.numel() == grad.numel() && "Backward LayerNorm butuh forward dulu");
+        const dl::index_t batch = grad.get_shape()[0];
+        const double inv_f = 1.0 / static_cast<double>(fitur);
+        Tensor gx(grad.get_shape());
+
+        for (dl::index_t b = 0; b < batch; ++b) {
+            const double* pg = grad.row_ptr(b);
+            const double* ph = cached_xhat.row_ptr(b);
+            double* px = gx.row_ptr(b);
+
+            // Satu jalan: sum(dx_hat), sum(dx_hat * x_hat), sekalian gradient gamma dan beta //
+            double sum_d = 0.0, sum_dx = 0.0;
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                const double d = pg[j] * gamma[j];
+                sum_d += d;
+                sum_dx += d * ph[j];
+                dgamma[j] += pg[j] * ph[j];
+                dbeta[j] += pg[j];
+            }
+            sum_d *= inv_f;
+            sum_dx *= inv_f;
+
+            const double is = inv_std[b];
+            for (dl::index_t j = 0; j < fitur; ++j) {
+                px[j] = is * (pg[j] * gamma[j] - sum_d - ph[j] * sum_dx);
+            }
+        }
+        return gx;
+    }
+
+    // Backward, gradient gamma dan beta nya di akumulasi di layer //
+    Tensor backward(const Tensor& grad) {
+        return backward(grad, grad_gamma.data_ptr(), grad_beta.data_ptr());
+    }
+
+    // Forward yang di rekam di tape autograd, gamma dan beta jadi leaf //
+    Tensor forward_autograd(const Tensor& x) {
+        Tensor y = forward(x);
+
+        dl::autograd::Tape& tp = dl::autograd::tape();
+        std::vector<int> input = {tp.slot_dari(x), tp.slot_dari(gamma), tp.slot_dari(beta)};
+        if (!dl::autograd::perlu_rekam(input)) return y;
+
+        const LayerNorm* pl = this;
+        tp.rekam(y, input, [pl](const Tensor& dy) {
+            std::vector<Tensor> grads(3);
+            grads[1] = dl::zeros({pl->fitur});
+            grads[2] = dl::zeros({pl->fitur});
+            grads[0] = pl->backward(dy, grads[1].data_ptr(), grads[2].data_ptr());
+            return grads;
+        });
+        return y;
+    }
+
+    // Ambil gradient gamma dan beta dari tape setelah dl::autograd::backward //
+    // Di tambahkan ke gradient lama kek backward manual, jadi bisa di akumulasi antar micro-batch //
+    void ambil_grad_autograd() {
+        DL_MEMORY_TAG("LayerNorm::gradien");
+        grad_gamma += dl::autograd::grad(gamma);
+        grad_beta += dl::autograd::grad(beta);
+    }
+
+    void optimisasi(dl::optim::Optimizer& opt, int id_gamma, int id_beta) {
+        opt.update(id_gamma, gamma.data_ptr(), grad_gamma.data_ptr(), fitur);
+        opt.update(id_beta, beta.data_ptr(), grad_beta.data_ptr(), fitur);
+    }
+
+    void zero_grad() {
+        for (dl::index_t j = 0; j < fitur; ++j) {
+            grad_gamma[j] = 0.0;
+            grad_beta[j] = 0.0;
+        }
+    }
+
+    void lepas_cache() {
+        cached_xhat = Tensor();
+    }
+
+    long long bytes_cache() const {
+        return static_cast<long long>(cached_xhat.numel()) * sizeof(double);
+    }
+
+    dl::index_t dapatkan_fitur() const { return fitur; }
+    double dapatkan_eps() const { return eps; }
+    dl::index_t num_parameters() const { return 2 * fitur; }
+    const Tensor& dapatkan_gamma() const { return gamma; }
+    const Tensor& dapatkan_beta() const { return beta; }
+    const Tensor& dapatkan_grad_gamma() const { return grad_gamma; }
+    const Tensor& dapatkan_grad_beta() const { return grad_beta; }
+    void buffer_gradient(std::vector<std::pair<double*, dl::index_t>>& out) {
+        out.emplace_back(grad_gamma.data_ptr(), fitur);
+        out.emplace_back(grad_beta.data_ptr(), fitur);
+    }
+
+    // Gamma dan beta selalu jadi leaf autograd, jadi status tape nya di reset //
+    void set_gamma(const Tensor& g) {
+        gamma = g;
+        gamma.set_requires_grad(true);
+        gamma.set_tape_slot(-1, 0);
+    }
+    void set_beta(const Tensor& b) {
+        beta = b;
+        beta.set_requires_grad(true);
+        beta.set_tape_slot(-1, 0);
+    }
+};
+
+#endif
@@ -0,0 +1,525 @@
+#ifndef ONLINE_H
+#define ONLINE_H
+
+#include "NeuralNetwork.h"
+#include "Autotune.h"
+#include "Memory.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+Online learning: training terus dari stream event, sambil model yang sama di pakai buat prediksi.
+
+NeuralNetwork gak bisa di baca pas train_step lagi jalan (bobot nya lagi di update, cache aktivasi
+nya di timpa). Jadi pembaca gak pernah nyentuh NeuralNetwork nya langsung:
+    - Thread trainer (PelatihOnline) yang punya NeuralNetwork nya, update nya incremental per event / batch.
+    - Setiap k langkah, bobot nya di salin ke ModelBeku (snapshot immutable, gak pernah di ubah lagi)
+      lalu di publikasi dengan satu atomic exchange pointer.
+    - Pembaca ambil pointer snapshot yang aktif dan predict dari situ. Gak ada lock sama sekali,
+      dan snapshot yang di pegang selalu konsisten (semua bobot dari langkah yang sama).
+
+Reklamasi nya ditunda (gaya RCU, epoch based):
+    pembaca : e = epoch_global; slot.epoch = e; p = aktif;  ... pakai p ...  slot.epoch = DIAM
+    penerbit: lama = aktif.exchange(baru); E = ++epoch_global; pensiun (lama, E)
+              lama boleh di pakai ulang kalau semua slot pembaca yang aktif epoch nya >= E
+Pembaca yang epoch nya >= E baca epoch itu setelah exchange, jadi pasti dapat pointer yang baru.
+Snapshot yang sudah di reklamasi gak di free, tapi di pakai ulang buat publikasi berikut nya,
+jadi publikasi cuma memcpy bobot + satu exchange, tanpa alokasi.
+
+Contoh:
+    dl::online::PelatihOnline pelatih(nn, 10);        // Publikasi setiap 10 langkah //
+    pelatih.mulai();                                  // Thread trainer //
+    pelatih.kirim(X_event, y_event);                  // Dari thread penghasil event //
+
+    dl::online::Pembaca pembaca(pelatih);             // Satu per thread pembaca //
+    Tensor p = pembaca.predict(x);                    // Atau: auto m = pembaca.baca(); m->predict(x); //
+
+Prediksi snapshot sama persis bit per bit dengan nn.predict pas snapshot nya di ambil
+(kernel Dense nya sama, cuma di paksa serial biar pembaca gak rebutan thread pool dengan trainer).
+Snapshot cuma untuk presisi FP64.
+*/
+
+namespace dl {
+namespace online {
+
+// Pembaca ke-(MAKS_PEMBACA + 1) yang hidup bareng lempar std::runtime_error //
+constexpr int MAKS_PEMBACA = 64;
+constexpr uint64_t DIAM = std::numeric_limits<uint64_t>::max();   // Slot yang lagi gak baca //
+
+/*
+ModelBeku: bobot satu versi + cara forward inferensi nya.
+Semua method nya const, jadi bisa di pakai banyak thread bareng.
+*/
+class ModelBeku {
+public:
+    struct Layer {
+        LayerType type;
+        dl::index_t in = 0;       // Fitur input (BatchNorm / LayerNorm: jumlah fitur) //
+        dl::index_t out = 0;
+        size_t offset = 0;        // Awal parameter layer ini di vector parameter //
+        bool bias = false;
+        double eps = 0.0;
+    };
+
+private:
+    friend class PelatihOnline;
+
+    std::vector<Layer> layer;
+    std::vector<double> parameter;
+    bool softmax = false;
+    long long versi_ = 0;
+    long long langkah_ = 0;
+
+    // Salin bobot nn, kapasitas vector nya di pakai ulang //
+    void isi_dari(const NeuralNetwork& nn) {
+        DL_MEMORY_TAG("online::snapshot");
+        assert(nn.dapatkan_presisi() == dl::Presisi::FP64 && "Snapshot online cuma untuk presisi FP64");
+        layer.clear();
+        parameter.clear();
+        softmax = false;
+        auto tambah = [this](const double* p, dl::index_t n) {
+            parameter.insert(parameter.end(), p, p + n);
+        };
+        for (size_t i = 0; i < nn.jumlah_layer(); ++i) {
+            const LayerInfo& info = nn.info_layer(i);
+            Layer l;
+            l.type = info.type;
+            l.offset = parameter.size();
+            switch (info.type) {
+                case LayerType::DENSE: {
+                    const Dense& d = nn.dapatkan_dense(info.dense_index);
+                    l.in = d.dapatkan_in_features();
+                    l.out = d.dapatkan_out_features();
+                    l.bias = d.has_bias();
+                    tambah(d.dapatkan_bobot().data_ptr(), l.in * l.out);
+                    if (l.bias) tambah(d.dapatkan_bias().data_ptr(), l.out);
+                    break;
+                }
+                case LayerType::BATCH_NORM: {
+                    // gamma, beta, running_mean, inv_std (sama dengan BatchNorm::forward inferensi) //
+                    const BatchNorm& n = nn.dapatkan_batchnorm(info.dense_index);
+                    l.in = l.out = n.dapatkan_fitur();
+                    tambah(n.dapatkan_gamma().data_ptr(), l.in);
+                    tambah(n.dapatkan_beta().data_ptr(), l.in);
+                    tambah(n.dapatkan_running_mean().data_ptr(), l.in);
+                    const Tensor& var = n.dapatkan_running_var();
+                    for (dl::index_t j = 0; j < l.in; ++j) {
+                        parameter.push_back(1.0 / std::sqrt(var[j] + n.dapatkan_eps()));
+                    }
+                    break;
+                }
+                case LayerType::LAYER_NORM: {
+                    const LayerNorm& n = nn.dapatkan_layernorm(info.dense_index);
+                    l.in = l.out = n.dapatkan_fitur();
+                    l.eps = n.dapatkan_eps();
+                    tambah(n.dapatkan_gamma().data_ptr(), l.in);
+                    tambah(n.dapatkan_beta().data_ptr(), l.in);
+                    break;
+                }
+                case LayerType::DROPOUT:
+                    continue;   // No-op pas inferensi //
+                case LayerType::SOFTMAX_CROSS_ENTROPY:
+                    softmax = true;
+                    continue;
+                default:
+                    break;
+            }
+            layer.push_back(l);
+        }
+        langkah_ = nn.langkah();
+    }
+
+public:
+    Tensor predict(const Tensor& input) const {
+        DL_MEMORY_TAG("online::predict");
+        const dl::index_t batch = input.get_shape()[0];
+        Tensor sekarang;
+        const Tensor* x = &input;
+
+        for (const Layer& l : layer) {
+            const double* p = parameter.data() + l.offset;
+            Tensor y;
+            switch (l.type) {
+                case LayerType::DENSE: {
+                    assert(x->get_shape().size() == 2 && x->get_shape()[1] == l.in && "Input Dense gak cocok");
+                    y = Tensor({batch, l.out});
+                    // Semua konfigurasi kernel hasil nya sama persis, jadi langsung serial tanpa autotuner //
+                    const dl::tuning::KonfigurasiLinear k{batch >= 4 ? 3 : 1, dl::tuning::Paralel::SERIAL};
+                    dl::tuning::linear_dengan(k, x->data_ptr(), p, l.bias ? p + l.in * l.out : nullptr,
+                                              y.data_ptr(), batch, l.in, l.out);
+                    break;
+                }
+                case LayerType::RELU:
+                    y = ReLu::forward(*x);
+                    break;
+                case LayerType::SIGMOID:
+                    y = Sigmoid::forward(*x);
+                    break;
+                case LayerType::BATCH_NORM: {
+                    const double *gamma = p, *beta = p + l.in, *mean = p + 2 * l.in, *inv_std = p + 3 * l.in;
+                    y = Tensor(x->get_shape());
+                    for (dl::index_t b = 0; b < batch; ++b) {
+                        const double* px = x->row_ptr(b);
+                        double* py = y.row_ptr(b);
+                        for (dl::index_t j = 0; j < l.in; ++j) {
+                            const double h = (px[j] - mean[j]) * inv_std[j];
+                            py[j] = gamma[j] * h + beta[j];
+                        }
+                    }
+                    break;
+                }
+                case LayerType::LAYER_NORM: {
+                    // Sama dengan LayerNorm::forward, tanpa cache //
+                    const double *gamma = p, *beta = p + l.in;
+                    const double inv_f = 1.0 / static_cast<double>(l.in);
+                    y = Tensor(x->get_shape());
+                    for (dl::index_t b = 0; b < batch; ++b) {
+                        const double* px = x->row_ptr(b);
+                        double mean = 0.0, m2 = 0.0;
+                        for (dl::index_t j = 0; j < l.in; ++j) {
+                            const double delta = px[j] - mean;
+                            mean += delta / static_cast<double>(j + 1);
+                            m2 += delta * (px[j] - mean);
+                        }
+                        const double is = 1.0 / std::sqrt(m2 * inv_f + l.eps);
+                        double* py = y.row_ptr(b);
+                        for (dl::index_t j = 0; j < l.in; ++j) {
+                            const double h = (px[j] - mean) * is;
+                            py[j] = gamma[j] * h + beta[j];
+                        }
+                    }
+                    break;
+                }
+                default:
+                    continue;
+            }
+            sekarang = std::move(y);
+            x = &sekarang;
+        }
+        if (softmax) return SoftmaxCrossEntropy::softmax(*x);
+        if (x == &input) return input;
+        return sekarang;
+    }
+
+    // Nomor publikasi (naik terus) dan langkah training saat snapshot di ambil //
+    long long versi() const { return versi_; }
+    long long langkah() const { return langkah_; }
+    size_t bytes() const { return parameter.size() * sizeof(double); }
+};
+
+struct alignas(64) SlotPembaca {
+    std::atomic<uint64_t> epoch{DIAM};
+    std::atomic<bool> dipakai{false};
+    std::atomic<long long> jumlah_baca{0};   // Cuma di tulis pemilik slot //
+};
+
+struct StatistikOnline {
+    long long update = 0;                  // train_step yang sudah jalan //
+    long long publikasi = 0;
+    long long direklamasi = 0;             // Snapshot lama yang sudah gak di pegang pembaca //
+    long long menunggu_reklamasi = 0;      // Masih mungkin di pegang pembaca //
+    long long pembacaan = 0;               // Total baca() semua pembaca //
+    long long event_antri = 0;             // Event yang belum di proses thread trainer //
+    double waktu_update_ms = 0.0;
+    double waktu_publikasi_total_us = 0.0;
+    double waktu_publikasi_maks_us = 0.0;
+
+    double waktu_publikasi_rata_us() const {
+        return publikasi > 0 ? waktu_publikasi_total_us / static_cast<double>(publikasi) : 0.0;
+    }
+};
+
+class Pembaca;
+
+/*
+Pemilik NeuralNetwork. Semua update dan publikasi jalan di satu thread:
+update() langsung dari thread pemanggil, atau mulai() + kirim() lewat thread trainer.
+Jangan campur dua-dua nya, dan jangan sentuh nn nya dari luar selama PelatihOnline masih hidup.
+*/
+class PelatihOnline {
+private:
+    friend class Pembaca;
+
+    NeuralNetwork& nn;
+    int publikasi_setiap;
+
+    // Sisi pembaca: cuma atomic //
+    std::atomic<const ModelBeku*> aktif{nullptr};
+    std::atomic<uint64_t> epoch_global{1};
+    std::atomic<long long> versi_aktif{-1};  // Salinan versi snapshot aktif, biar versi() gak deref pointer tanpa epoch //
+    SlotPembaca slot[MAKS_PEMBACA];
+
+    // Sisi penerbit, cuma di sentuh thread trainer //
+    std::unique_ptr<ModelBeku> sekarang;
+    std::vector<std::pair<std::unique_ptr<ModelBeku>, uint64_t>> pensiun;
+    std::vector<std::unique_ptr<ModelBeku>> bekas;
+    long long versi_berikut = 0;
+
+    // Antrian event ke thread trainer //
+    std::thread trainer;
+    mutable std::mutex mtx;
+    std::condition_variable cv_kerja;
+    std::condition_variable cv_selesai;
+    std::deque<std::pair<Tensor, Tensor>> antrian;
+    size_t maks_antrian;
+    bool sibuk = false;
+    bool berhenti = false;
+
+    mutable std::mutex mtx_statistik;
+    StatistikOnline statistik;
+
+    // Snapshot yang sudah gak mungkin di pegang pembaca mana pun di pindah ke bekas //
+    void reklamasi() {
+        uint64_t minimum = DIAM;
+        for (const SlotPembaca& s : slot) {
+            minimum = std::min(minimum, s.epoch.load());
+        }
+        size_t tulis = 0;
+        long long direklamasi = 0;
+        for (size_t i = 0; i < pensiun.size(); ++i) {
+            if (pensiun[i].second <= minimum) {
+                if (bekas.size() < 2) bekas.push_back(std::move(pensiun[i].first));
+                ++direklamasi;
+            } else {
+                pensiun[tulis++] = std::move(pensiun[i]);
+            }
+        }
+        pensiun.resize(tulis);
+
+        std::lock_guard<std::mutex> lock(mtx_statistik);
+        statistik.direklamasi += direklamasi;
+        statistik.menunggu_reklamasi = static_cast<long long>(pensiun.size());
+    }
+
+    void loop() {
+        for (;;) {
+            std::pair<Tensor, Tensor> event;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_kerja.wait(lock, [&] { return berhenti || !antrian.empty(); });
+                if (antrian.empty()) return;
+                event = std::move(antrian.front());
+                antrian.pop_front();
+                sibuk = true;
+            }
+            cv_selesai.notify_all();   // Ada tempat kosong di antrian //
+            update(event.first, event.second);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                sibuk = false;
+            }
+            cv_selesai.notify_all();
+        }
+    }
+
+public:
+    // Snapshot pertama langsung di publikasi, jadi pembaca selalu dapat model //
+    explicit PelatihOnline(NeuralNetwork& nn_, int publikasi_setiap_ = 1, size_t maks_antrian_ = 1024)
+        : nn(nn_), publikasi_setiap(publikasi_setiap_), maks_antrian(maks_antrian_) {
+        assert(publikasi_setiap >= 1 && "Publikasi minimal setiap 1 langkah");
+        assert(maks_antrian >= 1 && "Antrian event minimal 1");
+        publikasi();
+    }
+
+    PelatihOnline(const PelatihOnline&) = delete;
+    PelatihOnline& operator=(const PelatihOnline&) = delete;
+
+    ~PelatihOnline() {
+        hentikan();
+        for (const SlotPembaca& s : slot) {
+            assert(!s.dipakai.load() && "Masih ada Pembaca yang hidup");
+            (void)s;
+        }
+    }
+
+    /*
+    Satu update incremental, lalu publikasi kalau sudah waktu nya.
+    Kalau gradient accumulation nya aktif, publikasi cuma di batas langkah optimizer.
+    */
+    double update(const Tensor& X, const Tensor& y) {
+        auto t0 = std::chrono::steady_clock::now();
+        const double loss = nn.train_step(X, y);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        {
+            std::lock_guard<std::mutex> lock(mtx_statistik);
+            ++statistik.update;
+            statistik.waktu_update_ms += ms;
+        }
+        if (nn.micro_batch_terkumpul() == 0 && nn.langkah() % publikasi_setiap == 0) {
+            publikasi();
+        }
+        return loss;
+    }
+
+    // Salin bobot sekarang ke snapshot baru dan tukar pointer nya //
+    void publikasi() {
+        auto t0 = std::chrono::steady_clock::now();
+        std::unique_ptr<ModelBeku> baru;
+        if (!bekas.empty()) {
+            baru = std::move(bekas.back());
+            bekas.pop_back();
+        } else {
+            baru.reset(new ModelBeku());
+        }
+        baru->isi_dari(nn);
+        baru->versi_ = versi_berikut++;
+
+        aktif.exchange(baru.get());
+        versi_aktif.store(baru->versi_, std::memory_order_release);
+        const uint64_t e = epoch_global.fetch_add(1) + 1;
+        if (sekarang) pensiun.emplace_back(std::move(sekarang), e);
+        sekarang = std::move(baru);
+        reklamasi();
+
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        std::lock_guard<std::mutex> lock(mtx_statistik);
+        ++statistik.publikasi;
+        statistik.waktu_publikasi_total_us += us;
+        statistik.waktu_publikasi_maks_us = std::max(statistik.waktu_publikasi_maks_us, us);
+    }
+
+    // Mulai thread trainer, setelah ini update nya lewat kirim() //
+    void mulai() {
+        std::lock_guard<std::mutex> lock(mtx);
+        assert(!trainer.joinable() && "Thread trainer sudah jalan");
+        berhenti = false;
+        trainer = std::thread([this] { loop(); });
+    }
+
+    // Serahkan event ke thread trainer. Nunggu kalau antrian nya penuh (backpressure) //
+    void kirim(Tensor X, Tensor y) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            assert(trainer.joinable() && "Panggil mulai() dulu");
+            cv_selesai.wait(lock, [&] { return antrian.size() < maks_antrian; });
+            antrian.emplace_back(std::move(X), std::move(y));
+        }
+        cv_kerja.notify_one();
+    }
+
+    // Tunggu sampai semua event yang sudah di kirim selesai di proses //
+    void tunggu() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_selesai.wait(lock, [&] { return antrian.empty() && !sibuk; });
+    }
+
+    // Proses sisa antrian lalu hentikan thread trainer //
+    void hentikan() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            berhenti = true;
+        }
+        cv_kerja.notify_all();
+        if (trainer.joinable()) trainer.join();
+    }
+
+    // Versi snapshot yang aktif sekarang (bisa ketinggalan sebentar dari pointer nya pas publikasi lagi jalan) //
+    long long versi() const {
+        return versi_aktif.load(std::memory_order_acquire);
+    }
+
+    StatistikOnline dapatkan_statistik() const {
+        StatistikOnline s;
+        {
+            std::lock_guard<std::mutex> lock(mtx_statistik);
+            s = statistik;
+        }
+        for (const SlotPembaca& sl : slot) {
+            s.pembacaan += sl.jumlah_baca.load(std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            s.event_antri = static_cast<long long>(antrian.size());
+        }
+        return s;
+    }
+};
+
+/*
+Handle pembaca, satu per thread (slot nya gak boleh di pakai dua thread bareng).
+baca() return Pandangan: selama Pandangan nya hidup, snapshot nya di jamin gak di pakai ulang.
+Pegang Pandangan nya sebentar saja, yang lama nahan reklamasi semua snapshot sesudah nya.
+*/
+class Pembaca {
+private:
+    PelatihOnline& pelatih;
+    SlotPembaca* s = nullptr;
+
+public:
+    class Pandangan {
+    private:
+        friend class Pembaca;
+        const ModelBeku* model;
+        SlotPembaca* s;
+
+        Pandangan(const ModelBeku* m, SlotPembaca* s_) : model(m), s(s_) {}
+
+    public:
+        Pandangan(const Pandangan&) = delete;
+        Pandangan& operator=(const Pandangan&) = delete;
+        Pandangan(Pandangan&& lain) noexcept : model(lain.model), s(lain.s) { lain.s = nullptr; }
+
+        ~Pandangan() {
+            if (s) s->epoch.store(DIAM, std::memory_order_release);
+        }
+
+        const ModelBeku& operator*() const { return *model; }
+        const ModelBeku* operator->() const { return model; }
+    };
+
+    explicit Pembaca(PelatihOnline& p) : pelatih(p) {
+        for (SlotPembaca& sl : pelatih.slot) {
+            bool kosong = false;
+            if (sl.dipakai.compare_exchange_strong(kosong, true)) {
+                s = &sl;
+                break;
+            }
+        }
+        // Bukan assert: tanpa slot, baca() gak bisa umumkan epoch nya dan reklamasi nya jadi gak aman //
+        if (!s) {
+            throw std::runtime_error("Pembaca: slot pembaca habis (MAKS_PEMBACA = " +
+                                     std::to_string(MAKS_PEMBACA) + ")");
+        }
+    }
+
+    Pembaca(const Pembaca&) = delete;
+    Pembaca& operator=(const Pembaca&) = delete;
+
+    ~Pembaca() {
+        if (!s) return;
+        s->epoch.store(DIAM);
+        s->dipakai.store(false);
+    }
+
+    // Umumkan epoch dulu, baru baca pointer nya (urutan ini yang bikin reklamasi nya aman) //
+    Pandangan baca() {
+        assert(s->epoch.load(std::memory_order_relaxed) == DIAM && "Pandangan sebelum nya masih hidup");
+        s->epoch.store(pelatih.epoch_global.load());
+        const ModelBeku* m = pelatih.aktif.load();
+        s->jumlah_baca.store(s->jumlah_baca.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return Pandangan(m, s);
+    }
+
+    Tensor predict(const Tensor& x) {
+        Pandangan m = baca();
+        return m->predict(x);
+    }
+};
+
+} // namespace online //
+} // namespace dl //
+
+#endif
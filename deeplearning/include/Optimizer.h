@@ -0,0 +1,354 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "Tensor.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+Keluarga optimizer dengan satu interface yang sama.
+Dulu NeuralNetwork langsung pakai satu class adam per Dense layer,
+dan setiap update nya bikin banyak Tensor sementara (m_hat, v_hat, sqrt, dll).
+
+Sekarang:
+1. Semua optimizer turunan dari dl::optim::Optimizer.
+2. Update nya satu loop fused per parameter, langsung in-place di bobot, tanpa Tensor sementara.
+3. State optimizer (momentum, m, v) semua parameter di simpan di SATU buffer contiguous.
+   Setiap parameter dapat slot: [offset, offset + jumlah_buffer * n) di buffer itu.
+4. Gradient dari input sparse cuma di update di kolom aktif nya (update_kolom), jadi biaya per langkah
+   nya ikut jumlah kolom yang muncul di batch, bukan ukuran bobot penuh.
+
+Yang tersedia:
+- SGD   : SGD dengan momentum (Nesterov atau klasik), weight decay L2 opsional.
+- AdamW : Adam dengan weight decay yang di pisah (decoupled). weight_decay = 0 sama persis dengan adam.
+- LAMB  : AdamW + trust ratio per layer (||w|| / ||update||), biar batch gede tetap konvergen.
+
+Cara pakai:
+    NeuralNetwork nn(dl::optim::lamb(0.01, 0.01));
+    // atau nn.atur_optimizer(dl::optim::sgd(0.1, 0.9)); //
+*/
+
+namespace dl {
+namespace optim {
+
+class Optimizer {
+protected:
+    // Slot satu parameter di buffer state //
+    struct Slot {
+        dl::index_t offset;
+        dl::index_t n;
+        bool weight_decay;
+    };
+
+    double lr;
+    long long t = 0;  // Jumlah langkah //
+    std::vector<Slot> slots;
+    Tensor::Storage state;  // Buffer contiguous buat semua state //
+
+    // Jumlah buffer state per elemen parameter (SGD 1, Adam 2) //
+    virtual int jumlah_buffer() const = 0;
+
+    // Pointer ke buffer state ke-k dari parameter id //
+    double* buffer(int id, int k) {
+        return state.data() + slots[id].offset + k * slots[id].n;
+    }
+
+public:
+    explicit Optimizer(double learning_rate) : lr(learning_rate) {}
+    virtual ~Optimizer() = default;
+
+    /*
+    Daftarkan parameter dengan n elemen, return id slot nya.
+    Slot baru di tempel di belakang buffer, jadi state parameter lama gak pindah isi.
+    weight_decay = false buat bias.
+    */
+    int daftar_parameter(dl::index_t n, bool weight_decay = true) {
+        DL_MEMORY_TAG("optim::state");
+        Slot s;
+        s.offset = static_cast<dl::index_t>(state.size());
+        s.n = n;
+        s.weight_decay = weight_decay;
+        slots.push_back(s);
+        state.resize(state.size() + static_cast<size_t>(jumlah_buffer() * n), 0.0);
+        return static_cast<int>(slots.size()) - 1;
+    }
+
+    // Panggil sekali di awal setiap langkah, sebelum update semua parameter //
+    void mulai_langkah() {
+        ++t;
+    }
+
+    // Update in-place: w[0..n) pakai gradient g[0..n) //
+    virtual void update(int id, double* w, const double* g, dl::index_t n) = 0;
+
+    /*
+    Update parameter matriks [baris, kolom] (row-major) tapi cuma di kolom aktif, buat gradient
+    dari input sparse (Dense::backward_sparse) yang kolom lain nya pasti nol.
+    Biaya nya O(baris * aktif.size()), bukan O(baris * kolom).
+    Semantik nya "lazy" (kek SparseAdam / LazyAdam): state dan weight decay kolom yang gak aktif
+    gak di sentuh di langkah ini, jadi momentum lama nya gak jalan terus di kolom itu.
+    Default nya update penuh, buat optimizer yang butuh semua elemen (LAMB, trust ratio nya norm penuh).
+    */
+    virtual void update_kolom(int id, double* w, const double* g, dl::index_t baris, dl::index_t kolom,
+                              const std::vector<dl::index_t>& aktif) {
+        (void)aktif;
+        update(id, w, g, baris * kolom);
+    }
+
+    virtual std::string nama() const = 0;
+
+    // Jenis optimizer tanpa hyperparameter, buat cek snapshot nya cocok (layout state nya tergantung jenis) //
+    virtual std::string jenis() const = 0;
+
+    void atur_learning_rate(double learning_rate) { lr = learning_rate; }
+    double dapatkan_learning_rate() const { return lr; }
+    long long langkah() const { return t; }
+
+    // Buffer state semua parameter, buat snapshot training (Snapshot.h) //
+    const Tensor::Storage& dapatkan_state() const { return state; }
+
+    // Pulihkan buffer state dan langkah t dari snapshot, return false (state gak di sentuh) kalau ukuran nya beda //
+    bool pulihkan_state(const double* data, size_t n, long long langkah_) {
+        if (n != state.size()) return false;
+        std::copy(data, data + n, state.begin());
+        t = langkah_;
+        return true;
+    }
+
+    size_t ukuran_state() const { return state.size(); }
+
+    // Ukuran buffer state dalam bytes //
+    long long bytes_state() const {
+        return static_cast<long long>(state.size()) * sizeof(double);
+    }
+};
+
+/*
+SGD dengan momentum:
+    g' = g + weight_decay * w
+    v  = momentum * v + g'
+    Nesterov: w = w - lr * (g' + momentum * v)
+    Klasik  : w = w - lr * v
+momentum = 0 jadi SGD biasa (sama kek Dense::update_bobot).
+*/
+class SGD : public Optimizer {
+private:
+    double momentum;
+    bool nesterov;
+    double weight_decay;
+
+protected:
+    int jumlah_buffer() const override { return 1; }
+
+    void langkah_elemen(double& w, double g, double& v, double wd) const {
+        const double gi = g + wd * w;
+        v = momentum * v + gi;
+        w -= lr * (nesterov ? gi + momentum * v : v);
+    }
+
+public:
+    SGD(double learning_rate = 0.01, double momentum_ = 0.9, bool nesterov_ = true, double weight_decay_ = 0.0)
+        : Optimizer(learning_rate), momentum(momentum_), nesterov(nesterov_), weight_decay(weight_decay_) {}
+
+    void update(int id, double* w, const double* g, dl::index_t n) override {
+        DL_PROFILE("optim::SGD", n);
+        assert(n == slots[id].n && "Ukuran parameter beda dengan slot nya");
+        double* v = buffer(id, 0);
+        const double wd = slots[id].weight_decay ? weight_decay : 0.0;
+
+        for (dl::index_t i = 0; i < n; ++i) {
+            langkah_elemen(w[i], g[i], v[i], wd);
+        }
+    }
+
+    void update_kolom(int id, double* w, const double* g, dl::index_t baris, dl::index_t kolom,
+                      const std::vector<dl::index_t>& aktif) override {
+        DL_PROFILE("optim::SGD", baris * static_cast<dl::index_t>(aktif.size()));
+        assert(baris * kolom == slots[id].n && "Ukuran parameter beda dengan slot nya");
+        double* v = buffer(id, 0);
+        const double wd = slots[id].weight_decay ? weight_decay : 0.0;
+        for (dl::index_t o = 0; o < baris; ++o) {
+            const dl::index_t awal = o * kolom;
+            for (dl::index_t k : aktif) {
+                langkah_elemen(w[awal + k], g[awal + k], v[awal + k], wd);
+            }
+        }
+    }
+
+    std::string nama() const override {
+        return std::string("SGD(lr=") + std::to_string(lr) + ", momentum=" + std::to_string(momentum) +
+               (nesterov ? ", nesterov" : "") + ")";
+    }
+
+    std::string jenis() const override { return "SGD"; }
+};
+
+/*
+AdamW:
+    m = beta1 * m + (1 - beta1) * g
+    v = beta2 * v + (1 - beta2) * g^2
+    w = w - lr * (m_hat / (sqrt(v_hat) + eps) + weight_decay * w)
+Weight decay nya langsung ke bobot, gak lewat gradient (decoupled),
+jadi gak ikut di skala sama sqrt(v_hat) kek L2 biasa di Adam.
+*/
+class AdamW : public Optimizer {
+protected:
+    double beta1;
+    double beta2;
+    double epsilon;
+    double weight_decay;
+
+    int jumlah_buffer() const override { return 2; }
+
+    void langkah_elemen(double& w, double g, double& m, double& v, double wd,
+                        double koreksi_bias1, double koreksi_bias2) const {
+        m = beta1 * m + (1 - beta1) * g;
+        v = beta2 * v + (1 - beta2) * (g * g);
+        const double m_hat = m / koreksi_bias1;
+        const double v_hat = v / koreksi_bias2;
+        double langkah = lr * m_hat / (std::sqrt(v_hat) + epsilon);
+        if (wd != 0.0) {
+            langkah += lr * wd * w;
+        }
+        w = w - langkah;
+    }
+
+public:
+    AdamW(double learning_rate = 0.001, double weight_decay_ = 0.01,
+          double b1 = 0.9, double b2 = 0.999, double eps = 1e-8)
+        : Optimizer(learning_rate), beta1(b1), beta2(b2), epsilon(eps), weight_decay(weight_decay_) {}
+
+    void update(int id, double* w, const double* g, dl::index_t n) override {
+        DL_PROFILE("optim::AdamW", n);
+        assert(n == slots[id].n && "Ukuran parameter beda dengan slot nya");
+        double* m = buffer(id, 0);
+        double* v = buffer(id, 1);
+        const double wd = slots[id].weight_decay ? weight_decay : 0.0;
+        const double koreksi_bias1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+        const double koreksi_bias2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+
+        for (dl::index_t i = 0; i < n; ++i) {
+            langkah_elemen(w[i], g[i], m[i], v[i], wd, koreksi_bias1, koreksi_bias2);
+        }
+    }
+
+    void update_kolom(int id, double* w, const double* g, dl::index_t baris, dl::index_t kolom,
+                      const std::vector<dl::index_t>& aktif) override {
+        DL_PROFILE("optim::AdamW", baris * static_cast<dl::index_t>(aktif.size()));
+        assert(baris * kolom == slots[id].n && "Ukuran parameter beda dengan slot nya");
+        double* m = buffer(id, 0);
+        double* v = buffer(id, 1);
+        const double wd = slots[id].weight_decay ? weight_decay : 0.0;
+        const double koreksi_bias1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+        const double koreksi_bias2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+        for (dl::index_t o = 0; o < baris; ++o) {
+            const dl::index_t awal = o * kolom;
+            for (dl::index_t k : aktif) {
+                const dl::index_t i = awal + k;
+                langkah_elemen(w[i], g[i], m[i], v[i], wd, koreksi_bias1, koreksi_bias2);
+            }
+        }
+    }
+
+    // weight_decay = 0 itu Adam biasa (default NeuralNetwork), jadi di tulis Adam //
+    std::string nama() const override {
+        if (weight_decay == 0.0) {
+            return std::string("Adam(lr=") + std::to_string(lr) + ")";
+        }
+        return std::string("AdamW(lr=") + std::to_string(lr) + ", weight_decay=" + std::to_string(weight_decay) + ")";
+    }
+
+    // Layout state nya sama dengan Adam, jadi snapshot Adam dan AdamW saling cocok //
+    std::string jenis() const override { return "AdamW"; }
+};
+
+/*
+LAMB (Layer-wise Adaptive Moments for Batch training):
+    r     = m_hat / (sqrt(v_hat) + eps) + weight_decay * w     (arah update AdamW)
+    trust = ||w|| / ||r||   (1 kalau salah satu nya nol)
+    w     = w - lr * trust * r
+Trust ratio nya per parameter (per layer), jadi layer yang bobot nya kecil gak di update kegedean.
+Ini yang bikin batch besar (learning rate besar) tetap stabil.
+
+Dua kali jalan per parameter: jalan pertama update m, v dan hitung norm,
+jalan kedua update bobot. r nya di hitung ulang dari m, v jadi gak butuh buffer tambahan.
+*/
+class LAMB : public AdamW {
+public:
+    LAMB(double learning_rate = 0.001, double weight_decay_ = 0.01,
+         double b1 = 0.9, double b2 = 0.999, double eps = 1e-6)
+        : AdamW(learning_rate, weight_decay_, b1, b2, eps) {}
+
+    void update(int id, double* w, const double* g, dl::index_t n) override {
+        DL_PROFILE("optim::LAMB", n);
+        assert(n == slots[id].n && "Ukuran parameter beda dengan slot nya");
+        double* m = buffer(id, 0);
+        double* v = buffer(id, 1);
+        const double wd = slots[id].weight_decay ? weight_decay : 0.0;
+        const double koreksi_bias1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+        const double koreksi_bias2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+
+        double norm_w = 0.0;
+        double norm_r = 0.0;
+        for (dl::index_t i = 0; i < n; ++i) {
+            m[i] = beta1 * m[i] + (1 - beta1) * g[i];
+            v[i] = beta2 * v[i] + (1 - beta2) * (g[i] * g[i]);
+            const double r = (m[i] / koreksi_bias1) / (std::sqrt(v[i] / koreksi_bias2) + epsilon) + wd * w[i];
+            norm_w += w[i] * w[i];
+            norm_r += r * r;
+        }
+        norm_w = std::sqrt(norm_w);
+        norm_r = std::sqrt(norm_r);
+        const double trust = (norm_w > 0.0 && norm_r > 0.0) ? norm_w / norm_r : 1.0;
+        const double skala = lr * trust;
+
+        for (dl::index_t i = 0; i < n; ++i) {
+            const double r = (m[i] / koreksi_bias1) / (std::sqrt(v[i] / koreksi_bias2) + epsilon) + wd * w[i];
+            w[i] -= skala * r;
+        }
+    }
+
+    // Trust ratio nya butuh norm seluruh parameter, jadi update kolom nya tetap penuh //
+    void update_kolom(int id, double* w, const double* g, dl::index_t baris, dl::index_t kolom,
+                      const std::vector<dl::index_t>& aktif) override {
+        Optimizer::update_kolom(id, w, g, baris, kolom, aktif);
+    }
+
+    std::string nama() const override {
+        return std::string("LAMB(lr=") + std::to_string(lr) + ", weight_decay=" + std::to_string(weight_decay) + ")";
+    }
+
+    std::string jenis() const override { return "LAMB"; }
+};
+
+// FACTORY //
+inline std::unique_ptr<Optimizer> sgd(double lr = 0.01, double momentum = 0.9,
+                                      bool nesterov = true, double weight_decay = 0.0) {
+    return std::make_unique<SGD>(lr, momentum, nesterov, weight_decay);
+}
+
+inline std::unique_ptr<Optimizer> adamw(double lr = 0.001, double weight_decay = 0.01,
+                                        double beta1 = 0.9, double beta2 = 0.999, double eps = 1e-8) {
+    return std::make_unique<AdamW>(lr, weight_decay, beta1, beta2, eps);
+}
+
+// Adam biasa = AdamW tanpa weight decay //
+inline std::unique_ptr<Optimizer> adam(double lr = 0.001, double beta1 = 0.9,
+                                       double beta2 = 0.999, double eps = 1e-8) {
+    return std::make_unique<AdamW>(lr, 0.0, beta1, beta2, eps);
+}
+
+inline std::unique_ptr<Optimizer> lamb(double lr = 0.001, double weight_decay = 0.01,
+                                       double beta1 = 0.9, double beta2 = 0.999, double eps = 1e-6) {
+    return std::make_unique<LAMB>(lr, weight_decay, beta1, beta2, eps);
+}
+
+} // namespace optim //
+} // namespace dl //
+
+#endif
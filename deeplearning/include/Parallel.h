@@ -0,0 +1,202 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "Tensor.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Thread pool sederhana buat parallel_for.
+Thread nya di buat sekali (lazy, pas parallel_for pertama) dan di pakai ulang,
+jadi gak bayar biaya bikin thread setiap panggilan.
+
+Cara pakai:
+    dl::parallel_for(0, n, 4096, [&](dl::index_t mulai, dl::index_t akhir) {
+        for (dl::index_t i = mulai; i < akhir; ++i) out[i] = ...;
+    });
+
+Range [mulai, akhir) di potong jadi chunk minimal `grain` elemen,
+chunk nya di ambil bergantian oleh worker dan thread pemanggil.
+Kalau range nya lebih kecil dari grain, atau di panggil dari dalam parallel_for lain (nested),
+langsung jalan di thread pemanggil tanpa sinkronisasi.
+
+Jumlah thread bawaan = std::thread::hardware_concurrency(),
+bisa di ganti pakai env DL_NUM_THREADS atau dl::atur_jumlah_thread(n).
+Fungsi f gak boleh bergantung ke urutan chunk atau ke jumlah thread,
+supaya hasil nya sama persis berapa pun thread nya.
+*/
+
+namespace dl {
+namespace parallel {
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable cv_kerja;
+    std::condition_variable cv_selesai;
+
+    // Job yang sedang jalan //
+    const std::function<void(index_t, index_t)>* fungsi = nullptr;
+    index_t job_mulai = 0;
+    index_t job_akhir = 0;
+    index_t job_grain = 1;
+    std::atomic<index_t> chunk_berikut{0};
+    index_t jumlah_chunk = 0;
+    std::atomic<index_t> chunk_selesai{0};
+    long long generasi = 0;
+    int worker_aktif = 0;
+    bool berhenti = false;
+
+    static bool& di_dalam_parallel() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    // Ambil dan kerjakan chunk sampai habis //
+    void kerjakan_chunk() {
+        index_t selesai = 0;
+        for (;;) {
+            // acquire: pasangan store release di jalankan(), biar field job nya kelihatan //
+            const index_t c = chunk_berikut.fetch_add(1, std::memory_order_acquire);
+            if (c >= jumlah_chunk) break;
+            const index_t a = job_mulai + c * job_grain;
+            const index_t b = std::min(job_akhir, a + job_grain);
+            (*fungsi)(a, b);
+            ++selesai;
+        }
+        if (selesai > 0 &&
+            chunk_selesai.fetch_add(selesai, std::memory_order_acq_rel) + selesai == jumlah_chunk) {
+            std::lock_guard<std::mutex> lock(mtx);
+            cv_selesai.notify_all();
+        }
+    }
+
+    void loop_worker() {
+        di_dalam_parallel() = true;
+        long long generasi_terakhir = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_kerja.wait(lock, [&] { return berhenti || generasi != generasi_terakhir; });
+                if (berhenti) return;
+                generasi_terakhir = generasi;
+                ++worker_aktif;
+            }
+            kerjakan_chunk();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (--worker_aktif == 0) cv_selesai.notify_all();
+            }
+        }
+    }
+
+    void hentikan() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            berhenti = true;
+        }
+        cv_kerja.notify_all();
+        for (auto& t : workers) t.join();
+        workers.clear();
+        berhenti = false;
+    }
+
+public:
+    explicit ThreadPool(int n_thread) { atur_jumlah_thread(n_thread); }
+    ~ThreadPool() { hentikan(); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Total thread yang ikut kerja, termasuk thread pemanggil //
+    int jumlah_thread() const { return static_cast<int>(workers.size()) + 1; }
+
+    void atur_jumlah_thread(int n) {
+        assert(!di_dalam_parallel() && "Gak bisa ganti jumlah thread dari dalam parallel_for");
+        hentikan();
+        n = std::max(1, n);
+        for (int i = 0; i < n - 1; ++i) {
+            workers.emplace_back([this] { loop_worker(); });
+        }
+    }
+
+    void jalankan(index_t mulai, index_t akhir, index_t grain,
+                  const std::function<void(index_t, index_t)>& f) {
+        if (akhir <= mulai) return;
+        grain = std::max<index_t>(1, grain);
+        if (workers.empty() || di_dalam_parallel() || akhir - mulai <= grain) {
+            f(mulai, akhir);
+            return;
+        }
+
+        // Satu job dalam satu waktu, pemanggil dari thread lain nunggu giliran //
+        static std::mutex mtx_job;
+        std::lock_guard<std::mutex> lock_job(mtx_job);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            fungsi = &f;
+            job_mulai = mulai;
+            job_akhir = akhir;
+            job_grain = grain;
+            jumlah_chunk = (akhir - mulai + grain - 1) / grain;
+            chunk_selesai.store(0, std::memory_order_relaxed);
+            chunk_berikut.store(0, std::memory_order_release);
+            ++generasi;
+        }
+        cv_kerja.notify_all();
+
+        di_dalam_parallel() = true;
+        kerjakan_chunk();
+        di_dalam_parallel() = false;
+
+        // Tunggu semua chunk selesai dan semua worker keluar dari job ini //
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_selesai.wait(lock, [&] {
+            return chunk_selesai.load(std::memory_order_acquire) == jumlah_chunk && worker_aktif == 0;
+        });
+        fungsi = nullptr;
+    }
+};
+
+inline int jumlah_thread_bawaan() {
+    if (const char* env = std::getenv("DL_NUM_THREADS")) {
+        const int n = std::atoi(env);
+        if (n > 0) return n;
+    }
+    const unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? static_cast<int>(n) : 1;
+}
+
+inline ThreadPool& pool() {
+    static ThreadPool p(jumlah_thread_bawaan());
+    return p;
+}
+
+} // namespace parallel //
+
+// Jalankan f(mulai_chunk, akhir_chunk) paralel di atas [mulai, akhir) //
+template <typename F>
+inline void parallel_for(index_t mulai, index_t akhir, index_t grain, F&& f) {
+    const std::function<void(index_t, index_t)> fungsi = std::forward<F>(f);
+    parallel::pool().jalankan(mulai, akhir, grain, fungsi);
+}
+
+inline int jumlah_thread() {
+    return parallel::pool().jumlah_thread();
+}
+
+inline void atur_jumlah_thread(int n) {
+    parallel::pool().atur_jumlah_thread(n);
+}
+
+} // namespace dl //
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+Profiler ini buat ngintip apa yang terjadi di dalam setiap kernel.
+Kalau cuma pakai waktu (wall time) kita gak tau apakah Dense itu
+lambat karna kebanyakan hitungan (compute-bound) atau karna nunggu memori (cache-bound).
+Jadi gw pakai perf_event_open dari Linux buat baca hardware counter:
+cycles, instructions, L1D miss, LLC miss, dan branch miss.
+
+Dari situ kita bisa dapat:
+IPC = instructions / cycles  (makin tinggi makin "sibuk ngitung")
+miss per elemen = miss / jumlah elemen yang di proses
+
+Default nya mati, jadi gak ada biaya selain satu cek boolean.
+Kalau counter gak bisa di buka (misal di container atau perf_event_paranoid tinggi),
+profiler tetap jalan tapi cuma ngukur waktu saja.
+*/
+
+namespace dl {
+namespace profiler {
+
+// Jenis counter yang kita baca //
+enum Counter {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    L1D_MISS,
+    LLC_MISS,
+    BRANCH_MISS,
+    JUMLAH_COUNTER
+};
+
+inline const char* nama_counter(int c) {
+    static const char* nama[JUMLAH_COUNTER] = {
+        "cycles", "instructions", "L1D miss", "LLC miss", "branch miss"
+    };
+    return nama[c];
+}
+
+// Statistik yang di kumpulkan per call site (misal "Dense::forward") //
+struct Statistik {
+    uint64_t panggilan = 0;
+    uint64_t elemen = 0;
+    double waktu_ns = 0.0;
+    uint64_t counter[JUMLAH_COUNTER] = {};
+    bool counter_valid[JUMLAH_COUNTER] = {};
+
+    // IPC = instructions / cycles //
+    double ipc() const {
+        if (!counter_valid[CYCLES] || !counter_valid[INSTRUCTIONS] || counter[CYCLES] == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(counter[INSTRUCTIONS]) / counter[CYCLES];
+    }
+
+    // Jumlah event per elemen yang di proses //
+    double per_elemen(int c) const {
+        if (!counter_valid[c] || elemen == 0) return 0.0;
+        return static_cast<double>(counter[c]) / elemen;
+    }
+};
+
+namespace detail {
+
+// State global profiler //
+// aktif dan pakai_counter_hw bisa di ubah selagi thread worker lagi di dalam DL_PROFILE, jadi atomic //
+struct State {
+    std::atomic<bool> aktif{false};
+    std::atomic<bool> pakai_counter_hw{true};
+    std::mutex mtx;
+    std::map<std::string, Statistik> per_site;
+};
+
+inline State& state() {
+    static State s;
+    return s;
+}
+
+/*
+Satu set counter per thread.
+Gw buka sebagai group dengan leader = cycles, biar cukup satu read() syscall
+buat baca semua counter sekaligus.
+Kalau ada counter yang gagal di buka (misal LLC gak di support di VM), counter itu di lewati saja.
+*/
+class PerfCounters {
+private:
+    int fd[JUMLAH_COUNTER];
+    int slot[JUMLAH_COUNTER];   // Posisi counter dalam hasil read group //
+    int jumlah_terbuka;
+    bool tersedia_;
+
+#ifdef __linux__
+    static int buka_event(uint32_t type, uint64_t config, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = (group_fd == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+#endif
+
+public:
+    PerfCounters() : jumlah_terbuka(0), tersedia_(false) {
+        for (int c = 0; c < JUMLAH_COUNTER; ++c) {
+            fd[c] = -1;
+            slot[c] = -1;
+        }
+#ifdef __linux__
+        const uint32_t types[JUMLAH_COUNTER] = {
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_HW_CACHE,
+            PERF_TYPE_HARDWARE,
+            PERF_TYPE_HARDWARE
+        };
+        const uint64_t configs[JUMLAH_COUNTER] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D
+                | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+
+        // Leader dulu (cycles), kalau gagal berarti counter gak tersedia sama sekali //
+        fd[CYCLES] = buka_event(types[CYCLES], configs[CYCLES], -1);
+        if (fd[CYCLES] < 0) {
+            return;
+        }
+        slot[CYCLES] = jumlah_terbuka++;
+
+        for (int c = CYCLES + 1; c < JUMLAH_COUNTER; ++c) {
+            fd[c] = buka_event(types[c], configs[c], fd[CYCLES]);
+            if (fd[c] >= 0) {
+                slot[c] = jumlah_terbuka++;
+            }
+        }
+
+        ioctl(fd[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fd[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        tersedia_ = true;
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int c = 0; c < JUMLAH_COUNTER; ++c) {
+            if (fd[c] >= 0) close(fd[c]);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool tersedia() const { return tersedia_; }
+    bool valid(int c) const { return slot[c] >= 0; }
+
+    // Baca nilai semua counter sekarang //
+    bool baca(uint64_t out[JUMLAH_COUNTER]) const {
+#ifdef __linux__
+        if (!tersedia_) return false;
+        uint64_t buf[1 + JUMLAH_COUNTER];
+        ssize_t n = read(fd[CYCLES], buf, sizeof(buf));
+        if (n < static_cast<ssize_t>(sizeof(uint64_t) * (1 + jumlah_terbuka))) {
+            return false;
+        }
+        for (int c = 0; c < JUMLAH_COUNTER; ++c) {
+            out[c] = (slot[c] >= 0) ? buf[1 + slot[c]] : 0;
+        }
+        return true;
+#else
+        (void)out;
+        return false;
+#endif
+    }
+};
+
+inline PerfCounters& counter_thread() {
+    thread_local PerfCounters pc;
+    return pc;
+}
+
+} // namespace detail //
+
+// API publik //
+
+// Nyalakan profiler. Kalau counter_hw = false, cuma ngukur waktu //
+inline void aktifkan(bool counter_hw = true) {
+    detail::state().pakai_counter_hw.store(counter_hw, std::memory_order_relaxed);
+    detail::state().aktif.store(true, std::memory_order_release);
+}
+
+inline void nonaktifkan() {
+    detail::state().aktif.store(false, std::memory_order_release);
+}
+
+inline bool aktif() {
+    return detail::state().aktif.load(std::memory_order_acquire);
+}
+
+// Apakah hardware counter bisa di pakai di thread ini //
+inline bool counter_hw_tersedia() {
+    return detail::counter_thread().tersedia();
+}
+
+// Hapus semua statistik yang sudah terkumpul //
+inline void reset() {
+    std::lock_guard<std::mutex> lock(detail::state().mtx);
+    detail::state().per_site.clear();
+}
+
+// Ambil salinan statistik per call site //
+inline std::map<std::string, Statistik> statistik() {
+    std::lock_guard<std::mutex> lock(detail::state().mtx);
+    return detail::state().per_site;
+}
+
+/*
+Scope ini RAII, jadi cukup taruh di awal kernel:
+    DL_PROFILE("Dense::forward", batch * in * out);
+Nanti pas keluar scope, waktu dan counter nya otomatis di catat.
+*/
+class Scope {
+private:
+    const char* nama;
+    uint64_t elemen;
+    bool aktif_;
+    bool pakai_hw;
+    uint64_t awal[JUMLAH_COUNTER];
+    std::chrono::steady_clock::time_point t0;
+
+public:
+    Scope(const char* nama_, uint64_t elemen_)
+        : nama(nama_), elemen(elemen_), aktif_(detail::state().aktif.load(std::memory_order_relaxed)), pakai_hw(false) {
+        // Load relaxed di sini, ini jalan di setiap kernel; telat satu-dua scope pas toggle gak masalah //
+        if (!aktif_) return;
+        if (detail::state().pakai_counter_hw.load(std::memory_order_relaxed)) {
+            pakai_hw = detail::counter_thread().baca(awal);
+        }
+        t0 = std::chrono::steady_clock::now();
+    }
+
+    ~Scope() {
+        if (!aktif_) return;
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t akhir[JUMLAH_COUNTER];
+        bool hw_ok = pakai_hw && detail::counter_thread().baca(akhir);
+
+        std::lock_guard<std::mutex> lock(detail::state().mtx);
+        Statistik& s = detail::state().per_site[nama];
+        s.panggilan += 1;
+        s.elemen += elemen;
+        s.waktu_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        if (hw_ok) {
+            for (int c = 0; c < JUMLAH_COUNTER; ++c) {
+                if (detail::counter_thread().valid(c)) {
+                    s.counter[c] += akhir[c] - awal[c];
+                    s.counter_valid[c] = true;
+                }
+            }
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+// Cetak laporan per call site //
+inline void laporan(std::ostream& os = std::cout) {
+    auto data = statistik();
+    os << "======== Laporan Profiler ========" << std::endl;
+    if (!counter_hw_tersedia() || !detail::state().pakai_counter_hw.load(std::memory_order_relaxed)) {
+        os << "(counter HW tidak tersedia, hanya waktu)" << std::endl;
+    }
+    for (const auto& kv : data) {
+        const Statistik& s = kv.second;
+        os << kv.first << std::endl;
+        os << "  panggilan: " << s.panggilan
+           << "  total: " << std::fixed << std::setprecision(3) << s.waktu_ns / 1e6 << " ms"
+           << "  ns/elemen: " << std::setprecision(3)
+           << (s.elemen ? s.waktu_ns / s.elemen : 0.0) << std::endl;
+        if (s.counter_valid[CYCLES]) {
+            os << "  IPC: " << std::setprecision(2) << s.ipc();
+            for (int c = L1D_MISS; c < JUMLAH_COUNTER; ++c) {
+                if (s.counter_valid[c]) {
+                    os << "  " << nama_counter(c) << "/elemen: "
+                       << std::setprecision(4) << s.per_elemen(c);
+                }
+            }
+            os << std::endl;
+        }
+    }
+    os << "==================================" << std::endl;
+}
+
+} // namespace profiler //
+} // namespace dl //
+
+// Macro biar nama variabel scope nya unik per baris //
+#define DL_PROFILE_CONCAT_INNER(a, b) a##b
+#define DL_PROFILE_CONCAT(a, b) DL_PROFILE_CONCAT_INNER(a, b)
+#define DL_PROFILE(nama, elemen) \
+    dl::profiler::Scope DL_PROFILE_CONCAT(dl_profile_scope_, __LINE__)((nama), static_cast<uint64_t>(elemen))
+
+#endif
@@ -0,0 +1,381 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include "Tensor.h"
+#include "Parallel.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+/*
+Random number generator berbasis counter: Philox4x32-10 (Salmon dkk, "Parallel Random Numbers: As Easy as 1, 2, 3").
+std::mt19937 itu sequential: angka ke-i baru bisa di dapat setelah i-1 angka sebelum nya,
+jadi isi tensor random gak bisa di paralel dan gak thread-safe.
+
+Philox itu fungsi murni: blok(counter, key) -> 4 x 32 bit random.
+Angka ke-i cukup di hitung dari counter i, gak perlu state sebelum nya. Jadi:
+1. Tensor bisa di isi paralel (dl::parallel_for), setiap thread ngitung bagian nya sendiri.
+2. Hasil nya sama persis berapa pun jumlah thread nya, karna elemen ke-i selalu pakai counter yang sama.
+3. Satu batch 8 blok sekaligus tanpa dependensi antar blok, pakai AVX2 kalau CPU nya ada
+   (hasil integer nya sama persis dengan versi scalar).
+
+Generator global nya nyimpen seed (key) dan offset (counter berikut nya).
+Setiap panggilan factory ambil range counter [offset, offset + jumlah_blok) secara atomic,
+jadi dua thread yang bikin tensor barengan gak pernah dapat angka yang sama.
+dl::manual_seed(s) set key = s dan offset = 0.
+
+Satu blok (4 x 32 bit) = 2 angka double 53-bit:
+- uniform: u = (64 bit >> 11) * 2^-53, di [0, 1)
+- normal : Box-Muller dari 2 uniform satu blok, dapat 2 angka normal
+
+Hasil nya sama persis berapa pun jumlah thread nya di mesin yang sama.
+Antar CPU yang beda (AVX2+FMA vs scalar), randn bisa beda di bit terakhir karna FMA.
+*/
+
+namespace dl {
+namespace random {
+
+// Satu blok Philox4x32-10 //
+struct Blok {
+    uint32_t v[4];
+};
+
+namespace detail {
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int LANE = 8;
+
+/*
+Hitung LANE blok sekaligus, counter [c, c + LANE), disimpan per komponen (SoA)
+biar setiap ronde nya operasi yang sama di 8 lane (gampang di vectorize).
+*/
+inline void philox_lane(uint64_t counter, uint64_t key, uint32_t out[4][LANE]) {
+    uint32_t c0[LANE], c1[LANE], c2[LANE], c3[LANE];
+    for (int l = 0; l < LANE; ++l) {
+        const uint64_t c = counter + static_cast<uint64_t>(l);
+        c0[l] = static_cast<uint32_t>(c);
+        c1[l] = static_cast<uint32_t>(c >> 32);
+        c2[l] = 0;
+        c3[l] = 0;
+    }
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int ronde = 0; ronde < 10; ++ronde) {
+        for (int l = 0; l < LANE; ++l) {
+            const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[l];
+            const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[l];
+            const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+            const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+            c0[l] = hi1 ^ c1[l] ^ k0;
+            c1[l] = lo1;
+            c2[l] = hi0 ^ c3[l] ^ k1;
+            c3[l] = lo0;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    for (int l = 0; l < LANE; ++l) {
+        out[0][l] = c0[l];
+        out[1][l] = c1[l];
+        out[2][l] = c2[l];
+        out[3][l] = c3[l];
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+inline bool cpu_avx2() {
+    static const bool ada = __builtin_cpu_supports("avx2");
+    return ada;
+}
+
+inline bool cpu_avx2_fma() {
+    return dl::fastmath::detail::cpu_avx2_fma();
+}
+
+// Sama persis dengan philox_lane, tapi 8 lane nya di 2 register AVX2 (perkalian 32x32 -> 64 pakai mul_epu32) //
+__attribute__((target("avx2")))
+inline void philox_lane_avx2(uint64_t counter, uint64_t key, uint32_t out[4][LANE]) {
+    // Satu lane 64-bit = satu blok: a01 = c0 (32 bit bawah) | c1 (32 bit atas), a23 = c2 | c3, 4 blok per register //
+    alignas(32) uint64_t awal[LANE];
+    for (int l = 0; l < LANE; ++l) awal[l] = counter + static_cast<uint64_t>(l);
+    __m256i a01[2], a23[2];
+    for (int h = 0; h < 2; ++h) {
+        a01[h] = _mm256_load_si256(reinterpret_cast<const __m256i*>(awal + 4 * h));
+        a23[h] = _mm256_setzero_si256();
+    }
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi64x(PHILOX_M1);
+    const __m256i mask_lo = _mm256_set1_epi64x(0xFFFFFFFFll);
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+
+    for (int ronde = 0; ronde < 10; ++ronde) {
+        // Key nya di 32 bit bawah (atas nya nol), posisi c0' / c2' yang baru, karna hi hasil kali sudah di geser turun ke situ //
+        const __m256i kk0 = _mm256_set1_epi64x(static_cast<long long>(static_cast<uint64_t>(k0)));
+        const __m256i kk1 = _mm256_set1_epi64x(static_cast<long long>(static_cast<uint64_t>(k1)));
+        for (int h = 0; h < 2; ++h) {
+            const __m256i p0 = _mm256_mul_epu32(a01[h], m0);   // M0 * c0 //
+            const __m256i p1 = _mm256_mul_epu32(a23[h], m1);   // M1 * c2 //
+            const __m256i c1 = _mm256_srli_epi64(a01[h], 32);
+            const __m256i c3 = _mm256_srli_epi64(a23[h], 32);
+            // c0' = hi1 ^ c1 ^ k0, c1' = lo1, c2' = hi0 ^ c3 ^ k1, c3' = lo0 //
+            const __m256i n0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), kk0);
+            const __m256i n2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), kk1);
+            a01[h] = _mm256_or_si256(n0, _mm256_slli_epi64(_mm256_and_si256(p1, mask_lo), 32));
+            a23[h] = _mm256_or_si256(n2, _mm256_slli_epi64(_mm256_and_si256(p0, mask_lo), 32));
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    alignas(32) uint64_t v01[LANE], v23[LANE];
+    for (int h = 0; h < 2; ++h) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(v01 + 4 * h), a01[h]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(v23 + 4 * h), a23[h]);
+    }
+    for (int l = 0; l < LANE; ++l) {
+        out[0][l] = static_cast<uint32_t>(v01[l]);
+        out[1][l] = static_cast<uint32_t>(v01[l] >> 32);
+        out[2][l] = static_cast<uint32_t>(v23[l]);
+        out[3][l] = static_cast<uint32_t>(v23[l] >> 32);
+    }
+}
+#define DL_RANDOM_X86 1
+#endif
+
+inline void philox_batch(uint64_t counter, uint64_t key, uint32_t out[4][LANE]) {
+#ifdef DL_RANDOM_X86
+    if (cpu_avx2()) {
+        philox_lane_avx2(counter, key, out);
+        return;
+    }
+#endif
+    philox_lane(counter, key, out);
+}
+
+/*
+sin dan cos dari 2 pi u, u di [0, 1), buat Box-Muller.
+u di potong ke kuadran q = round(4u), sisa nya x = 2 pi (u - q/4) di [-pi/4, pi/4],
+lalu Taylor sampai x^17 / x^16 (error < 1e-16), terus di putar sesuai kuadran.
+Branch-free dan gak manggil libm, jauh lebih cepat dari std::sin + std::cos.
+*/
+inline void sincos_putaran(double u, double& s, double& c) {
+    const double q = std::floor(4.0 * u + 0.5);
+    const double x = 6.283185307179586 * (u - 0.25 * q);
+    const double x2 = x * x;
+    double ps = -1.0 / 355687428096000.0;
+    ps = ps * x2 + 1.0 / 1307674368000.0;
+    ps = ps * x2 - 1.0 / 6227020800.0;
+    ps = ps * x2 + 1.0 / 39916800.0;
+    ps = ps * x2 - 1.0 / 362880.0;
+    ps = ps * x2 + 1.0 / 5040.0;
+    ps = ps * x2 - 1.0 / 120.0;
+    ps = ps * x2 + 1.0 / 6.0;
+    const double sx = x - x * x2 * ps;
+    double pc = 1.0 / 20922789888000.0;
+    pc = pc * x2 - 1.0 / 87178291200.0;
+    pc = pc * x2 + 1.0 / 479001600.0;
+    pc = pc * x2 - 1.0 / 3628800.0;
+    pc = pc * x2 + 1.0 / 40320.0;
+    pc = pc * x2 - 1.0 / 720.0;
+    pc = pc * x2 + 1.0 / 24.0;
+    pc = pc * x2 - 0.5;
+    const double cx = 1.0 + x2 * pc;
+    // Kuadran 0: (s, c), 1: (c, -s), 2: (-s, -c), 3: (-c, s), 4 = 0 //
+    const int k = static_cast<int>(q) & 3;
+    const double a = (k & 1) ? cx : sx;
+    const double b = (k & 1) ? sx : cx;
+    s = (k & 2) ? -a : a;
+    c = ((k + 1) & 2) ? -b : b;
+}
+
+#ifdef DL_RANDOM_X86
+// Box-Muller 4 pasangan sekaligus, rumus nya sama dengan versi scalar (log_avx2 dari FastMath.h) //
+__attribute__((target("avx2,fma")))
+inline void box_muller_avx2(const double* u0, const double* u1, double* a, double* b, double mean, double std) {
+    const __m256d satu = _mm256_set1_pd(1.0);
+    for (int h = 0; h < LANE; h += 4) {
+        const __m256d v0 = _mm256_loadu_pd(u0 + h);
+        const __m256d v1 = _mm256_loadu_pd(u1 + h);
+        const __m256d lg = dl::fastmath::detail::log_avx2(_mm256_sub_pd(satu, v0));
+        const __m256d r = _mm256_sqrt_pd(_mm256_mul_pd(_mm256_set1_pd(-2.0), lg));
+
+        const __m256d q = _mm256_floor_pd(_mm256_fmadd_pd(_mm256_set1_pd(4.0), v1, _mm256_set1_pd(0.5)));
+        const __m256d x = _mm256_mul_pd(_mm256_set1_pd(6.283185307179586),
+                                        _mm256_fnmadd_pd(_mm256_set1_pd(0.25), q, v1));
+        const __m256d x2 = _mm256_mul_pd(x, x);
+        __m256d ps = _mm256_set1_pd(-1.0 / 355687428096000.0);
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1.0 / 1307674368000.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 6227020800.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1.0 / 39916800.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 362880.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1.0 / 5040.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(-1.0 / 120.0));
+        ps = _mm256_fmadd_pd(ps, x2, _mm256_set1_pd(1.0 / 6.0));
+        const __m256d sx = _mm256_fnmadd_pd(_mm256_mul_pd(x, x2), ps, x);
+        __m256d pc = _mm256_set1_pd(1.0 / 20922789888000.0);
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 87178291200.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(1.0 / 479001600.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 3628800.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(1.0 / 40320.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-1.0 / 720.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(1.0 / 24.0));
+        pc = _mm256_fmadd_pd(pc, x2, _mm256_set1_pd(-0.5));
+        const __m256d cx = _mm256_fmadd_pd(x2, pc, satu);
+
+        // Kuadran k = q mod 4 //
+        const __m256d k = _mm256_sub_pd(q, _mm256_mul_pd(_mm256_set1_pd(4.0),
+                                        _mm256_floor_pd(_mm256_mul_pd(q, _mm256_set1_pd(0.25)))));
+        const __m256d ganjil = _mm256_or_pd(_mm256_cmp_pd(k, satu, _CMP_EQ_OQ),
+                                            _mm256_cmp_pd(k, _mm256_set1_pd(3.0), _CMP_EQ_OQ));
+        const __m256d neg_s = _mm256_cmp_pd(k, _mm256_set1_pd(1.5), _CMP_GT_OQ);
+        const __m256d neg_c = _mm256_and_pd(_mm256_cmp_pd(k, _mm256_set1_pd(0.5), _CMP_GT_OQ),
+                                            _mm256_cmp_pd(k, _mm256_set1_pd(2.5), _CMP_LT_OQ));
+        const __m256d tanda = _mm256_set1_pd(-0.0);
+        __m256d sn = _mm256_blendv_pd(sx, cx, ganjil);
+        __m256d cs = _mm256_blendv_pd(cx, sx, ganjil);
+        sn = _mm256_xor_pd(sn, _mm256_and_pd(neg_s, tanda));
+        cs = _mm256_xor_pd(cs, _mm256_and_pd(neg_c, tanda));
+
+        _mm256_storeu_pd(a + h, _mm256_fmadd_pd(_mm256_set1_pd(std), _mm256_mul_pd(r, cs), _mm256_set1_pd(mean)));
+        _mm256_storeu_pd(b + h, _mm256_fmadd_pd(_mm256_set1_pd(std), _mm256_mul_pd(r, sn), _mm256_set1_pd(mean)));
+    }
+}
+#endif
+
+// 64 bit -> double di [0, 1) //
+inline double ke_uniform(uint32_t lo, uint32_t hi) {
+    const uint64_t u = (static_cast<uint64_t>(hi) << 32) | lo;
+    return static_cast<double>(u >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace detail //
+
+// Satu blok Philox (buat test / pemakaian manual) //
+inline Blok philox(uint64_t counter, uint64_t key) {
+    uint32_t out[4][detail::LANE];
+    detail::philox_lane(counter, key, out);
+    return Blok{{out[0][0], out[1][0], out[2][0], out[3][0]}};
+}
+
+/*
+Isi dst[0..n) dari blok counter [counter, counter + ceil(n/2)).
+Elemen ke-i pakai blok counter + i/2, jadi bebas di potong per chunk genap.
+ubah(u0, u1, a, b) ngubah LANE pasang uniform jadi LANE pasang output (selalu LANE penuh,
+biar hasil elemen terakhir sama dengan kalau dia ada di tengah batch).
+*/
+template <typename F>
+inline void isi_blok(double* dst, index_t n, uint64_t counter, uint64_t key, F&& ubah) {
+    uint32_t out[4][detail::LANE];
+    double u0[detail::LANE], u1[detail::LANE], a[detail::LANE], b[detail::LANE];
+    const index_t n_blok = (n + 1) / 2;
+    for (index_t b0 = 0; b0 < n_blok; b0 += detail::LANE) {
+        detail::philox_batch(counter + static_cast<uint64_t>(b0), key, out);
+        for (int l = 0; l < detail::LANE; ++l) {
+            u0[l] = detail::ke_uniform(out[0][l], out[1][l]);
+            u1[l] = detail::ke_uniform(out[2][l], out[3][l]);
+        }
+        ubah(u0, u1, a, b);
+        const int m = static_cast<int>(std::min<index_t>(detail::LANE, n_blok - b0));
+        for (int l = 0; l < m; ++l) {
+            const index_t i = 2 * (b0 + l);
+            dst[i] = a[l];
+            if (i + 1 < n) dst[i + 1] = b[l];
+        }
+    }
+}
+
+// Generator: key (seed) + offset counter //
+class Generator {
+private:
+    std::atomic<uint64_t> key;
+    std::atomic<uint64_t> offset{0};
+
+public:
+    explicit Generator(uint64_t seed) : key(seed) {}
+
+    void seed(uint64_t s) {
+        key.store(s, std::memory_order_relaxed);
+        offset.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t dapatkan_seed() const { return key.load(std::memory_order_relaxed); }
+    uint64_t dapatkan_offset() const { return offset.load(std::memory_order_relaxed); }
+    void atur_offset(uint64_t o) { offset.store(o, std::memory_order_relaxed); }
+
+    // Pesan jumlah_blok counter, return counter pertama nya //
+    uint64_t ambil(uint64_t jumlah_blok) {
+        return offset.fetch_add(jumlah_blok, std::memory_order_relaxed);
+    }
+
+    /*
+    Isi dst[0..n) paralel, ubah nya sama kek di isi_blok.
+    Chunk nya kelipatan 2 * LANE elemen, jadi batas chunk selalu di awal blok.
+    */
+    template <typename F>
+    void isi(double* dst, index_t n, F ubah) {
+        const uint64_t k = key.load(std::memory_order_relaxed);
+        const uint64_t awal = ambil(static_cast<uint64_t>((n + 1) / 2));
+        constexpr index_t GRAIN = 2 * detail::LANE * 1024;
+        dl::parallel_for(0, (n + GRAIN - 1) / GRAIN, 1, [&](index_t c0, index_t c1) {
+            for (index_t c = c0; c < c1; ++c) {
+                const index_t mulai = c * GRAIN;
+                const index_t m = std::min<index_t>(GRAIN, n - mulai);
+                isi_blok(dst + mulai, m, awal + static_cast<uint64_t>(mulai / 2), k, ubah);
+            }
+        });
+    }
+
+    void uniform(double* dst, index_t n, double low = 0.0, double high = 1.0) {
+        const double lebar = high - low;
+        isi(dst, n, [=](const double* u0, const double* u1, double* a, double* b) {
+            for (int l = 0; l < detail::LANE; ++l) {
+                a[l] = low + lebar * u0[l];
+                b[l] = low + lebar * u1[l];
+            }
+        });
+    }
+
+    /*
+    Box-Muller: r = sqrt(-2 log(1 - u0)), theta = 2 pi u1.
+    log nya pakai log dari FastMath.h (< 1 ULP) dan sin/cos pakai sincos_putaran,
+    jadi gak manggil libm dan bisa jalan 4 pasang sekaligus di AVX2.
+    */
+    void normal(double* dst, index_t n, double mean = 0.0, double std = 1.0) {
+        isi(dst, n, [=](const double* u0, const double* u1, double* a, double* b) {
+#ifdef DL_RANDOM_X86
+            if (detail::cpu_avx2_fma()) {
+                detail::box_muller_avx2(u0, u1, a, b, mean, std);
+                return;
+            }
+#endif
+            for (int l = 0; l < detail::LANE; ++l) {
+                const double r = std::sqrt(-2.0 * dl::fastmath::log_cepat(1.0 - u0[l]));
+                double sn, cs;
+                detail::sincos_putaran(u1[l], sn, cs);
+                a[l] = mean + std * (r * cs);
+                b[l] = mean + std * (r * sn);
+            }
+        });
+    }
+};
+
+// Generator global yang di pakai semua factory dl:: //
+inline Generator& generator() {
+    static Generator g(static_cast<uint64_t>(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+    return g;
+}
+
+} // namespace random //
+} // namespace dl //
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "Tensor.h"
 #include "Tensor_operator.h"
+#include "Profiler.h"
 #include <algorithm>
 
 /*
@@ -23,8 +24,10 @@ class ReLu {
     public:
     // Forward pass //
     static Tensor forward(const Tensor& x) {
+        DL_MEMORY_TAG("Aktivasi");
+        DL_PROFILE("ReLu::forward", x.numel());
         Tensor out(x.get_shape());
-        for (int i = 0; i < x.numel(); i++) {
+        for (dl::index_t i = 0; i < x.numel(); i++) {
             out[i] = std::max(0.0, x[i]);  
         }
         return out;
@@ -32,8 +35,10 @@ class ReLu {
 
     // Backward pass //
     static Tensor backward(const Tensor& x) {
+        DL_MEMORY_TAG("Aktivasi");
+        DL_PROFILE("ReLu::backward", x.numel());
         Tensor out(x.get_shape());
-        for (int i = 0; i < x.numel(); i++) {
+        for (dl::index_t i = 0; i < x.numel(); i++) {
             out[i] = (x[i] > 0) ? 1.0 : 0.0;
         }
         return out;
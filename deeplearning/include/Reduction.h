@@ -0,0 +1,449 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include "Tensor.h"
+#include "Parallel.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/*
+Reduksi Tensor di sepanjang sumbu: sum, mean, max, min, argmax, argmin.
+
+    dl::sum(t)                   // Semua elemen, return double //
+    dl::sum(t, 0)                // [B, O] -> [O] //
+    dl::mean(t, {0, 2}, true)    // [A, B, C] -> [1, B, 1] (keepdim) //
+    dl::argmax(t, -1)            // Indeks terbesar di sumbu terakhir, -1 = sumbu terakhir //
+
+Setiap reduksi di lihat sebagai Tensor 3D [A, R, B]: A = semua dimensi sebelum sumbu,
+R = sumbu yang di reduksi, B = semua dimensi setelah nya. Sumbu yang di reduksi dan
+bersebelahan di gabung jadi satu R. Kalau sumbu nya banyak dan gak bersebelahan,
+di reduksi satu grup per satu grup.
+
+Cara jalan nya beda tergantung B:
+    - B == 1 (sumbu paling dalam, contiguous): setiap baris di jumlah pairwise,
+      blok 128 elemen di jumlah pakai 8 akumulator (jadi 2 register AVX, error nya O(log n)).
+    - B > 1 (sumbu luar): baris di jalan satu per satu dan di tambah ke baris hasil,
+      loop dalam nya di sepanjang B yang contiguous jadi di vectorize. Kolom nya di potong per
+      tile biar baris hasil nya tetap di L1. Urutan penjumlahan nya berurutan di R (kek numpy),
+      jadi sama persis dengan loop biasa (misal gradient bias Dense).
+Thread: di bagi per A, atau per tile kolom kalau A nya 1. Reduksi penuh di potong per blok
+tetap (bukan per thread), jadi hasil nya sama persis berapa pun thread nya.
+
+max / min / argmax / argmin: NaN gak di propagasi (perbandingan nya v > m), argmax ambil indeks
+pertama kalau ada yang sama. Indeks argmax di simpan sebagai double kek label di Loss.h.
+*/
+
+namespace dl {
+namespace reduksi {
+
+constexpr index_t BLOK_PAIRWISE = 128;
+constexpr index_t BLOK_PENUH = index_t(1) << 16;    // Potongan reduksi penuh, tetap berapa pun thread nya //
+constexpr index_t TILE_KOLOM = 1024;                 // 8 KB baris hasil per tile //
+constexpr index_t GRAIN = 32768;                     // Elemen minimal per chunk thread //
+
+enum class Op { SUM, MAX, MIN };
+
+// Jumlah pairwise array contiguous //
+inline double jumlah_pairwise(const double* x, index_t n) {
+    if (n < 8) {
+        double r = 0.0;
+        for (index_t i = 0; i < n; ++i) r += x[i];
+        return r;
+    }
+    if (n <= BLOK_PAIRWISE) {
+        double s[8] = {x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7]};
+        index_t i = 8;
+        for (; i + 8 <= n; i += 8) {
+            for (int j = 0; j < 8; ++j) s[j] += x[i + j];
+        }
+        double r = ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+        for (; i < n; ++i) r += x[i];
+        return r;
+    }
+    index_t h = n / 2;
+    h -= h % 8;
+    return jumlah_pairwise(x, h) + jumlah_pairwise(x + h, n - h);
+}
+
+// Jumlah semua elemen, blok BLOK_PENUH di jumlah paralel lalu hasil per blok nya di jumlah pairwise //
+inline double jumlah(const double* x, index_t n) {
+    if (n <= BLOK_PENUH) return jumlah_pairwise(x, n);
+    const index_t blok = (n + BLOK_PENUH - 1) / BLOK_PENUH;
+    std::vector<double> parsial(static_cast<size_t>(blok));
+    dl::parallel_for(0, blok, std::max<index_t>(1, GRAIN / BLOK_PENUH), [&](index_t b0, index_t b1) {
+        for (index_t b = b0; b < b1; ++b) {
+            const index_t awal = b * BLOK_PENUH;
+            parsial[b] = jumlah_pairwise(x + awal, std::min(BLOK_PENUH, n - awal));
+        }
+    });
+    return jumlah_pairwise(parsial.data(), blok);
+}
+
+// Max / min array contiguous, 4 akumulator biar bisa di vectorize //
+inline double ekstrem(const double* x, index_t n, bool cari_max) {
+    assert(n > 0 && "Max / min dari 0 elemen");
+    double m[4] = {x[0], x[0], x[0], x[0]};
+    index_t i = 0;
+    if (cari_max) {
+        for (; i + 4 <= n; i += 4) {
+            for (int j = 0; j < 4; ++j) m[j] = x[i + j] > m[j] ? x[i + j] : m[j];
+        }
+        for (; i < n; ++i) m[0] = x[i] > m[0] ? x[i] : m[0];
+        return std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+    }
+    for (; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; ++j) m[j] = x[i + j] < m[j] ? x[i + j] : m[j];
+    }
+    for (; i < n; ++i) m[0] = x[i] < m[0] ? x[i] : m[0];
+    return std::min(std::min(m[0], m[1]), std::min(m[2], m[3]));
+}
+
+// Gabung satu baris ke baris hasil: sum, max, atau min //
+inline void gabung_baris(double* out, const double* x, index_t n, Op op) {
+    switch (op) {
+        case Op::SUM:
+            for (index_t b = 0; b < n; ++b) out[b] += x[b];
+            break;
+        case Op::MAX:
+            for (index_t b = 0; b < n; ++b) out[b] = x[b] > out[b] ? x[b] : out[b];
+            break;
+        case Op::MIN:
+            for (index_t b = 0; b < n; ++b) out[b] = x[b] < out[b] ? x[b] : out[b];
+            break;
+    }
+}
+
+// 4 baris sekaligus, out[b] = op(op(op(op(out[b], x0[b]), x1[b]), x2[b]), x3[b]) //
+// Urutan nya sama dengan 4x gabung_baris, tapi out nya cuma di baca / tulis sekali //
+inline void gabung_4_baris(double* out, const double* x, index_t stride, index_t n, Op op) {
+    const double* x0 = x;
+    const double* x1 = x + stride;
+    const double* x2 = x + 2 * stride;
+    const double* x3 = x + 3 * stride;
+    switch (op) {
+        case Op::SUM:
+            for (index_t b = 0; b < n; ++b) out[b] = (((out[b] + x0[b]) + x1[b]) + x2[b]) + x3[b];
+            break;
+        case Op::MAX:
+            for (index_t b = 0; b < n; ++b) {
+                double m = out[b];
+                m = x0[b] > m ? x0[b] : m;
+                m = x1[b] > m ? x1[b] : m;
+                m = x2[b] > m ? x2[b] : m;
+                out[b] = x3[b] > m ? x3[b] : m;
+            }
+            break;
+        case Op::MIN:
+            for (index_t b = 0; b < n; ++b) {
+                double m = out[b];
+                m = x0[b] < m ? x0[b] : m;
+                m = x1[b] < m ? x1[b] : m;
+                m = x2[b] < m ? x2[b] : m;
+                out[b] = x3[b] < m ? x3[b] : m;
+            }
+            break;
+    }
+}
+
+/*
+Reduksi sumbu luar: out[b] = op_r x[r * B + b], r berurutan 0, 1, 2, ...
+Kalau tambah, hasil nya di gabung ke isi out yang lama (buat akumulasi gradient),
+kalau gak, mulai dari baris 0 (SUM mulai dari 0.0 + x[0] = x[0], jadi sama saja).
+*/
+inline void reduksi_baris(const double* x, index_t R, index_t B, double* out, Op op, bool tambah = false) {
+    const index_t grain = std::max<index_t>(TILE_KOLOM, R > 0 ? GRAIN / R : GRAIN);
+    dl::parallel_for(0, B, grain, [&](index_t c0, index_t c1) {
+        for (index_t t0 = c0; t0 < c1; t0 += TILE_KOLOM) {
+            const index_t t1 = std::min(c1, t0 + TILE_KOLOM);
+            index_t r = 0;
+            if (!tambah) {
+                if (op == Op::SUM) {
+                    std::fill(out + t0, out + t1, 0.0);
+                } else {
+                    assert(R > 0 && "Max / min dari 0 elemen");
+                    std::copy(x + t0, x + t1, out + t0);
+                    r = 1;
+                }
+            }
+            for (; r + 4 <= R; r += 4) {
+                gabung_4_baris(out + t0, x + r * B + t0, B, t1 - t0, op);
+            }
+            for (; r < R; ++r) {
+                gabung_baris(out + t0, x + r * B + t0, t1 - t0, op);
+            }
+        }
+    });
+}
+
+// Gradient bias dan sejenis nya: out[b] += sum_r x[r * B + b] //
+inline void jumlah_baris(const double* x, index_t R, index_t B, double* out, bool tambah = false) {
+    reduksi_baris(x, R, B, out, Op::SUM, tambah);
+}
+
+// Reduksi [A, R, B] -> [A, B] //
+inline void reduksi_3d(const double* x, index_t A, index_t R, index_t B, double* out, Op op) {
+    if (B == 1) {
+        if (A == 1) {
+            out[0] = op == Op::SUM ? jumlah(x, R) : ekstrem(x, R, op == Op::MAX);
+            return;
+        }
+        dl::parallel_for(0, A, std::max<index_t>(1, GRAIN / std::max<index_t>(1, R)), [&](index_t a0, index_t a1) {
+            for (index_t a = a0; a < a1; ++a) {
+                out[a] = op == Op::SUM ? jumlah_pairwise(x + a * R, R) : ekstrem(x + a * R, R, op == Op::MAX);
+            }
+        });
+        return;
+    }
+    // Paralel per A, kalau A nya 1 reduksi_baris yang bagi kolom ke thread (nested jalan serial) //
+    dl::parallel_for(0, A, std::max<index_t>(1, GRAIN / std::max<index_t>(1, R * B)), [&](index_t a0, index_t a1) {
+        for (index_t a = a0; a < a1; ++a) {
+            reduksi_baris(x + a * R * B, R, B, out + a * B, op);
+        }
+    });
+}
+
+// Argmax / argmin [A, R, B] -> [A, B], indeks pertama yang menang //
+inline void arg_3d(const double* x, index_t A, index_t R, index_t B, double* out, bool cari_max) {
+    assert(R > 0 && "Argmax / argmin dari 0 elemen");
+    auto menang = [cari_max](double v, double m) { return cari_max ? v > m : v < m; };
+    if (B == 1) {
+        dl::parallel_for(0, A, std::max<index_t>(1, GRAIN / R), [&](index_t a0, index_t a1) {
+            for (index_t a = a0; a < a1; ++a) {
+                const double* xr = x + a * R;
+                index_t idx = 0;
+                double m = xr[0];
+                for (index_t r = 1; r < R; ++r) {
+                    if (menang(xr[r], m)) {
+                        m = xr[r];
+                        idx = r;
+                    }
+                }
+                out[a] = static_cast<double>(idx);
+            }
+        });
+        return;
+    }
+    const index_t kolom = A * B;
+    dl::parallel_for(0, kolom, std::max<index_t>(TILE_KOLOM, GRAIN / R), [&](index_t k0, index_t k1) {
+        std::vector<double> terbaik(static_cast<size_t>(TILE_KOLOM));
+        // Tile nya gak boleh nyebrang batas A, karna baris nya beda blok //
+        for (index_t t0 = k0; t0 < k1;) {
+            const index_t a = t0 / B;
+            const index_t t1 = std::min({k1, t0 + TILE_KOLOM, (a + 1) * B});
+            const index_t n = t1 - t0;
+            const double* xa = x + a * R * B + (t0 - a * B);
+            std::copy(xa, xa + n, terbaik.begin());
+            std::fill(out + t0, out + t1, 0.0);
+            for (index_t r = 1; r < R; ++r) {
+                const double* xr = xa + r * B;
+                const double ir = static_cast<double>(r);
+                for (index_t j = 0; j < n; ++j) {
+                    const bool ganti = menang(xr[j], terbaik[j]);
+                    terbaik[j] = ganti ? xr[j] : terbaik[j];
+                    out[t0 + j] = ganti ? ir : out[t0 + j];
+                }
+            }
+            t0 = t1;
+        }
+    });
+}
+
+// Sumbu negatif jadi positif, urut, dan gak boleh dobel //
+inline std::vector<int> normalisasi_sumbu(const Shape& bentuk, std::vector<int> sumbu) {
+    const int rank = static_cast<int>(bentuk.size());
+    assert(!sumbu.empty() && "Sumbu reduksi kosong, pakai versi tanpa sumbu buat reduksi semua elemen");
+    for (int& s : sumbu) {
+        if (s < 0) s += rank;
+        assert(s >= 0 && s < rank && "Sumbu reduksi di luar rank Tensor");
+    }
+    std::sort(sumbu.begin(), sumbu.end());
+    assert(std::adjacent_find(sumbu.begin(), sumbu.end()) == sumbu.end() && "Sumbu reduksi dobel");
+    return sumbu;
+}
+
+inline Shape bentuk_hasil(const Shape& bentuk, const std::vector<int>& sumbu, bool keepdim) {
+    Shape hasil;
+    size_t k = 0;
+    for (int d = 0; d < static_cast<int>(bentuk.size()); ++d) {
+        const bool direduksi = k < sumbu.size() && sumbu[k] == d;
+        if (direduksi) ++k;
+        if (!direduksi) {
+            hasil.push_back(bentuk[d]);
+        } else if (keepdim) {
+            hasil.push_back(1);
+        }
+    }
+    return hasil;
+}
+
+/*
+Reduksi sumbu mana saja. Dimensi yang bersebelahan dengan jenis sama (di reduksi / gak)
+di gabung dulu, lalu grup yang di reduksi di habisi satu per satu dari belakang.
+*/
+inline Tensor reduksi(const Tensor& t, std::vector<int> sumbu, bool keepdim, Op op) {
+    DL_MEMORY_TAG("Reduksi");
+    DL_PROFILE("Tensor::reduksi", t.numel());
+    const Shape& bentuk = t.get_shape();
+    sumbu = normalisasi_sumbu(bentuk, sumbu);
+
+    // Gabung dimensi yang bersebelahan dengan jenis sama //
+    std::vector<index_t> dim;
+    std::vector<bool> direduksi;
+    size_t k = 0;
+    for (int d = 0; d < static_cast<int>(bentuk.size()); ++d) {
+        const bool r = k < sumbu.size() && sumbu[k] == d;
+        if (r) ++k;
+        if (!dim.empty() && direduksi.back() == r) {
+            dim.back() *= bentuk[d];
+        } else {
+            dim.push_back(bentuk[d]);
+            direduksi.push_back(r);
+        }
+    }
+
+    Tensor hasil(bentuk_hasil(bentuk, sumbu, keepdim));
+    Tensor::Storage sementara;
+    const double* sumber = t.data_ptr();
+    while (true) {
+        int g = -1;
+        int jumlah_grup = 0;
+        for (int i = 0; i < static_cast<int>(dim.size()); ++i) {
+            if (direduksi[i]) {
+                g = i;
+                ++jumlah_grup;
+            }
+        }
+        index_t A = 1, B = 1;
+        for (int i = 0; i < g; ++i) A *= dim[i];
+        for (int i = g + 1; i < static_cast<int>(dim.size()); ++i) B *= dim[i];
+
+        // Grup terakhir langsung di tulis ke hasil, sisa nya ke buffer sementara //
+        Tensor::Storage berikut;
+        double* tujuan = hasil.data_ptr();
+        if (jumlah_grup > 1) {
+            berikut.resize(static_cast<size_t>(A * B));
+            tujuan = berikut.data();
+        }
+        reduksi_3d(sumber, A, dim[g], B, tujuan, op);
+        if (jumlah_grup == 1) break;
+
+        sementara = std::move(berikut);
+        sumber = sementara.data();
+        dim.erase(dim.begin() + g);
+        direduksi.erase(direduksi.begin() + g);
+        // Dimensi kiri dan kanan grup yang hilang sekarang bersebelahan, gabung lagi //
+        if (g > 0 && g < static_cast<int>(dim.size()) && direduksi[g - 1] == direduksi[g]) {
+            dim[g - 1] *= dim[g];
+            dim.erase(dim.begin() + g);
+            direduksi.erase(direduksi.begin() + g);
+        }
+    }
+    return hasil;
+}
+
+} // namespace reduksi
+
+// SUM //
+inline double sum(const Tensor& t) {
+    DL_PROFILE("Tensor::sum", t.numel());
+    return reduksi::jumlah(t.data_ptr(), t.numel());
+}
+
+inline Tensor sum(const Tensor& t, const std::vector<int>& sumbu, bool keepdim = false) {
+    return reduksi::reduksi(t, sumbu, keepdim, reduksi::Op::SUM);
+}
+
+inline Tensor sum(const Tensor& t, int sumbu, bool keepdim = false) {
+    return sum(t, std::vector<int>{sumbu}, keepdim);
+}
+
+// MEAN //
+inline double mean(const Tensor& t) {
+    assert(t.numel() > 0 && "Mean dari Tensor kosong");
+    return sum(t) / static_cast<double>(t.numel());
+}
+
+inline Tensor mean(const Tensor& t, const std::vector<int>& sumbu, bool keepdim = false) {
+    Tensor hasil = sum(t, sumbu, keepdim);
+    const dl::index_t n = t.numel() / std::max<dl::index_t>(1, hasil.numel());
+    assert(n > 0 && "Mean dari sumbu kosong");
+    hasil /= static_cast<double>(n);
+    return hasil;
+}
+
+inline Tensor mean(const Tensor& t, int sumbu, bool keepdim = false) {
+    return mean(t, std::vector<int>{sumbu}, keepdim);
+}
+
+// MAX / MIN //
+inline double max(const Tensor& t) {
+    DL_PROFILE("Tensor::max", t.numel());
+    double m;
+    reduksi::reduksi_3d(t.data_ptr(), 1, t.numel(), 1, &m, reduksi::Op::MAX);
+    return m;
+}
+
+inline Tensor max(const Tensor& t, const std::vector<int>& sumbu, bool keepdim = false) {
+    return reduksi::reduksi(t, sumbu, keepdim, reduksi::Op::MAX);
+}
+
+inline Tensor max(const Tensor& t, int sumbu, bool keepdim = false) {
+    return max(t, std::vector<int>{sumbu}, keepdim);
+}
+
+inline double min(const Tensor& t) {
+    DL_PROFILE("Tensor::min", t.numel());
+    double m;
+    reduksi::reduksi_3d(t.data_ptr(), 1, t.numel(), 1, &m, reduksi::Op::MIN);
+    return m;
+}
+
+inline Tensor min(const Tensor& t, const std::vector<int>& sumbu, bool keepdim = false) {
+    return reduksi::reduksi(t, sumbu, keepdim, reduksi::Op::MIN);
+}
+
+inline Tensor min(const Tensor& t, int sumbu, bool keepdim = false) {
+    return min(t, std::vector<int>{sumbu}, keepdim);
+}
+
+// ARGMAX / ARGMIN (satu sumbu, atau semua elemen jadi indeks flat) //
+namespace reduksi {
+inline Tensor arg(const Tensor& t, int sumbu, bool keepdim, bool cari_max) {
+    DL_MEMORY_TAG("Reduksi");
+    DL_PROFILE("Tensor::argmax", t.numel());
+    const Shape& bentuk = t.get_shape();
+    const std::vector<int> s = normalisasi_sumbu(bentuk, {sumbu});
+    index_t A = 1, B = 1;
+    for (int d = 0; d < s[0]; ++d) A *= bentuk[d];
+    for (int d = s[0] + 1; d < static_cast<int>(bentuk.size()); ++d) B *= bentuk[d];
+    Tensor hasil(bentuk_hasil(bentuk, s, keepdim));
+    arg_3d(t.data_ptr(), A, bentuk[s[0]], B, hasil.data_ptr(), cari_max);
+    return hasil;
+}
+} // namespace reduksi
+
+inline index_t argmax(const Tensor& t) {
+    double idx;
+    reduksi::arg_3d(t.data_ptr(), 1, t.numel(), 1, &idx, true);
+    return static_cast<index_t>(idx);
+}
+
+inline Tensor argmax(const Tensor& t, int sumbu, bool keepdim = false) {
+    return reduksi::arg(t, sumbu, keepdim, true);
+}
+
+inline index_t argmin(const Tensor& t) {
+    double idx;
+    reduksi::arg_3d(t.data_ptr(), 1, t.numel(), 1, &idx, false);
+    return static_cast<index_t>(idx);
+}
+
+inline Tensor argmin(const Tensor& t, int sumbu, bool keepdim = false) {
+    return reduksi::arg(t, sumbu, keepdim, false);
+}
+
+} // namespace dl
+
+#endif
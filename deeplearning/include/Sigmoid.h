@@ -9,18 +9,33 @@ Karna disini kita fokus klasifikasi klasik, jadi kita pakai fungsi ini saja.
 
 #include "Tensor.h"
 #include "Tensor_operator.h"
+#include "Profiler.h"
+#include "FastMath.h"
 #include <cmath>
 
 class Sigmoid {
     public:
     static Tensor forward(const Tensor& x) {
-        // Inti perhitungan sigmoid forward nya //
-        return 1.0 / (1.0 + exp(-x));
+        DL_MEMORY_TAG("Aktivasi");
+        DL_PROFILE("Sigmoid::forward", x.numel());
+        // Inti perhitungan sigmoid forward nya: 1 / (1 + exp(-x)) //
+        // Satu loop langsung ke output, gak lewat 4 Tensor sementara. Ikut mode dl::fastmath //
+        Tensor out(x.get_shape());
+        dl::fastmath::sigmoid(x.data_ptr(), out.data_ptr(), x.numel());
+        return out;
     };
 
     static Tensor backward(const Tensor& x) {
-        // Ini perhitungan backward nya //
-        return x * (1.0 - x);
+        DL_MEMORY_TAG("Aktivasi");
+        DL_PROFILE("Sigmoid::backward", x.numel());
+        // Ini perhitungan backward nya: x * (1 - x), x = output forward //
+        Tensor out(x.get_shape());
+        const double* px = x.data_ptr();
+        double* po = out.data_ptr();
+        for (dl::index_t i = 0; i < x.numel(); ++i) {
+            po[i] = px[i] * (1.0 - px[i]);
+        }
+        return out;
     };
 };
 
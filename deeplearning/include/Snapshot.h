@@ -0,0 +1,375 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "Tensor.h"
+#include "Memory.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+Snapshot state training lengkap ke disk, buat lanjut training dari titik yang sama persis.
+(Beda dengan gradient checkpointing di NeuralNetwork, yang itu soal simpan aktivasi di memori.)
+
+Yang di simpan bukan cuma bobot:
+    - parameter semua layer (bobot, bias, gamma, beta, running stats BatchNorm)
+    - state optimizer (buffer m / v / momentum semua parameter) dan langkah t nya
+    - posisi generator random (seed + offset Philox, state mt19937), biar mask Dropout berikut nya sama
+    - jumlah langkah training
+Jadi resume nya bit-exact: training yang di potong lalu di lanjut hasil nya sama persis
+dengan training yang gak pernah berhenti.
+
+Alur nya:
+1. Thread training cuma nyalin state ke StateTraining (memcpy, murah).
+   StateTraining yang sudah selesai di tulis di pakai ulang, jadi gak ada alokasi / page fault baru.
+2. PenulisAsync nerima salinan itu dan nulis + fsync di thread background.
+   Kalau penulis masih sibuk, snapshot yang antri di ganti dengan yang lebih baru
+   (yang lama di lewati), jadi thread training gak pernah nunggu I/O dan memori nya paling 2 snapshot.
+3. File nya di tulis ke <path>.tmp, di fsync, baru di rename ke <path>.
+   Kalau proses mati di tengah nulis, file lama nya masih utuh.
+
+Format file (byte order mesin, apa ada nya di memori):
+    "DLSNAP01", lalu field-field StateTraining, lalu checksum 64 bit (FNV-1a per word) dari semua byte sebelum nya.
+*/
+
+namespace dl {
+namespace snapshot {
+
+struct StateTraining {
+    std::string arsitektur;              // Tanda tangan layer, buat cek file nya cocok //
+    std::string optimizer;               // Jenis optimizer (Optimizer::jenis), wajib sama pas resume //
+    long long langkah = 0;               // Jumlah train_step yang sudah jalan //
+    long long langkah_optimizer = 0;     // t optimizer //
+    double learning_rate = 0.0;
+    uint64_t seed_random = 0;            // Generator Philox global //
+    uint64_t offset_random = 0;
+    std::string engine_std;              // State mt19937 dalam bentuk teks //
+    Tensor::Storage parameter;           // Semua parameter layer, berurutan //
+    Tensor::Storage state_optimizer;     // Buffer state optimizer //
+
+    long long bytes() const {
+        return static_cast<long long>(parameter.size() + state_optimizer.size()) * sizeof(double) +
+               static_cast<long long>(arsitektur.size() + optimizer.size() + engine_std.size());
+    }
+};
+
+namespace detail {
+
+constexpr char MAGIC[8] = {'D', 'L', 'S', 'N', 'A', 'P', '0', '1'};
+
+/*
+Checksum FNV-1a, tapi per word 8 byte (sisa nya per byte), biar gak jadi bottleneck di snapshot puluhan MB.
+Di campur per potongan field, jadi penulis dan pembaca wajib manggil nya dengan potongan yang sama.
+*/
+inline uint64_t campur(uint64_t h, const char* p, size_t n) {
+    const uint64_t prima = 1099511628211ull;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * prima;
+    }
+    for (; i < n; ++i) {
+        h = (h ^ static_cast<unsigned char>(p[i])) * prima;
+    }
+    return h;
+}
+
+constexpr uint64_t HASH_AWAL = 1469598103934665603ull;
+
+// Tulis field langsung ke file (buffer stdio), array besar gak di salin lagi //
+class FileTulis {
+private:
+    std::FILE* f;
+
+public:
+    uint64_t hash = HASH_AWAL;
+    bool ok;
+
+    explicit FileTulis(const std::string& path) : f(std::fopen(path.c_str(), "wb")), ok(f != nullptr) {}
+    ~FileTulis() {
+        if (f) std::fclose(f);
+    }
+
+    void tulis(const void* p, size_t n) {
+        hash = campur(hash, static_cast<const char*>(p), n);
+        if (ok && n > 0) ok = std::fwrite(p, 1, n, f) == n;
+    }
+    template <typename T>
+    void tulis(const T& v) { tulis(&v, sizeof(T)); }
+    void tulis(const std::string& s) {
+        tulis(static_cast<uint64_t>(s.size()));
+        tulis(s.data(), s.size());
+    }
+    void tulis(const Tensor::Storage& v) {
+        tulis(static_cast<uint64_t>(v.size()));
+        tulis(v.data(), v.size() * sizeof(double));
+    }
+
+    // Checksum nya sendiri gak ikut di campur //
+    void tulis_checksum() {
+        const uint64_t h = hash;
+        if (ok) ok = std::fwrite(&h, 1, sizeof(h), f) == sizeof(h);
+    }
+
+    // Flush buffer stdio lalu fsync ke disk //
+    bool tutup() {
+        if (!f) return false;
+        ok = ok && std::fflush(f) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+        ok = ok && ::fsync(fileno(f)) == 0;
+#endif
+        ok = (std::fclose(f) == 0) && ok;
+        f = nullptr;
+        return ok;
+    }
+};
+
+class FileBaca {
+private:
+    std::FILE* f;
+
+public:
+    uint64_t hash = HASH_AWAL;
+    bool ok;
+
+    explicit FileBaca(const std::string& path) : f(std::fopen(path.c_str(), "rb")), ok(f != nullptr) {}
+    ~FileBaca() {
+        if (f) std::fclose(f);
+    }
+
+    void baca(void* p, size_t n) {
+        if (ok && n > 0) ok = std::fread(p, 1, n, f) == n;
+        if (ok) hash = campur(hash, static_cast<const char*>(p), n);
+    }
+    template <typename T>
+    void baca(T& v) { baca(&v, sizeof(T)); }
+
+    // Panjang nya di batasi biar file rusak gak bikin alokasi raksasa //
+    void baca(std::string& s) {
+        uint64_t n = 0;
+        baca(n);
+        if (!ok || n > (1u << 24)) {
+            ok = false;
+            return;
+        }
+        s.resize(n);
+        baca(&s[0], n);
+    }
+    void baca(Tensor::Storage& v) {
+        uint64_t n = 0;
+        baca(n);
+        if (!ok || n > (uint64_t(1) << 40) / sizeof(double)) {
+            ok = false;
+            return;
+        }
+        v.resize(n);
+        baca(v.data(), n * sizeof(double));
+    }
+
+    // Checksum di akhir file harus cocok dan gak boleh ada sisa byte //
+    bool cek_checksum() {
+        const uint64_t h = hash;
+        uint64_t tersimpan = 0;
+        if (!ok || std::fread(&tersimpan, 1, sizeof(tersimpan), f) != sizeof(tersimpan)) return false;
+        return tersimpan == h && std::fgetc(f) == EOF;
+    }
+};
+
+// fsync folder nya, biar rename nya sendiri tahan crash //
+inline void sinkron_folder(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+    const size_t garis = path.find_last_of('/');
+    const std::string folder = garis == std::string::npos ? "." : path.substr(0, garis == 0 ? 1 : garis);
+    int fd = ::open(folder.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+} // namespace detail //
+
+// Tulis snapshot ke <path>.tmp, fsync, lalu rename ke path. Return false kalau gagal //
+inline bool tulis_file(const std::string& path, const StateTraining& s) {
+    const std::string tmp = path + ".tmp";
+    detail::FileTulis w(tmp);
+    w.tulis(detail::MAGIC, sizeof(detail::MAGIC));
+    w.tulis(s.arsitektur);
+    w.tulis(s.optimizer);
+    w.tulis(s.langkah);
+    w.tulis(s.langkah_optimizer);
+    w.tulis(s.learning_rate);
+    w.tulis(s.seed_random);
+    w.tulis(s.offset_random);
+    w.tulis(s.engine_std);
+    w.tulis(s.parameter);
+    w.tulis(s.state_optimizer);
+    w.tulis_checksum();
+    if (!w.tutup()) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+#if !defined(__unix__) && !defined(__APPLE__)
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) return false;
+    detail::sinkron_folder(path);
+    return true;
+}
+
+// Baca snapshot, return false kalau file nya gak ada, rusak, atau checksum nya gak cocok //
+inline bool baca_file(const std::string& path, StateTraining& s) {
+    DL_MEMORY_TAG("snapshot");
+    detail::FileBaca r(path);
+    char magic[sizeof(detail::MAGIC)] = {};
+    r.baca(magic, sizeof(magic));
+    if (!r.ok || std::memcmp(magic, detail::MAGIC, sizeof(magic)) != 0) return false;
+    StateTraining hasil;
+    r.baca(hasil.arsitektur);
+    r.baca(hasil.optimizer);
+    r.baca(hasil.langkah);
+    r.baca(hasil.langkah_optimizer);
+    r.baca(hasil.learning_rate);
+    r.baca(hasil.seed_random);
+    r.baca(hasil.offset_random);
+    r.baca(hasil.engine_std);
+    r.baca(hasil.parameter);
+    r.baca(hasil.state_optimizer);
+    if (!r.cek_checksum()) return false;
+    s = std::move(hasil);
+    return true;
+}
+
+// Statistik penulis background //
+struct StatistikSnapshot {
+    long long dikirim = 0;         // Snapshot yang di serahkan thread training //
+    long long ditulis = 0;         // Yang berhasil sampai disk //
+    long long dilewati = 0;        // Di ganti snapshot yang lebih baru sebelum sempat di tulis //
+    long long gagal = 0;
+    long long langkah_terakhir = -1;    // Langkah training snapshot terakhir yang ada di disk //
+    double waktu_tulis_ms = 0.0;        // Total waktu serialisasi + fsync di thread background //
+};
+
+/*
+Penulis snapshot di thread background.
+kirim() gak pernah nunggu I/O: snapshot nya cuma di taruh di antrian satu slot.
+*/
+class PenulisAsync {
+private:
+    std::thread worker;
+    std::mutex mtx;
+    std::condition_variable cv_kerja;
+    std::condition_variable cv_selesai;
+
+    std::unique_ptr<StateTraining> antrian;
+    std::string path_antrian;
+    std::unique_ptr<StateTraining> bekas;   // Sudah di tulis, buffer nya bisa di pakai ulang //
+    bool sibuk = false;
+    bool berhenti = false;
+    StatistikSnapshot statistik;
+
+    void loop() {
+        for (;;) {
+            std::unique_ptr<StateTraining> s;
+            std::string path;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv_kerja.wait(lock, [&] { return berhenti || antrian; });
+                if (!antrian) return;
+                s = std::move(antrian);
+                path = std::move(path_antrian);
+                sibuk = true;
+            }
+
+            auto t0 = std::chrono::steady_clock::now();
+            const bool ok = tulis_file(path, *s);
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            const long long langkah = s->langkah;
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                bekas = std::move(s);
+                statistik.waktu_tulis_ms += ms;
+                if (ok) {
+                    ++statistik.ditulis;
+                    statistik.langkah_terakhir = langkah;
+                } else {
+                    ++statistik.gagal;
+                }
+                sibuk = false;
+            }
+            cv_selesai.notify_all();
+        }
+    }
+
+public:
+    PenulisAsync() = default;
+    PenulisAsync(const PenulisAsync&) = delete;
+    PenulisAsync& operator=(const PenulisAsync&) = delete;
+
+    ~PenulisAsync() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            berhenti = true;
+        }
+        cv_kerja.notify_all();
+        if (worker.joinable()) worker.join();   // Antrian yang tersisa tetap di tulis dulu //
+    }
+
+    // Serahkan snapshot ke thread background, gak nunggu apa-apa //
+    void kirim(std::unique_ptr<StateTraining> s, const std::string& path) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!worker.joinable()) {
+                worker = std::thread([this] { loop(); });
+            }
+            if (antrian) {
+                ++statistik.dilewati;
+                if (!bekas) bekas = std::move(antrian);
+            }
+            antrian = std::move(s);
+            path_antrian = path;
+            ++statistik.dikirim;
+        }
+        cv_kerja.notify_one();
+    }
+
+    // StateTraining bekas buat di isi ulang (kapasitas buffer nya masih ada), atau yang baru //
+    std::unique_ptr<StateTraining> ambil_bekas() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (bekas) return std::move(bekas);
+        return std::unique_ptr<StateTraining>(new StateTraining());
+    }
+
+    // Tunggu sampai antrian kosong dan gak ada yang lagi di tulis //
+    void tunggu() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_selesai.wait(lock, [&] { return !antrian && !sibuk; });
+    }
+
+    StatistikSnapshot dapatkan_statistik() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return statistik;
+    }
+};
+
+} // namespace snapshot //
+} // namespace dl //
+
+#endif
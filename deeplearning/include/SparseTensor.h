@@ -0,0 +1,336 @@
+#ifndef SPARSE_TENSOR_H
+#define SPARSE_TENSOR_H
+
+#include "Tensor.h"
+#include "Tensor_factory.h"
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+Sparse Tensor format CSR (Compressed Sparse Row), khusus matriks 2D [baris, kolom].
+Fitur one-hot dan hashed itu 99% isi nya nol, jadi kalau di simpan sebagai Tensor biasa
+memori dan FLOP nya habis buat ngitung nol.
+
+CSR nyimpen yang bukan nol saja, pakai 3 array:
+1. nilai        = nilai elemen yang bukan nol, urut per baris
+2. indeks_kolom = kolom dari setiap nilai
+3. offset_baris = baris b ada di nilai[offset_baris[b] .. offset_baris[b+1]), panjang nya baris + 1
+
+Contoh matriks [[0, 2, 0], [1, 0, 3]]:
+    offset_baris = {0, 1, 3}
+    indeks_kolom = {1, 0, 2}
+    nilai        = {2, 1, 3}
+
+Indeks kolom di setiap baris selalu urut dan gak ada duplikat.
+*/
+
+class SparseTensor {
+public:
+    using Indeks = std::vector<dl::index_t, dl::memori::TrackingAllocator<dl::index_t>>;
+    using Storage = Tensor::Storage;
+
+private:
+    dl::index_t baris;
+    dl::index_t kolom;
+    Indeks offset_baris;
+    Indeks indeks_kolom;
+    Storage nilai;
+
+public:
+    // Matriks kosong dengan 0 baris //
+    SparseTensor() : baris(0), kolom(0), offset_baris(1, 0) {}
+
+    // Matriks [baris, kolom] yang isi nya nol semua //
+    SparseTensor(dl::index_t baris_, dl::index_t kolom_)
+        : baris(baris_), kolom(kolom_), offset_baris(baris_ + 1, 0) {}
+
+    /*
+    Dari array CSR yang sudah jadi. Struktur nya di cek pas runtime (bukan assert), karna indeks kolom
+    yang di luar ukuran bikin forward_sparse baca bobot di luar buffer: offset harus baris + 1 elemen,
+    mulai dari 0, gak turun, dan berakhir di nnz; kolom di setiap baris harus di [0, kolom), urut, tanpa duplikat.
+    Yang gak valid lempar std::invalid_argument.
+    */
+    SparseTensor(dl::index_t baris_, dl::index_t kolom_,
+                 const std::vector<dl::index_t>& offset_baris_,
+                 const std::vector<dl::index_t>& indeks_kolom_,
+                 const std::vector<double>& nilai_)
+        : baris(baris_), kolom(kolom_),
+          offset_baris(offset_baris_.begin(), offset_baris_.end()),
+          indeks_kolom(indeks_kolom_.begin(), indeks_kolom_.end()),
+          nilai(nilai_.begin(), nilai_.end()) {
+        auto gagal = [](const std::string& pesan) {
+            throw std::invalid_argument("SparseTensor: " + pesan);
+        };
+        if (baris < 0 || kolom < 0) gagal("ukuran negatif");
+        if (static_cast<dl::index_t>(offset_baris.size()) != baris + 1) gagal("offset_baris harus punya baris + 1 elemen");
+        if (indeks_kolom.size() != nilai.size()) gagal("indeks_kolom dan nilai harus sama panjang");
+        if (offset_baris.front() != 0 || offset_baris.back() != static_cast<dl::index_t>(nilai.size())) {
+            gagal("offset_baris harus mulai dari 0 dan berakhir di nnz");
+        }
+        for (dl::index_t b = 0; b < baris; ++b) {
+            const dl::index_t p0 = offset_baris[b];
+            const dl::index_t p1 = offset_baris[b + 1];
+            if (p1 < p0) gagal("offset_baris turun di baris " + std::to_string(b));
+            for (dl::index_t p = p0; p < p1; ++p) {
+                const dl::index_t k = indeks_kolom[p];
+                if (k < 0 || k >= kolom) {
+                    gagal("indeks kolom " + std::to_string(k) + " di baris " + std::to_string(b) +
+                          " di luar [0, " + std::to_string(kolom) + ")");
+                }
+                if (p > p0 && k <= indeks_kolom[p - 1]) {
+                    gagal("indeks kolom di baris " + std::to_string(b) + " harus urut tanpa duplikat");
+                }
+            }
+        }
+    }
+
+    /*
+    Tambah satu baris di bawah, dipakai loader.
+    Kolom nya di urutkan dulu, kolom yang muncul dua kali nilai nya di jumlah.
+    Kolom di luar [0, kolom) lempar std::invalid_argument, matriks nya gak berubah.
+    */
+    void tambah_baris(std::vector<std::pair<dl::index_t, double>> elemen) {
+        std::sort(elemen.begin(), elemen.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        // Sudah urut, jadi cukup cek ujung nya; di cek sebelum ada yang di tulis //
+        if (!elemen.empty() && (elemen.front().first < 0 || elemen.back().first >= kolom)) {
+            const dl::index_t k = elemen.front().first < 0 ? elemen.front().first : elemen.back().first;
+            throw std::invalid_argument("SparseTensor: indeks kolom " + std::to_string(k) +
+                                        " di luar [0, " + std::to_string(kolom) + ")");
+        }
+        for (size_t i = 0; i < elemen.size(); ++i) {
+            if (i > 0 && elemen[i].first == elemen[i - 1].first) {
+                nilai.back() += elemen[i].second;
+            } else {
+                indeks_kolom.push_back(elemen[i].first);
+                nilai.push_back(elemen[i].second);
+            }
+        }
+        offset_baris.push_back(static_cast<dl::index_t>(nilai.size()));
+        ++baris;
+    }
+
+    // Shape nya [baris, kolom], sama kek Tensor 2D //
+    Shape get_shape() const {
+        return Shape{baris, kolom};
+    }
+
+    // Jumlah elemen yang bukan nol //
+    dl::index_t nnz() const {
+        return static_cast<dl::index_t>(nilai.size());
+    }
+
+    // Persentase elemen yang bukan nol //
+    double densitas() const {
+        if (baris == 0 || kolom == 0) return 0.0;
+        return static_cast<double>(nnz()) / (static_cast<double>(baris) * static_cast<double>(kolom));
+    }
+
+    // Getter array CSR //
+    const Indeks& get_offset_baris() const { return offset_baris; }
+    const Indeks& get_indeks_kolom() const { return indeks_kolom; }
+    const Storage& get_nilai() const { return nilai; }
+
+    // Range nilai baris b: [awal_baris(b), akhir_baris(b)) //
+    dl::index_t awal_baris(dl::index_t b) const { return offset_baris[b]; }
+    dl::index_t akhir_baris(dl::index_t b) const { return offset_baris[b + 1]; }
+
+    // Ukuran memori dalam bytes //
+    long long bytes() const {
+        return static_cast<long long>(offset_baris.size() + indeks_kolom.size()) * sizeof(dl::index_t) +
+               static_cast<long long>(nilai.size()) * sizeof(double);
+    }
+
+    // Ambil baris [mulai, akhir) sebagai SparseTensor baru, buat mini-batch //
+    SparseTensor irisan_baris(dl::index_t mulai, dl::index_t akhir) const {
+        assert(mulai >= 0 && mulai <= akhir && akhir <= baris && "Irisan baris di luar ukuran");
+        SparseTensor hasil(0, kolom);
+        const dl::index_t p0 = offset_baris[mulai];
+        const dl::index_t p1 = offset_baris[akhir];
+        hasil.baris = akhir - mulai;
+        hasil.offset_baris.resize(hasil.baris + 1);
+        for (dl::index_t b = 0; b <= hasil.baris; ++b) {
+            hasil.offset_baris[b] = offset_baris[mulai + b] - p0;
+        }
+        hasil.indeks_kolom.assign(indeks_kolom.begin() + p0, indeks_kolom.begin() + p1);
+        hasil.nilai.assign(nilai.begin() + p0, nilai.begin() + p1);
+        return hasil;
+    }
+
+    // Konversi ke Tensor dense [baris, kolom] //
+    Tensor to_dense() const {
+        Tensor t = dl::zeros({baris, kolom});
+        for (dl::index_t b = 0; b < baris; ++b) {
+            double* row = t.row_ptr(b);
+            for (dl::index_t p = offset_baris[b]; p < offset_baris[b + 1]; ++p) {
+                row[indeks_kolom[p]] = nilai[p];
+            }
+        }
+        return t;
+    }
+};
+
+namespace dl {
+
+// Buat SparseTensor dari Tensor 2D, elemen yang |x| <= ambang di anggap nol //
+inline SparseTensor sparse(const Tensor& dense, double ambang = 0.0) {
+    assert(dense.get_shape().size() == 2 && "sparse() cuma buat Tensor 2D");
+    const index_t baris = dense.get_shape()[0];
+    const index_t kolom = dense.get_shape()[1];
+    std::vector<index_t> offset(1, 0);
+    std::vector<index_t> indeks;
+    std::vector<double> nilai;
+    offset.reserve(baris + 1);
+    for (index_t b = 0; b < baris; ++b) {
+        const double* row = dense.row_ptr(b);
+        for (index_t k = 0; k < kolom; ++k) {
+            if (std::abs(row[k]) > ambang) {
+                indeks.push_back(k);
+                nilai.push_back(row[k]);
+            }
+        }
+        offset.push_back(static_cast<index_t>(nilai.size()));
+    }
+    return SparseTensor(baris, kolom, offset, indeks, nilai);
+}
+
+// One-hot sparse: baris b punya satu nilai 1 di kolom indeks[b], indeks di luar [0, jumlah_kelas) lempar std::invalid_argument //
+inline SparseTensor one_hot_sparse(const std::vector<index_t>& indeks, index_t jumlah_kelas) {
+    const index_t n = static_cast<index_t>(indeks.size());
+    std::vector<index_t> offset(n + 1);
+    for (index_t b = 0; b <= n; ++b) {
+        offset[b] = b;
+    }
+    return SparseTensor(n, jumlah_kelas, offset, indeks, std::vector<double>(indeks.size(), 1.0));
+}
+
+// LOADER //
+
+// Hasil loader: fitur sparse X [n, n_fitur] dan label y [n, 1] //
+struct DatasetSparse {
+    SparseTensor X;
+    Tensor y;
+};
+
+/*
+Baca format LIBSVM / SVMlight, format standar buat fitur sparse:
+    <label> <indeks>:<nilai> <indeks>:<nilai> ...
+Contoh:
+    1 3:1 17:0.5 1024:1
+    0 5:1 # komentar
+Indeks nya mulai dari 1 (kek LIBSVM), set mulai_dari_satu = false kalau data nya mulai dari 0.
+Kalau n_fitur = 0, jumlah kolom nya di ambil dari indeks terbesar yang muncul.
+Baris kosong dan baris yang di awali # di lewati.
+
+Input nya di cek pas runtime (bukan assert, file nya dari luar): token tanpa ':', angka yang
+gak ke parse, indeks < 0 (termasuk indeks 0 di file yang mulai dari 1) atau indeks >= n_fitur
+lempar std::runtime_error dengan nomor baris nya.
+*/
+inline DatasetSparse baca_libsvm(std::istream& in, index_t n_fitur = 0, bool mulai_dari_satu = true) {
+    std::vector<double> label;
+    std::vector<std::vector<std::pair<index_t, double>>> semua_baris;
+    index_t kolom_maks = -1;
+    long long nomor_baris = 0;
+
+    auto gagal = [&](const std::string& pesan) {
+        throw std::runtime_error("baca_libsvm: baris " + std::to_string(nomor_baris) + ": " + pesan);
+    };
+    // stoll / stod yang harus makan token nya sampai habis, error nya di ubah jadi runtime_error //
+    auto parse_indeks = [&](const std::string& teks, const std::string& token) -> index_t {
+        size_t pos = 0;
+        long long k = 0;
+        try {
+            k = std::stoll(teks, &pos);
+        } catch (const std::exception&) {
+            gagal("indeks gak valid di '" + token + "'");
+        }
+        if (pos != teks.size()) gagal("indeks gak valid di '" + token + "'");
+        return static_cast<index_t>(k);
+    };
+    auto parse_nilai = [&](const std::string& teks, const std::string& token, const char* apa) -> double {
+        size_t pos = 0;
+        double v = 0.0;
+        try {
+            v = std::stod(teks, &pos);
+        } catch (const std::exception&) {
+            gagal(std::string(apa) + " gak valid di '" + token + "'");
+        }
+        if (pos != teks.size()) gagal(std::string(apa) + " gak valid di '" + token + "'");
+        return v;
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        ++nomor_baris;
+        size_t komentar = line.find('#');
+        if (komentar != std::string::npos) {
+            line.erase(komentar);
+        }
+        std::istringstream ss(line);
+        std::string token;
+        if (!(ss >> token)) continue;
+        const double lbl = parse_nilai(token, token, "label");
+
+        std::vector<std::pair<index_t, double>> elemen;
+        while (ss >> token) {
+            size_t titik_dua = token.find(':');
+            if (titik_dua == std::string::npos) {
+                gagal("token '" + token + "' harus indeks:nilai");
+            }
+            const index_t mentah = parse_indeks(token.substr(0, titik_dua), token);
+            const index_t k = mentah - (mulai_dari_satu ? 1 : 0);
+            if (k < 0) {
+                gagal("indeks fitur " + std::to_string(mentah) + " di luar range" +
+                      (mulai_dari_satu && mentah == 0 ? " (indeks nya mulai dari 1, pakai mulai_dari_satu = false kalau file nya mulai dari 0)" : ""));
+            }
+            if (n_fitur > 0 && k >= n_fitur) {
+                gagal("indeks fitur " + std::to_string(mentah) + " lebih besar dari n_fitur " + std::to_string(n_fitur));
+            }
+            const double v = parse_nilai(token.substr(titik_dua + 1), token, "nilai");
+            kolom_maks = std::max(kolom_maks, k);
+            elemen.emplace_back(k, v);
+        }
+        label.push_back(lbl);
+        semua_baris.push_back(std::move(elemen));
+    }
+
+    if (n_fitur == 0) {
+        n_fitur = kolom_maks + 1;
+    }
+
+    DatasetSparse hasil;
+    hasil.X = SparseTensor(0, n_fitur);
+    for (auto& elemen : semua_baris) {
+        hasil.X.tambah_baris(std::move(elemen));
+    }
+    hasil.y = Tensor({static_cast<index_t>(label.size()), 1}, label);
+    return hasil;
+}
+
+// Sama kek baca_libsvm tapi dari file (error format nya juga lempar std::runtime_error) //
+inline DatasetSparse muat_libsvm(const std::string& path, index_t n_fitur = 0, bool mulai_dari_satu = true) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "muat_libsvm: gagal buka file " << path << std::endl;
+        return DatasetSparse{SparseTensor(0, n_fitur), Tensor({0, 1})};
+    }
+    return baca_libsvm(file, n_fitur, mulai_dari_satu);
+}
+
+} // namespace dl //
+
+// Print SparseTensor, cuma ringkasan nya biar gak banjir output //
+inline std::ostream& operator<<(std::ostream& os, const SparseTensor& s) {
+    os << "SparseTensor(shape=[" << s.get_shape()[0] << ", " << s.get_shape()[1]
+       << "], nnz=" << s.nnz() << ", densitas=" << s.densitas() << ")";
+    return os;
+}
+
+#endif
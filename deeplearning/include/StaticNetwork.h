@@ -0,0 +1,366 @@
+#ifndef STATIC_NETWORK_H
+#define STATIC_NETWORK_H
+
+#include "Tensor.h"
+#include "Tensor_factory.h"
+#include "FastMath.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+/*
+Static Network, versi NeuralNetwork yang ukuran nya sudah di tentukan pas compile.
+Buat model kecil kek 2 -> 4 -> 1 di main.cpp, waktu nya bukan habis di aritmatika,
+tapi habis di alokasi std::vector dan hitungan index at({...}).
+
+Di sini semua nya pakai std::array:
+1. Bobot, bias, gradient, state Adam, dan cache semua nya di stack (atau di dalam objek).
+2. Shape di cek pas compile, jadi Dense(2,4) lanjut Dense(3,1) langsung error compile.
+3. Loop nya pakai ukuran constexpr dan di unroll penuh pakai static_for.
+
+Contoh:
+    StaticNetwork<StaticDense<2, 4>, StaticReLU<4>, StaticDense<4, 1>, StaticSigmoid<1>> nn(0.001);
+    nn.train(X, y, 100);
+    auto out = nn.predict(std::array<double, 2>{1.0, 0.0});
+
+Semantik train/predict nya sama kek NeuralNetwork:
+inisialisasi Kaiming, loss Binary Cross Entropy, gradient di jumlah kan per batch, lalu Adam.
+Karna backward per sampel langsung di akumulasi, gak perlu nyimpen aktivasi satu batch penuh.
+*/
+
+namespace dl {
+namespace detail {
+
+// Unroll loop pas compile: f(0), f(1), ..., f(N-1) //
+template <typename F, std::size_t... I>
+inline void static_for_impl(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+template <std::size_t N, typename F>
+inline void static_for(F&& f) {
+    static_for_impl(std::forward<F>(f), std::make_index_sequence<N>{});
+}
+
+} // namespace detail //
+} // namespace dl //
+
+// Dense dengan ukuran compile-time //
+template <int In, int Out>
+class StaticDense {
+public:
+    static constexpr int input_size = In;
+    static constexpr int output_size = Out;
+    using Input = std::array<double, In>;
+    using Output = std::array<double, Out>;
+
+private:
+    std::array<double, Out * In> bobot;
+    std::array<double, Out> bias;
+    std::array<double, Out * In> grad_bobot;
+    std::array<double, Out> grad_bias;
+
+    // State Adam //
+    std::array<double, Out * In> m_bobot, v_bobot;
+    std::array<double, Out> m_bias, v_bias;
+    int t = 0;
+
+    Input cached_input;
+
+public:
+    StaticDense() {
+        // Sama kek Dense: Kaiming normal buat bobot, bias nol //
+        Tensor w = dl::kaiming_normal({Out, In});
+        for (int i = 0; i < Out * In; ++i) {
+            bobot[i] = w[i];
+        }
+        bias.fill(0.0);
+        m_bobot.fill(0.0);
+        v_bobot.fill(0.0);
+        m_bias.fill(0.0);
+        v_bias.fill(0.0);
+        zero_grad();
+    }
+
+    // Forward: y = W x + b //
+    Output forward(const Input& x) {
+        cached_input = x;
+        Output y;
+        dl::detail::static_for<Out>([&](auto o) {
+            double sum = 0.0;
+            dl::detail::static_for<In>([&](auto k) {
+                sum += x[k] * bobot[o * In + k];
+            });
+            y[o] = sum + bias[o];
+        });
+        return y;
+    }
+
+    // Backward: akumulasi gradient bobot dan bias, return gradient input //
+    Input backward(const Output& g) {
+        dl::detail::static_for<Out>([&](auto o) {
+            grad_bias[o] += g[o];
+            dl::detail::static_for<In>([&](auto k) {
+                grad_bobot[o * In + k] += g[o] * cached_input[k];
+            });
+        });
+
+        Input gx;
+        dl::detail::static_for<In>([&](auto k) {
+            double sum = 0.0;
+            dl::detail::static_for<Out>([&](auto o) {
+                sum += g[o] * bobot[o * In + k];
+            });
+            gx[k] = sum;
+        });
+        return gx;
+    }
+
+    void zero_grad() {
+        grad_bobot.fill(0.0);
+        grad_bias.fill(0.0);
+    }
+
+    // Update Adam, rumus nya sama persis dengan class adam //
+    void optimisasi(double lr, double beta1 = 0.9, double beta2 = 0.999, double epsilon = 1e-8) {
+        t++;
+        const double koreksi_bias1 = 1.0 - std::pow(beta1, t);
+        const double koreksi_bias2 = 1.0 - std::pow(beta2, t);
+        auto langkah = [&](double& w, double& m, double& v, double g) {
+            m = beta1 * m + (1 - beta1) * g;
+            v = beta2 * v + (1 - beta2) * (g * g);
+            double m_hat = m / koreksi_bias1;
+            double v_hat = v / koreksi_bias2;
+            w = w - lr * m_hat / (std::sqrt(v_hat) + epsilon);
+        };
+        dl::detail::static_for<Out * In>([&](auto i) {
+            langkah(bobot[i], m_bobot[i], v_bobot[i], grad_bobot[i]);
+        });
+        dl::detail::static_for<Out>([&](auto i) {
+            langkah(bias[i], m_bias[i], v_bias[i], grad_bias[i]);
+        });
+    }
+
+    static constexpr int num_parameters() { return In * Out + Out; }
+
+    const std::array<double, Out * In>& dapatkan_bobot() const { return bobot; }
+    const std::array<double, Out>& dapatkan_bias() const { return bias; }
+};
+
+// ReLU compile-time, cache input nya buat backward //
+template <int N>
+class StaticReLU {
+public:
+    static constexpr int input_size = N;
+    static constexpr int output_size = N;
+    using Input = std::array<double, N>;
+    using Output = std::array<double, N>;
+
+private:
+    Input cached_input;
+
+public:
+    Output forward(const Input& x) {
+        cached_input = x;
+        Output y;
+        dl::detail::static_for<N>([&](auto i) {
+            y[i] = std::max(0.0, x[i]);
+        });
+        return y;
+    }
+
+    Input backward(const Output& g) {
+        Input gx;
+        dl::detail::static_for<N>([&](auto i) {
+            gx[i] = g[i] * ((cached_input[i] > 0) ? 1.0 : 0.0);
+        });
+        return gx;
+    }
+
+    void zero_grad() {}
+    void optimisasi(double) {}
+    static constexpr int num_parameters() { return 0; }
+};
+
+// Sigmoid compile-time, cache output nya buat backward //
+template <int N>
+class StaticSigmoid {
+public:
+    static constexpr int input_size = N;
+    static constexpr int output_size = N;
+    using Input = std::array<double, N>;
+    using Output = std::array<double, N>;
+
+private:
+    Output cached_output;
+
+public:
+    Output forward(const Input& x) {
+        dl::detail::static_for<N>([&](auto i) {
+            cached_output[i] = dl::fastmath::sigmoid(x[i]);
+        });
+        return cached_output;
+    }
+
+    Input backward(const Output& g) {
+        Input gx;
+        dl::detail::static_for<N>([&](auto i) {
+            gx[i] = g[i] * (cached_output[i] * (1.0 - cached_output[i]));
+        });
+        return gx;
+    }
+
+    void zero_grad() {}
+    void optimisasi(double) {}
+    static constexpr int num_parameters() { return 0; }
+};
+
+// Cek pas compile: output layer i harus sama dengan input layer i+1 //
+template <typename... Layers>
+struct shape_cocok : std::true_type {};
+
+template <typename A, typename B, typename... Sisa>
+struct shape_cocok<A, B, Sisa...>
+    : std::integral_constant<bool, A::output_size == B::input_size && shape_cocok<B, Sisa...>::value> {};
+
+template <typename... Layers>
+class StaticNetwork {
+    static_assert(sizeof...(Layers) > 0, "StaticNetwork butuh minimal satu layer");
+    static_assert(shape_cocok<Layers...>::value,
+                  "Shape layer gak nyambung: output_size layer sebelum nya harus sama dengan input_size layer berikut nya");
+
+public:
+    using LayerPertama = typename std::tuple_element<0, std::tuple<Layers...>>::type;
+    using LayerTerakhir = typename std::tuple_element<sizeof...(Layers) - 1, std::tuple<Layers...>>::type;
+    static constexpr int input_size = LayerPertama::input_size;
+    static constexpr int output_size = LayerTerakhir::output_size;
+    using Input = std::array<double, input_size>;
+    using Output = std::array<double, output_size>;
+
+private:
+    std::tuple<Layers...> layers;
+    double learning_rate;
+
+    template <std::size_t I, typename X>
+    auto forward_dari(const X& x) {
+        if constexpr (I == sizeof...(Layers)) {
+            return x;
+        } else {
+            return forward_dari<I + 1>(std::get<I>(layers).forward(x));
+        }
+    }
+
+    template <std::size_t I, typename G>
+    void backward_dari(const G& g) {
+        auto gx = std::get<I>(layers).backward(g);
+        if constexpr (I > 0) {
+            backward_dari<I - 1>(gx);
+        }
+    }
+
+    template <typename F>
+    void untuk_setiap_layer(F&& f) {
+        std::apply([&](auto&... layer) { (f(layer), ...); }, layers);
+    }
+
+public:
+    // Layer di konstruksi lewat braced-init-list biar urutan nya dijamin kiri ke kanan, //
+    // jadi urutan pengambilan angka random nya sama dengan NeuralNetwork //
+    StaticNetwork(double lr = 0.001) : layers{Layers()...}, learning_rate(lr) {}
+
+    // Forward satu sampel, gak ada alokasi heap sama sekali //
+    Output forward(const Input& x) {
+        return forward_dari<0>(x);
+    }
+
+    Output predict(const Input& x) {
+        return forward(x);
+    }
+
+    // Prediksi batch dari Tensor [batch, input_size] //
+    Tensor predict(const Tensor& X) {
+        const dl::index_t batch = X.get_shape()[0];
+        Tensor out({batch, output_size});
+        Input x;
+        for (dl::index_t b = 0; b < batch; ++b) {
+            for (int k = 0; k < input_size; ++k) {
+                x[k] = X[b * input_size + k];
+            }
+            Output y = forward(x);
+            for (int o = 0; o < output_size; ++o) {
+                out[b * output_size + o] = y[o];
+            }
+        }
+        return out;
+    }
+
+    void zero_grad() {
+        untuk_setiap_layer([](auto& layer) { layer.zero_grad(); });
+    }
+
+    void optimisasi() {
+        untuk_setiap_layer([&](auto& layer) { layer.optimisasi(learning_rate); });
+    }
+
+    /*
+    Satu langkah training.
+    Setiap sampel di forward lalu langsung di backward, gradient nya di akumulasi.
+    Karna bobot gak berubah di dalam satu langkah, hasil nya sama dengan backward satu batch penuh.
+    */
+    double train_step(const Tensor& X, const Tensor& y) {
+        const dl::index_t batch = X.get_shape()[0];
+        const double eps = 1e-7;
+        double loss = 0.0;
+
+        zero_grad();
+
+        Input x;
+        for (dl::index_t b = 0; b < batch; ++b) {
+            for (int k = 0; k < input_size; ++k) {
+                x[k] = X[b * input_size + k];
+            }
+            Output pred = forward(x);
+
+            // Binary Cross Entropy, sama kek BinaryCrossEnrtopy //
+            Output grad;
+            for (int o = 0; o < output_size; ++o) {
+                double p = std::max(eps, std::min(1.0 - eps, pred[o]));
+                double t = y[b * output_size + o];
+                loss += -(t * dl::fastmath::log(p) + (1.0 - t) * dl::fastmath::log(1.0 - p));
+                grad[o] = (p - t) / (p * (1.0 - p));
+            }
+
+            backward_dari<sizeof...(Layers) - 1>(grad);
+        }
+
+        optimisasi();
+        return loss / (static_cast<double>(batch) * output_size);
+    }
+
+    // Training untuk beberapa epoch //
+    void train(const Tensor& X, const Tensor& y, int epochs = 100, bool verbose = true) {
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            double loss = train_step(X, y);
+
+            if (verbose && (epoch + 1) % 10 == 0) {
+                std::cout << "Epoch " << (epoch + 1) << "/" << epochs
+                          << " - Loss: " << loss << std::endl;
+            }
+        }
+    }
+
+    static constexpr int num_parameters() {
+        return (Layers::num_parameters() + ...);
+    }
+
+    // Akses layer ke-I //
+    template <std::size_t I>
+    auto& layer() { return std::get<I>(layers); }
+};
+
+#endif
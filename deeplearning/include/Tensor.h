@@ -6,6 +6,10 @@
 #include <numeric>
 #include <cassert>
 #include <cmath>
+#include <type_traits>
+#include "Memory.h"
+#include "Tensor_iterator.h"
+#include "Tensor_shape.h"
 
 /*
 Apa sih itu Tensor?
@@ -22,6 +26,10 @@ sesuai dengan dimensi B yang besar. Contoh misal nya A = (2,3) dan B itu (4,2,3)
 untuk bisa di hitung dengan B. */
 
 class Tensor {
+    public:
+    // Storage data Tensor, alokasi nya di catat sama dl::memori //
+    using Storage = std::vector<double, dl::memori::TrackingAllocator<double>>;
+
     private:
     // Ini variabel yang wajib di pakai dalam pembuatan Tensor //
 
@@ -29,30 +37,61 @@ class Tensor {
         Tensor = 1D array + metadata
     */ 
 
-    std::vector<double> data;
-    std::vector<int> bentuk;
-    std::vector<int> strides;
+    Storage data;
+    // Bentuk dan strides di simpan inline (lihat Tensor_shape.h), jadi gak alokasi heap //
+    Shape bentuk;
+    Shape strides;
     bool requires_grad;
 
+    // Posisi Tensor ini di tape autograd (lihat Autograd.h) //
+    // slot = -1 artinya Tensor ini bukan hasil operasi yang di rekam //
+    int tape_slot = -1;
+    unsigned tape_generasi = 0;
+
     public:
 
     // Kita membuat fungsi hitung jumlah elemen atau size elemen dalam Tensor //
-    int numel(const std::vector<int>& bentuk) const {
-        return std::accumulate(bentuk.begin(), bentuk.end(), 1, std::multiplies<int>());
+    // Init accumulate harus index_t, kalau pakai 1 (int) hasil nya overflow diam-diam di atas 2^31 //
+    dl::index_t numel(const Shape& bentuk) const {
+        return std::accumulate(bentuk.begin(), bentuk.end(), dl::index_t(1), std::multiplies<dl::index_t>());
     };
 
-    // Versi numel tanpa argumen - menggunakan bentuk internal //
-    int numel() const {
-        return std::accumulate(bentuk.begin(), bentuk.end(), 1, std::multiplies<int>());
+    // Versi numel tanpa argumen - jumlah elemen data nya langsung //
+    // Tensor default (kosong) punya 0 elemen //
+    dl::index_t numel() const {
+        return static_cast<dl::index_t>(data.size());
     };
 
     // Getter untuk bentuk/shape //
-    const std::vector<int>& get_shape() const {
+    const Shape& get_shape() const {
         return bentuk;
     };
 
+    // Getter dan setter untuk requires_grad //
+    bool get_requires_grad() const {
+        return requires_grad;
+    };
+
+    void set_requires_grad(bool nilai) {
+        requires_grad = nilai;
+    };
+
+    // Getter dan setter posisi di tape autograd //
+    int get_tape_slot() const {
+        return tape_slot;
+    };
+
+    unsigned get_tape_generasi() const {
+        return tape_generasi;
+    };
+
+    void set_tape_slot(int slot, unsigned generasi) {
+        tape_slot = slot;
+        tape_generasi = generasi;
+    };
+
     // Getter untuk data (read-only) //
-    const std::vector<double>& get_data() const {
+    const Storage& get_data() const {
         return data;
     };
 
@@ -60,11 +99,11 @@ class Tensor {
     // Lu perlu buat perhitungan strides //
     // Jadi gampang nya itu strides kek "Kalau indeks di dimensi ini naik 1, lompat berapa di memori?" //
 
-    std::vector<int> perhitungan_strides(const std::vector<int>& bentuk) const {
+    Shape perhitungan_strides(const Shape& bentuk) const {
         // Cek semua ukuran elemen //
-        int n = bentuk.size();
+        int n = static_cast<int>(bentuk.size());
         // Inisialisasi strides //
-        std::vector<int> strides(n);
+        Shape strides = Shape::dengan_rank(n);
         if (n > 0) {
             // Lalu set elemen terakhir menjadi 1 //
             strides[n-1] = 1;
@@ -89,7 +128,7 @@ class Tensor {
     Tensor() : requires_grad(false) {};
 
     // Ini bagian paling penting dalam multi dimensi setelah perhitungan strides //
-    Tensor(const std::vector<int>& bentuk_) {
+    Tensor(const Shape& bentuk_) {
         // inisialisasi bentuk dan strides //
         bentuk = bentuk_;
         strides = perhitungan_strides(bentuk);
@@ -98,17 +137,46 @@ class Tensor {
     };
 
     // Constructor dengan data awal
-    Tensor(const std::vector<int>& bentuk_, const std::vector<double>& data_) {
+    Tensor(const Shape& bentuk_, const std::vector<double>& data_) {
         bentuk = bentuk_;
         strides = perhitungan_strides(bentuk);
-        data = data_;
+        data.assign(data_.begin(), data_.end());
         requires_grad = false;
     };
 
     // Copy constructor
     Tensor(const Tensor& other) 
-        : data(other.data), bentuk(other.bentuk), 
-          strides(other.strides), requires_grad(other.requires_grad) {};
+        : data(salin_storage(other.data)), bentuk(other.bentuk), 
+          strides(other.strides), requires_grad(other.requires_grad),
+          tape_slot(other.tape_slot), tape_generasi(other.tape_generasi) {};
+
+    // Move constructor, biar return Tensor dari fungsi gak perlu copy data //
+    Tensor(Tensor&& other) noexcept = default;
+
+    // Assignment operators //
+    // Copy assignment ikut mewarisi tag memori kek copy constructor, kalau buffer nya harus alokasi ulang //
+    // Kalau kapasitas buffer tujuan cukup, buffer nya di pakai ulang dan tag nya tetap punya tujuan //
+    Tensor& operator=(const Tensor& other) {
+        if (this != &other) {
+            {
+                dl::memori::Tag tag(dl::memori::tag_warisan(other.data.data()));
+                data = other.data;
+            }
+            bentuk = other.bentuk;
+            strides = other.strides;
+            requires_grad = other.requires_grad;
+            tape_slot = other.tape_slot;
+            tape_generasi = other.tape_generasi;
+        }
+        return *this;
+    }
+    Tensor& operator=(Tensor&& other) noexcept = default;
+
+    // Salin storage dengan tag memori yang di warisi dari Tensor asal //
+    static Storage salin_storage(const Storage& asal) {
+        dl::memori::Tag tag(dl::memori::tag_warisan(asal.data()));
+        return asal;
+    };
 
     // Lalu kita melakukan indeksing multidimensi Tensor //
 
@@ -118,9 +186,9 @@ class Tensor {
     */
 
     // Ini bagian Tensor terasa ajaib sih //
-    int flatten_index(const std::vector<int>& indices,
-                    const std::vector<int>& strides) const {
-                        int index = 0;
+    dl::index_t flatten_index(const std::vector<dl::index_t>& indices,
+                    const Shape& strides) const {
+                        dl::index_t index = 0;
                         for (size_t i = 0; i < indices.size(); ++i) {
                             index += indices[i] * strides[i];
                         }
@@ -129,20 +197,104 @@ class Tensor {
                     };
 
     // Tambahin juga getter buat data dan bentuk //
-    double& at(const std::vector<int>& indices) {
+    double& at(const std::vector<dl::index_t>& indices) {
         return data[flatten_index(indices, strides)];
     };
 
-    const double& at(const std::vector<int>& indices) const {
+    const double& at(const std::vector<dl::index_t>& indices) const {
         return data[flatten_index(indices, strides)];
     };
 
+    /*
+    Akses variadic: t.at(i, j) atau t.at(i, j, k).
+    Rank nya ketahuan pas compile, jadi gak ada std::vector sementara dan gak ada loop.
+    Stride dimensi terakhir selalu 1 (data contiguous), jadi buat matriks
+    at(i, j) cuma jadi i * strides[0] + j, satu multiply-add.
+    */
+    template <typename... Idx,
+              typename = std::enable_if_t<(sizeof...(Idx) > 0) && (std::is_integral<Idx>::value && ...)>>
+    dl::index_t offset(Idx... idx) const {
+        assert(sizeof...(Idx) == bentuk.size() && "Jumlah indeks harus sama dengan rank Tensor");
+        const dl::index_t indeks[] = {static_cast<dl::index_t>(idx)...};
+        constexpr size_t n = sizeof...(Idx);
+        dl::index_t index = indeks[n - 1];
+        for (size_t d = 0; d + 1 < n; ++d) {
+            index += indeks[d] * strides[d];
+        }
+        return index;
+    };
+
+    template <typename... Idx,
+              typename = std::enable_if_t<(sizeof...(Idx) > 0) && (std::is_integral<Idx>::value && ...)>>
+    double& at(Idx... idx) {
+        return data[offset(idx...)];
+    };
+
+    template <typename... Idx,
+              typename = std::enable_if_t<(sizeof...(Idx) > 0) && (std::is_integral<Idx>::value && ...)>>
+    const double& at(Idx... idx) const {
+        return data[offset(idx...)];
+    };
+
+    // Pointer ke data mentah //
+    double* data_ptr() {
+        return data.data();
+    };
+
+    const double* data_ptr() const {
+        return data.data();
+    };
+
+    // Pointer ke awal baris i (dimensi pertama) //
+    double* row_ptr(dl::index_t i) {
+        return data.data() + i * strides[0];
+    };
+
+    const double* row_ptr(dl::index_t i) const {
+        return data.data() + i * strides[0];
+    };
+
+    // Span satu baris, panjang nya strides[0] (semua elemen di bawah indeks i) //
+    dl::Span<double> row(dl::index_t i) {
+        return dl::Span<double>(row_ptr(i), strides[0]);
+    };
+
+    dl::Span<const double> row(dl::index_t i) const {
+        return dl::Span<const double>(row_ptr(i), strides[0]);
+    };
+
+    // Range satu kolom matriks 2D, loncat strides[0] setiap elemen //
+    dl::StridedRange<double> column(dl::index_t j) {
+        return dl::StridedRange<double>(data.data() + j, bentuk[0], strides[0]);
+    };
+
+    dl::StridedRange<const double> column(dl::index_t j) const {
+        return dl::StridedRange<const double>(data.data() + j, bentuk[0], strides[0]);
+    };
+
+    // Iterator STL buat semua elemen (contiguous) //
+    double* begin() {
+        return data.data();
+    };
+
+    double* end() {
+        return data.data() + data.size();
+    };
+
+    const double* begin() const {
+        return data.data();
+    };
+
+    const double* end() const {
+        return data.data() + data.size();
+    };
+
     // Akses elemen dengan indeks flat //
-    double& operator[](int i) {
+    double& operator[](dl::index_t i) {
         return data[i];
     };
 
-    const double& operator[](int i) const {
+    const double& operator[](dl::index_t i) const {
         return data[i];
     };
 
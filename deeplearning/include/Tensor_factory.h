@@ -3,6 +3,7 @@
 
 #include "Tensor.h"
 #include "Tensor_operator.h"
+#include "Random.h"
 #include <random>
 #include <chrono>
 #include <initializer_list>
@@ -18,6 +19,11 @@ Ini gw ambil inspirasi dari Pytorch, cuma gw buat versi C++.
 namespace dl {
 
 // RANDOM NUMBER GENERATOR //
+/*
+Factory random (rand, randn, uniform, normal, xavier, kaiming) pakai generator Philox
+di Random.h, bukan mt19937 lagi: bisa di isi paralel dan hasil nya sama berapa pun thread nya.
+mt19937 ini masih ada buat kode luar yang butuh engine std biasa.
+*/
 // Global random engine //
 inline std::mt19937& get_random_engine() {
     static std::mt19937 gen(
@@ -31,31 +37,32 @@ inline std::mt19937& get_random_engine() {
 // Set random seed (untuk reproducibility)
 inline void manual_seed(unsigned int seed) {
     get_random_engine().seed(seed);
+    random::generator().seed(seed);
 }
 
 // BASIC FACTORY FUNCTIONS //
 // Buat tensor dari shape dengan nilai 0
-inline Tensor zeros(const std::vector<int>& shape) {
+inline Tensor zeros(const Shape& shape) {
     Tensor t(shape);
-    for (int i = 0; i < t.numel(); ++i) {
+    for (dl::index_t i = 0; i < t.numel(); ++i) {
         t[i] = 0.0;
     }
     return t;
 }
 
 // Buat tensor dari shape dengan nilai 1
-inline Tensor ones(const std::vector<int>& shape) {
+inline Tensor ones(const Shape& shape) {
     Tensor t(shape);
-    for (int i = 0; i < t.numel(); ++i) {
+    for (dl::index_t i = 0; i < t.numel(); ++i) {
         t[i] = 1.0;
     }
     return t;
 }
 
 // Buat tensor dengan nilai tertentu
-inline Tensor full(const std::vector<int>& shape, double value) {
+inline Tensor full(const Shape& shape, double value) {
     Tensor t(shape);
-    for (int i = 0; i < t.numel(); ++i) {
+    for (dl::index_t i = 0; i < t.numel(); ++i) {
         t[i] = value;
     }
     return t;
@@ -63,42 +70,30 @@ inline Tensor full(const std::vector<int>& shape, double value) {
 
 // RANDOM TENSOR FUNCTIONS //
 // Tensor dengan random uniform distribution [0, 1] //
-inline Tensor rand(const std::vector<int>& shape) {
+inline Tensor rand(const Shape& shape) {
     Tensor t(shape);
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    for (int i = 0; i < t.numel(); ++i) {
-        t[i] = dist(get_random_engine());
-    }
+    random::generator().uniform(t.data_ptr(), t.numel(), 0.0, 1.0);
     return t;
 }
 
 // Tensor dengan random normal distribution (mean=0, std=1) //
-inline Tensor randn(const std::vector<int>& shape) {
+inline Tensor randn(const Shape& shape) {
     Tensor t(shape);
-    std::normal_distribution<double> dist(0.0, 1.0);
-    for (int i = 0; i < t.numel(); ++i) {
-        t[i] = dist(get_random_engine());
-    }
+    random::generator().normal(t.data_ptr(), t.numel(), 0.0, 1.0);
     return t;
 }
 
 // Tensor dengan random uniform dalam range [low, high] //
-inline Tensor uniform(const std::vector<int>& shape, double low, double high) {
+inline Tensor uniform(const Shape& shape, double low, double high) {
     Tensor t(shape);
-    std::uniform_real_distribution<double> dist(low, high);
-    for (int i = 0; i < t.numel(); ++i) {
-        t[i] = dist(get_random_engine());
-    }
+    random::generator().uniform(t.data_ptr(), t.numel(), low, high);
     return t;
 }
 
 // Tensor dengan random normal dengan mean dan std custom //
-inline Tensor normal(const std::vector<int>& shape, double mean, double std) {
+inline Tensor normal(const Shape& shape, double mean, double std) {
     Tensor t(shape);
-    std::normal_distribution<double> dist(mean, std);
-    for (int i = 0; i < t.numel(); ++i) {
-        t[i] = dist(get_random_engine());
-    }
+    random::generator().normal(t.data_ptr(), t.numel(), mean, std);
     return t;
 }
 
@@ -109,17 +104,17 @@ inline Tensor arange(double start, double end, double step = 1.0) {
     for (double val = start; val < end; val += step) {
         data.push_back(val);
     }
-    return Tensor({static_cast<int>(data.size())}, data);
+    return Tensor({static_cast<index_t>(data.size())}, data);
 }
 
 // Buat tensor dengan n nilai linear dari start sampai end //
-inline Tensor linspace(double start, double end, int steps) {
+inline Tensor linspace(double start, double end, index_t steps) {
     std::vector<double> data(steps);
     if (steps == 1) {
         data[0] = start;
     } else {
         double step = (end - start) / (steps - 1);
-        for (int i = 0; i < steps; ++i) {
+        for (index_t i = 0; i < steps; ++i) {
             data[i] = start + i * step;
         }
     }
@@ -128,11 +123,11 @@ inline Tensor linspace(double start, double end, int steps) {
 
 // IDENTITY & SPECIAL TENSORS //
 // Buat identity matrix (untuk linear algebra) //
-inline Tensor eye(int n) {
+inline Tensor eye(index_t n) {
     Tensor t({n, n});
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            t.at({i, j}) = (i == j) ? 1.0 : 0.0;
+    for (index_t i = 0; i < n; ++i) {
+        for (index_t j = 0; j < n; ++j) {
+            t.at(i, j) = (i == j) ? 1.0 : 0.0;
         }
     }
     return t;
@@ -140,11 +135,11 @@ inline Tensor eye(int n) {
 
 // Buat diagonal matrix dari vector //
 inline Tensor diag(const std::vector<double>& values) {
-    int n = static_cast<int>(values.size());
+    index_t n = static_cast<index_t>(values.size());
     Tensor t({n, n});
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            t.at({i, j}) = (i == j) ? values[i] : 0.0;
+    for (index_t i = 0; i < n; ++i) {
+        for (index_t j = 0; j < n; ++j) {
+            t.at(i, j) = (i == j) ? values[i] : 0.0;
         }
     }
     return t;
@@ -161,13 +156,13 @@ Maka nya gw terinspirasi dari pytorch, tensorflow, atau gak numpy!
 // 1D Tensor dari list inisialisasi //
 inline Tensor tensor(std::initializer_list<double> data) {
     std::vector<double> vec(data);
-    return Tensor({static_cast<int>(vec.size())}, vec);
+    return Tensor({static_cast<index_t>(vec.size())}, vec);
 }
 
 // 2D Tensor dari list inisialisasi  //
 inline Tensor tensor(std::initializer_list<std::initializer_list<double>> data) {
-    int rows = static_cast<int>(data.size());
-    int cols = static_cast<int>(data.begin()->size());
+    index_t rows = static_cast<index_t>(data.size());
+    index_t cols = static_cast<index_t>(data.begin()->size());
     
     std::vector<double> flat_data;
     flat_data.reserve(rows * cols);
@@ -183,9 +178,9 @@ inline Tensor tensor(std::initializer_list<std::initializer_list<double>> data)
 
 // 3D Tensor dari ketiga nested list inisialisasi  //
 inline Tensor tensor(std::initializer_list<std::initializer_list<std::initializer_list<double>>> data) {
-    int dim0 = static_cast<int>(data.size());
-    int dim1 = static_cast<int>(data.begin()->size());
-    int dim2 = static_cast<int>(data.begin()->begin()->size());
+    index_t dim0 = static_cast<index_t>(data.size());
+    index_t dim1 = static_cast<index_t>(data.begin()->size());
+    index_t dim2 = static_cast<index_t>(data.begin()->begin()->size());
     
     std::vector<double> flat_data;
     flat_data.reserve(dim0 * dim1 * dim2);
@@ -203,19 +198,19 @@ inline Tensor tensor(std::initializer_list<std::initializer_list<std::initialize
 
 // Tensor dari vector (1D) //
 inline Tensor tensor(const std::vector<double>& data) {
-    return Tensor({static_cast<int>(data.size())}, data);
+    return Tensor({static_cast<index_t>(data.size())}, data);
 }
 
 // Helper untuk column vector (2D tensor dengan 1 kolom) //
 inline Tensor column_vector(std::initializer_list<double> data) {
     std::vector<double> vec(data);
-    return Tensor({static_cast<int>(vec.size()), 1}, vec);
+    return Tensor({static_cast<index_t>(vec.size()), 1}, vec);
 }
 
 // Atau kalo mau lebih explicit //
 inline Tensor tensor_2d_col(std::initializer_list<double> data) {
     std::vector<double> vec(data);
-    return Tensor({static_cast<int>(vec.size()), 1}, vec);
+    return Tensor({static_cast<index_t>(vec.size()), 1}, vec);
 }
 
 // Tensor dari shape + data //
@@ -229,7 +224,7 @@ maka output nya disimpan jadi seperti ini:
 shape = {2, 2}
 data  = {1, 2, 3, 4}
 */
-inline Tensor tensor(const std::vector<int>& shape, const std::vector<double>& data) {
+inline Tensor tensor(const Shape& shape, const std::vector<double>& data) {
     return Tensor(shape, data);
 }
 
@@ -244,10 +239,10 @@ Akibat nya model tidak dapat belajar secara efektif dan akurasi yang bagus.
 */
 
 // Xavier/Glorot Initialization //
-inline Tensor xavier_uniform(const std::vector<int>& shape) {
+inline Tensor xavier_uniform(const Shape& shape) {
     // Asumsi shape = {fan_out, fan_in} untuk fully connected //
-    int fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
-    int fan_out = shape[0];
+    index_t fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
+    index_t fan_out = shape[0];
     
     // Ini adalah rumus perhitungan xavier uniform //
     // arti nya makin besar, rentang bobot semakin kecil //
@@ -256,24 +251,24 @@ inline Tensor xavier_uniform(const std::vector<int>& shape) {
     return uniform(shape, -limit, limit);
 }
 
-inline Tensor xavier_normal(const std::vector<int>& shape) {
-    int fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
-    int fan_out = shape[0];
+inline Tensor xavier_normal(const Shape& shape) {
+    index_t fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
+    index_t fan_out = shape[0];
     
     double std = std::sqrt(2.0 / (fan_in + fan_out));
     return normal(shape, 0.0, std);
 }
 
 // Kaiming/He Initialization //
-inline Tensor kaiming_uniform(const std::vector<int>& shape) {
-    int fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
+inline Tensor kaiming_uniform(const Shape& shape) {
+    index_t fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
     
     double limit = std::sqrt(6.0 / fan_in);
     return uniform(shape, -limit, limit);
 }
 
-inline Tensor kaiming_normal(const std::vector<int>& shape) {
-    int fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
+inline Tensor kaiming_normal(const Shape& shape) {
+    index_t fan_in = (shape.size() >= 2) ? shape[1] : shape[0];
     
     double std = std::sqrt(2.0 / fan_in);
     return normal(shape, 0.0, std);
@@ -283,7 +278,7 @@ inline Tensor kaiming_normal(const std::vector<int>& shape) {
 
 // Clone tensor (deep copy) //
 inline Tensor clone(const Tensor& t) {
-    return Tensor(t.get_shape(), t.get_data());
+    return Tensor(t);
 }
 
 // Zeros like (sama shape, isi 0) //
@@ -324,7 +319,7 @@ inline std::ostream& operator<<(std::ostream& os, const Tensor& t) {
     if (shape.size() == 1) {
         // 1D Tensor //
         os << "[";
-        for (int i = 0; i < t.numel(); ++i) {
+        for (dl::index_t i = 0; i < t.numel(); ++i) {
             os << std::fixed << std::setprecision(4) << data[i];
             if (i < t.numel() - 1) os << ", ";
         }
@@ -333,10 +328,10 @@ inline std::ostream& operator<<(std::ostream& os, const Tensor& t) {
     else if (shape.size() == 2) {
         // 2D Tensor (Matrix) //
         os << "\n[";
-        for (int i = 0; i < shape[0]; ++i) {
+        for (dl::index_t i = 0; i < shape[0]; ++i) {
             os << "[";
-            for (int j = 0; j < shape[1]; ++j) {
-                os << std::fixed << std::setprecision(4) << t.at({i, j});
+            for (dl::index_t j = 0; j < shape[1]; ++j) {
+                os << std::fixed << std::setprecision(4) << t.at(i, j);
                 if (j < shape[1] - 1) os << ", ";
             }
             os << "]";
@@ -347,8 +342,8 @@ inline std::ostream& operator<<(std::ostream& os, const Tensor& t) {
     else {
         // dimensi tertinggi, hanya menampilkan data sebanyak 10 elemen//
         os << "[";
-        int show_count = std::min(10, t.numel());
-        for (int i = 0; i < show_count; ++i) {
+        dl::index_t show_count = std::min<dl::index_t>(10, t.numel());
+        for (dl::index_t i = 0; i < show_count; ++i) {
             os << std::fixed << std::setprecision(4) << data[i];
             if (i < show_count - 1) os << ", ";
         }
@@ -0,0 +1,105 @@
+#ifndef TENSOR_ITERATOR_H
+#define TENSOR_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/*
+Iterator dan span buat Tensor.
+Daripada akses elemen pakai at({i, j}) yang bikin std::vector baru setiap panggilan,
+hot loop bisa ambil pointer baris atau span nya sekali, lalu jalan pakai pointer biasa.
+
+Span = pointer + panjang, buat data yang bersebelahan (contiguous), misal satu baris matriks.
+StridedRange = pointer + panjang + stride, buat data yang loncat-loncat, misal satu kolom matriks.
+Dua-dua nya punya begin()/end() jadi bisa di pakai di range-for dan algoritma STL.
+*/
+
+namespace dl {
+
+// Span buat data contiguous //
+template <typename T>
+class Span {
+private:
+    T* ptr;
+    std::ptrdiff_t panjang;
+
+public:
+    using value_type = std::remove_const_t<T>;
+    using iterator = T*;
+
+    Span(T* ptr_, std::ptrdiff_t panjang_) : ptr(ptr_), panjang(panjang_) {}
+
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + panjang; }
+    T* data() const { return ptr; }
+    std::ptrdiff_t size() const { return panjang; }
+    T& operator[](std::ptrdiff_t i) const { return ptr[i]; }
+};
+
+// Iterator random access dengan stride //
+template <typename T>
+class StridedIterator {
+private:
+    T* ptr;
+    std::ptrdiff_t stride;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    StridedIterator() : ptr(nullptr), stride(1) {}
+    StridedIterator(T* ptr_, std::ptrdiff_t stride_) : ptr(ptr_), stride(stride_) {}
+
+    T& operator*() const { return *ptr; }
+    T* operator->() const { return ptr; }
+    T& operator[](difference_type n) const { return ptr[n * stride]; }
+
+    StridedIterator& operator++() { ptr += stride; return *this; }
+    StridedIterator operator++(int) { StridedIterator tmp = *this; ptr += stride; return tmp; }
+    StridedIterator& operator--() { ptr -= stride; return *this; }
+    StridedIterator operator--(int) { StridedIterator tmp = *this; ptr -= stride; return tmp; }
+    StridedIterator& operator+=(difference_type n) { ptr += n * stride; return *this; }
+    StridedIterator& operator-=(difference_type n) { ptr -= n * stride; return *this; }
+
+    friend StridedIterator operator+(StridedIterator it, difference_type n) { return it += n; }
+    friend StridedIterator operator+(difference_type n, StridedIterator it) { return it += n; }
+    friend StridedIterator operator-(StridedIterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const StridedIterator& a, const StridedIterator& b) {
+        return (a.ptr - b.ptr) / a.stride;
+    }
+
+    friend bool operator==(const StridedIterator& a, const StridedIterator& b) { return a.ptr == b.ptr; }
+    friend bool operator!=(const StridedIterator& a, const StridedIterator& b) { return a.ptr != b.ptr; }
+    friend bool operator<(const StridedIterator& a, const StridedIterator& b) { return (b - a) > 0; }
+    friend bool operator>(const StridedIterator& a, const StridedIterator& b) { return b < a; }
+    friend bool operator<=(const StridedIterator& a, const StridedIterator& b) { return !(b < a); }
+    friend bool operator>=(const StridedIterator& a, const StridedIterator& b) { return !(a < b); }
+};
+
+// Range dengan stride, misal satu kolom matriks //
+template <typename T>
+class StridedRange {
+private:
+    T* ptr;
+    std::ptrdiff_t panjang;
+    std::ptrdiff_t stride;
+
+public:
+    using iterator = StridedIterator<T>;
+
+    StridedRange(T* ptr_, std::ptrdiff_t panjang_, std::ptrdiff_t stride_)
+        : ptr(ptr_), panjang(panjang_), stride(stride_) {}
+
+    iterator begin() const { return iterator(ptr, stride); }
+    iterator end() const { return iterator(ptr + panjang * stride, stride); }
+    std::ptrdiff_t size() const { return panjang; }
+    T& operator[](std::ptrdiff_t i) const { return ptr[i * stride]; }
+};
+
+} // namespace dl //
+
+#endif
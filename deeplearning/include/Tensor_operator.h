@@ -2,6 +2,7 @@
 #define TENSOR_OPERATOR_H
 
 #include "Tensor.h"
+#include "FastMath.h"
 #include <cmath>
 
 /*
@@ -35,7 +36,7 @@ inline Tensor operator/(Tensor lhs, const Tensor& rhs) {
 // scalar + Tensor //
 inline Tensor operator+(double s, const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
+    for (dl::index_t i = 0; i < t.numel(); ++i)
         out[i] = s + t[i];
     return out;
 }
@@ -48,7 +49,7 @@ inline Tensor operator+(Tensor t, double s) {
 // scalar - Tensor //
 inline Tensor operator-(double s, const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
+    for (dl::index_t i = 0; i < t.numel(); ++i)
         out[i] = s - t[i];
     return out;
 }
@@ -61,7 +62,7 @@ inline Tensor operator-(Tensor t, double s) {
 // scalar * Tensor //
 inline Tensor operator*(double s, const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
+    for (dl::index_t i = 0; i < t.numel(); ++i)
         out[i] = s * t[i];
     return out;
 }
@@ -74,7 +75,7 @@ inline Tensor operator*(Tensor t, double s) {
 // scalar / Tensor //
 inline Tensor operator/(double s, const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
+    for (dl::index_t i = 0; i < t.numel(); ++i)
         out[i] = s / t[i];
     return out;
 }
@@ -85,27 +86,25 @@ inline Tensor operator/(Tensor t, double s) {
 }
 
 // Fungsi matematika //
-// exp function untuk Tensor //
+// exp function untuk Tensor, ikut mode dl::fastmath (presisi / cepat) //
 inline Tensor exp(const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
-        out[i] = std::exp(t[i]);
+    dl::fastmath::exp(t.data_ptr(), out.data_ptr(), t.numel());
     return out;
 }
 
 // sqrt function untuk Tensor (element-wise) //
 inline Tensor sqrt(const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
+    for (dl::index_t i = 0; i < t.numel(); ++i)
         out[i] = std::sqrt(t[i]);
     return out;
 }
 
-// log function untuk Tensor (element-wise) //
+// log function untuk Tensor (element-wise), ikut mode dl::fastmath //
 inline Tensor log(const Tensor& t) {
     Tensor out(t.get_shape());
-    for (int i = 0; i < t.numel(); ++i)
-        out[i] = std::log(t[i]);
+    dl::fastmath::log(t.data_ptr(), out.data_ptr(), t.numel());
     return out;
 }
 
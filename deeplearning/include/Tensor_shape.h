@@ -0,0 +1,118 @@
+#ifndef TENSOR_SHAPE_H
+#define TENSOR_SHAPE_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+Shape buat bentuk dan strides Tensor.
+Dulu bentuk dan strides itu std::vector<int>, jadi setiap Tensor baru
+alokasi heap 3 kali (data, bentuk, strides), padahal bentuk nya cuma 1-3 angka.
+Setiap Tensor sementara dari operator di Tensor_operator.h juga kena biaya ini.
+
+Sekarang Shape nyimpen angka nya langsung di dalam objek (inline), maksimal MAKS_RANK dimensi
+(lebih dari itu lempar std::length_error).
+Jadi Tensor cuma alokasi sekali buat data nya saja,
+dan perbandingan bentuk == rhs.bentuk cukup bandingin beberapa int tanpa lompat ke heap.
+
+Shape bisa di buat dari initializer list {2, 3} atau std::vector<int>,
+jadi kode lama kek dl::zeros({2, 3}) tetap jalan.
+
+Ukuran dimensi, strides, dan indeks pakai dl::index_t (64-bit),
+karna Tensor yang elemen nya lebih dari 2^31 bakal overflow kalau masih pakai int.
+*/
+
+namespace dl {
+// Tipe buat ukuran, strides, dan indeks Tensor //
+using index_t = std::int64_t;
+} // namespace dl //
+
+class Shape {
+public:
+    static constexpr int MAKS_RANK = 8;
+
+private:
+    std::array<dl::index_t, MAKS_RANK> dims;
+    int n;
+
+    /*
+    Dulu bentuk nya std::vector, rank berapa pun di terima.
+    Sekarang dims nya array tetap, jadi rank yang kelebihan harus di tolak pas runtime
+    (assert hilang di -DNDEBUG, dan nulis lewat array nya itu korupsi memori).
+    */
+    static int cek_rank(size_t rank) {
+        if (rank > static_cast<size_t>(MAKS_RANK)) {
+            throw std::length_error("Shape: rank " + std::to_string(rank) +
+                                    " melebihi MAKS_RANK " + std::to_string(MAKS_RANK));
+        }
+        return static_cast<int>(rank);
+    }
+
+public:
+    Shape() : dims{}, n(0) {}
+
+    Shape(std::initializer_list<dl::index_t> list) : dims{}, n(cek_rank(list.size())) {
+        int i = 0;
+        for (dl::index_t d : list) dims[i++] = d;
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+    Shape(const std::vector<T>& v) : dims{}, n(cek_rank(v.size())) {
+        for (int i = 0; i < n; ++i) dims[i] = static_cast<dl::index_t>(v[i]);
+    }
+
+    // Shape dengan n dimensi, semua nya berisi nilai //
+    static Shape dengan_rank(int rank, dl::index_t nilai = 0) {
+        assert(rank >= 0 && "Rank negatif");
+        Shape s;
+        s.n = cek_rank(static_cast<size_t>(rank));
+        for (int i = 0; i < rank; ++i) s.dims[i] = nilai;
+        return s;
+    }
+
+    size_t size() const { return static_cast<size_t>(n); }
+    bool empty() const { return n == 0; }
+
+    dl::index_t& operator[](size_t i) { return dims[i]; }
+    const dl::index_t& operator[](size_t i) const { return dims[i]; }
+
+    dl::index_t& back() { return dims[n - 1]; }
+    const dl::index_t& back() const { return dims[n - 1]; }
+
+    void push_back(dl::index_t d) {
+        cek_rank(static_cast<size_t>(n) + 1);
+        dims[n++] = d;
+    }
+
+    dl::index_t* begin() { return dims.data(); }
+    dl::index_t* end() { return dims.data() + n; }
+    const dl::index_t* begin() const { return dims.data(); }
+    const dl::index_t* end() const { return dims.data() + n; }
+    const dl::index_t* data() const { return dims.data(); }
+
+    // Konversi ke std::vector kalau butuh //
+    std::vector<dl::index_t> to_vector() const {
+        return std::vector<dl::index_t>(begin(), end());
+    }
+
+    friend bool operator==(const Shape& a, const Shape& b) {
+        if (a.n != b.n) return false;
+        for (int i = 0; i < a.n; ++i) {
+            if (a.dims[i] != b.dims[i]) return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(const Shape& a, const Shape& b) {
+        return !(a == b);
+    }
+};
+
+#endif
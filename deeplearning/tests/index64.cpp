@@ -0,0 +1,99 @@
+/*
+Test indeks 64-bit: Tensor dengan lebih dari 2^31 elemen.
+Tensor segede itu (32 GB double) gak perlu di alokasi, yang di cek cuma hitungan
+bentuk, strides, dan offset nya pas runtime (semua nya jalan tanpa data).
+Ukuran nya di baca lewat volatile, jadi compiler gak bisa ngitung hasil nya duluan,
+dan yang di cek beneran aritmatika index_t yang di jalanin, bukan tipe deklarasi nya.
+Cek nya gak pakai assert, jadi tetap jalan walau di compile dengan -DNDEBUG.
+
+    g++ -std=c++17 -O2 -I../include index64.cpp -o index64 -lpthread && ./index64
+*/
+
+#include "Tensor.h"
+#include "SparseTensor.h"
+#include "Reduction.h"
+#include "Matmul.h"
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+
+using dl::index_t;
+
+static int gagal = 0;
+
+#define CEK(kondisi)                                                              \
+    do {                                                                          \
+        if (!(kondisi)) {                                                         \
+            std::cerr << "index64: gagal baris " << __LINE__ << ": " #kondisi     \
+                      << std::endl;                                               \
+            ++gagal;                                                              \
+        }                                                                         \
+    } while (0)
+
+int main() {
+    volatile index_t n_volatile = 65536;
+    const index_t N = n_volatile;
+    const index_t DUA_32 = index_t(1) << 32;
+    const Shape bentuk{N, N};
+    const Tensor kosong;   // Cuma buat manggil helper bentuk, gak ada alokasi //
+
+    // numel 2^32, lewat INT32_MAX //
+    const index_t n = kosong.numel(bentuk);
+    CEK(n == DUA_32);
+    CEK(n > INT32_MAX);
+
+    // Strides [N, 1], offset elemen terakhir 2^32 - 1 //
+    const Shape strides = kosong.perhitungan_strides(bentuk);
+    CEK(strides.size() == 2 && strides[0] == N && strides[1] == 1);
+    const index_t terakhir = kosong.flatten_index({N - 1, N - 1}, strides);
+    CEK(terakhir == n - 1);
+    CEK(terakhir > INT32_MAX);
+
+    // Rank 3, stride dimensi pertama sendiri sudah lewat 2^31 //
+    const Shape bentuk3{4, N, N};
+    const Shape strides3 = kosong.perhitungan_strides(bentuk3);
+    CEK(strides3[0] == DUA_32 && strides3[0] > INT32_MAX);
+    CEK(kosong.numel(bentuk3) == 4 * DUA_32);
+    CEK(kosong.flatten_index({3, N - 1, N - 1}, strides3) == 4 * DUA_32 - 1);
+
+    /*
+    Pandangan matmul [N, N] dan transpos nya (lewat stride, tanpa data).
+    Offset nya cuma di hitung, gak pernah di baca, jadi data nullptr aman.
+    */
+    const dl::gemm::Pandangan biasa{nullptr, N, N, N, 1};
+    const dl::gemm::Pandangan transpos{nullptr, N, N, 1, N};
+    CEK(biasa.offset(N - 1, N - 1) == n - 1);
+    CEK(biasa.offset(N - 1, 0) == n - N);
+    CEK(transpos.offset(0, N - 1) == n - N);
+    CEK(transpos.offset(N - 1, N - 1) == n - 1);
+    // Elemen (i, k) pandangan transpos = elemen (k, i) pandangan biasa //
+    CEK(transpos.offset(12345, N - 3) == biasa.offset(N - 3, 12345));
+    CEK(transpos.offset(12345, N - 3) > INT32_MAX);
+
+    // Bentuk hasil reduksi dari Tensor besar //
+    const Shape hasil = dl::reduksi::bentuk_hasil(bentuk3, {0}, false);
+    CEK(hasil.size() == 2 && kosong.numel(hasil) == n);
+    const Shape hasil_keep = dl::reduksi::bentuk_hasil(bentuk3, {2}, true);
+    CEK(hasil_keep.size() == 3 && hasil_keep[0] == 4 && hasil_keep[1] == N && hasil_keep[2] == 1);
+
+    // Sparse: kolom di atas 2^32, data nya cuma satu elemen //
+    const index_t kolom_besar = index_t(1) << 33;
+    const index_t kolom = DUA_32 + 7;
+    SparseTensor s = dl::one_hot_sparse({kolom}, kolom_besar);
+    CEK(s.get_shape()[1] == kolom_besar);
+    CEK(s.get_indeks_kolom()[0] == kolom);
+
+    // Loader libsvm: indeks 64-bit gak di potong //
+    std::istringstream in("1 4294967304:2.5\n");
+    dl::DatasetSparse d = dl::baca_libsvm(in, kolom_besar);
+    CEK(d.X.get_indeks_kolom()[0] == kolom);
+    CEK(d.X.get_nilai()[0] == 2.5);
+
+    if (gagal) {
+        std::cerr << "index64: " << gagal << " cek gagal" << std::endl;
+        return 1;
+    }
+    std::cout << "index64: semua cek lulus" << std::endl;
+    return 0;
+}